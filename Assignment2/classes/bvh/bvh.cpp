@@ -0,0 +1,168 @@
+/**
+ * @file bvh.cpp
+ * @brief BVH class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "bvh.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/frustum/frustum.h"
+
+namespace bgq_opengl {
+
+    void BVH::build(const std::vector<BoundingBox> &boxes) {
+
+        this->nodes.clear();
+        this->boxes = boxes;
+        this->items.resize(boxes.size());
+
+        for (size_t i = 0; i < boxes.size(); i++)
+            this->items[i] = (int) i;
+
+        if (!boxes.empty())
+            this->buildNode(0, (int) boxes.size(), boxes);
+
+    }
+
+    int BVH::buildNode(int first, int count, const std::vector<BoundingBox> &boxes) {
+
+        // Get the box of the range.
+        BoundingBox bounds = boxes[this->items[first]];
+        for (int i = 1; i < count; i++)
+            bounds.merge(boxes[this->items[first + i]]);
+
+        int index = (int) this->nodes.size();
+        this->nodes.push_back(BVHNode{bounds, -1, -1, first, count});
+
+        // Small enough to be a leaf.
+        if (count <= BVH_LEAF_SIZE)
+            return index;
+
+        // Split on the median of the centres along the longest axis.
+        glm::vec3 extent = bounds.max - bounds.min;
+        int axis = 0;
+        if (extent.y > extent[axis])
+            axis = 1;
+        if (extent.z > extent[axis])
+            axis = 2;
+
+        int half = count / 2;
+        std::nth_element(this->items.begin() + first, this->items.begin() + first + half, this->items.begin() + first + count,
+            [&boxes, axis](int a, int b) {
+                return boxes[a].min[axis] + boxes[a].max[axis] < boxes[b].min[axis] + boxes[b].max[axis];
+            });
+
+        // The vector may grow, so do not hold references to the node.
+        int left = this->buildNode(first, half, boxes);
+        int right = this->buildNode(first + half, count - half, boxes);
+        this->nodes[index].left = left;
+        this->nodes[index].right = right;
+        this->nodes[index].count = 0;
+
+        return index;
+
+    }
+
+    void BVH::refit(const std::vector<BoundingBox> &boxes) {
+
+        this->boxes = boxes;
+
+        // Children always come after their parent, so walk backwards.
+        for (size_t i = this->nodes.size(); i-- > 0;) {
+
+            BVHNode &n = this->nodes[i];
+
+            if (n.left < 0) {
+
+                n.bounds = this->boxes[this->items[n.first]];
+                for (int j = 1; j < n.count; j++)
+                    n.bounds.merge(this->boxes[this->items[n.first + j]]);
+
+            } else {
+
+                n.bounds = this->nodes[n.left].bounds;
+                n.bounds.merge(this->nodes[n.right].bounds);
+
+            }
+
+        }
+
+    }
+
+    void BVH::query(const Frustum &frustum, std::vector<int> &visible) const {
+
+        visible.clear();
+
+        if (!this->nodes.empty())
+            this->queryNode(0, frustum, visible);
+
+    }
+
+    void BVH::queryNode(int node, const Frustum &frustum, std::vector<int> &visible) const {
+
+        Frustum::Result result = frustum.test(this->nodes[node].bounds);
+
+        // Nothing to see here.
+        if (result == Frustum::OUTSIDE)
+            return;
+
+        // Everything below is visible, no need to keep testing.
+        if (result == Frustum::INSIDE) {
+            this->collect(node, visible);
+            return;
+        }
+
+        const BVHNode &n = this->nodes[node];
+
+        if (n.left < 0) {
+
+            // Test the items of a crossing leaf one by one.
+            for (int i = 0; i < n.count; i++) {
+                int item = this->items[n.first + i];
+                if (frustum.intersects(this->boxes[item]))
+                    visible.push_back(item);
+            }
+
+            return;
+
+        }
+
+        this->queryNode(n.left, frustum, visible);
+        this->queryNode(n.right, frustum, visible);
+
+    }
+
+    void BVH::collect(int node, std::vector<int> &visible) const {
+
+        const BVHNode &n = this->nodes[node];
+
+        if (n.left < 0) {
+
+            for (int i = 0; i < n.count; i++)
+                visible.push_back(this->items[n.first + i]);
+
+            return;
+
+        }
+
+        this->collect(n.left, visible);
+        this->collect(n.right, visible);
+
+    }
+
+}  // namespace bgq_opengl
@@ -0,0 +1,133 @@
+/**
+ * @file bvh.h
+ * @brief BVH class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BVH_H_
+#define BGQ_OPENGL_CLASSES_BVH_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/frustum/frustum.h"
+
+#define BVH_LEAF_SIZE 2     // Maximum number of items in a leaf.
+
+namespace bgq_opengl {
+
+    /**
+     * @brief Implementation of a bounding volume hierarchy.
+     *
+     * A binary tree of world space boxes built by splitting on the median of the
+     * longest axis. It is built once over the rigs of the scene, refitted when they
+     * move, which keeps the tree but updates its boxes, and queried with the camera
+     * frustum so whole groups of rigs are rejected with a single test.
+     *
+     * @author Borja García Quiroga <garcaqub@tcd.ie>
+     */
+    class BVH {
+
+        public:
+
+            /**
+             * @brief Build the hierarchy.
+             *
+             * Build the hierarchy over a set of boxes. Items are identified by their
+             * position in the vector.
+             *
+             * @param boxes The boxes of the items.
+             */
+            void build(const std::vector<BoundingBox> &boxes);
+
+            /**
+             * @brief Refit the hierarchy.
+             *
+             * Update the boxes of the items and of every node containing them, keeping
+             * the tree as it was built. The items must be the same ones.
+             *
+             * @param boxes The new boxes of the items.
+             */
+            void refit(const std::vector<BoundingBox> &boxes);
+
+            /**
+             * @brief Get the visible items.
+             *
+             * Get the items whose box is at least partially inside the frustum.
+             *
+             * @param frustum The frustum.
+             * @param visible The vector where the visible items will be stored.
+             */
+            void query(const Frustum &frustum, std::vector<int> &visible) const;
+
+        private:
+
+            /**
+             * @brief A node of the hierarchy.
+             *
+             * Inner nodes have two children, leaves a range of items.
+             */
+            struct BVHNode {
+
+                BoundingBox bounds;     /// Box containing the whole subtree.
+                int left;               /// Left child, -1 in leaves.
+                int right;              /// Right child, -1 in leaves.
+                int first;              /// First item of a leaf.
+                int count;              /// Number of items of a leaf.
+
+            };
+
+            /**
+             * @brief Build a subtree.
+             *
+             * Build the subtree of a range of items.
+             *
+             * @param first The first item.
+             * @param count The number of items.
+             * @param boxes The boxes of the items.
+             *
+             * @returns The index of the node.
+             */
+            int buildNode(int first, int count, const std::vector<BoundingBox> &boxes);
+
+            /**
+             * @brief Test a subtree.
+             *
+             * Test a subtree against the frustum and store its visible items.
+             *
+             * @param node The node.
+             * @param frustum The frustum.
+             * @param visible The vector where the visible items will be stored.
+             */
+            void queryNode(int node, const Frustum &frustum, std::vector<int> &visible) const;
+
+            /**
+             * @brief Store a subtree.
+             *
+             * Store all the items of a subtree without testing them.
+             *
+             * @param node The node.
+             * @param visible The vector where the items will be stored.
+             */
+            void collect(int node, std::vector<int> &visible) const;
+
+            std::vector<BVHNode> nodes;     /// The nodes, the root being the first one.
+            std::vector<int> items;         /// The items, ordered by leaf.
+            std::vector<BoundingBox> boxes; /// The boxes of the items.
+
+    };
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_BVH_H_
@@ -45,57 +45,84 @@ namespace bgq_opengl {
 
 	glm::mat4 Camera::getCameraMatrix() {
 
-        return this->getProjection() * this->getView();
+        this->update();
+        return this->camera_matrix;
+
+	}
+
+	glm::mat4 Camera::getInverseCameraMatrix() {
+
+        this->update();
+        return this->inverse_camera_matrix;
 
 	}
 
 	glm::vec3 Camera::getDirection() {
 
-        return glm::normalize(glm::vec3(transforms * glm::vec4(this->direction, 1.0)));
+        this->update();
+        return this->current_direction;
 
 	}
 
 	glm::vec3 Camera::getPosition() {
 
-        return glm::vec3(transforms * glm::vec4(this->position, 1.0));
+        this->update();
+        return this->current_position;
 
 	}
 
 	glm::mat4 Camera::getProjection() {
         
-        // Adds perspective to the scene.
-        float ratio = (float)this->window_width / this->window_height;
-        return glm::perspective(glm::radians(this->fov), ratio, this->near, this->far);
+        this->update();
+        return this->projection;
+
+	}
+
+	glm::mat4 Camera::getInverseProjection() {
+        
+        this->update();
+        return this->inverse_projection;
 
 	}
 
 	glm::vec3 Camera::getUp() {
 
-		return glm::normalize(glm::vec3(transforms * glm::vec4(this->up, 1.0)));
+        this->update();
+        return this->current_up;
 
 	}
 
 	glm::mat4 Camera::getView() {
         
-        // Get the position and direction.
-        glm::vec3 position = this->getPosition();
-        glm::vec3 direction = this->getDirection();
-        glm::vec3 up = this->getUp();
+        this->update();
+        return this->view;
+
+	}
+
+	glm::mat4 Camera::getInverseView() {
         
-        // Calculate the view matrix.
-        return glm::lookAt(position, position + direction, up);
+        this->update();
+        return this->inverse_view;
 
 	}
 
     void Camera::setWidth(int new_width) {
         
+        if (this->window_width == new_width)
+            return;
+        
         this->window_width = new_width;
+        this->projection_dirty = true;
         
     }
 
     void Camera::setHeight(int new_height) {
         
+        if (this->window_height == new_height)
+            return;
+        
         this->window_height = new_height;
+        this->projection_dirty = true;
         
     }
 
@@ -211,6 +238,7 @@ namespace bgq_opengl {
                     
         // Apply it to the transforms.
         this->transforms = rotation * this->transforms;
+        this->view_dirty = true;
 
 	}
 
@@ -248,12 +276,14 @@ namespace bgq_opengl {
                     
         // Apply it to the transforms.
         this->transforms = rotation * this->transforms;
+        this->view_dirty = true;
 
 	}
 
     void Camera::resetTransforms() {
 
         this->transforms = glm::mat4(1.0f);
+        this->view_dirty = true;
 
     }
 
@@ -267,6 +297,7 @@ namespace bgq_opengl {
         glm::mat4 rotation_matrix = glm::rotate(identity_matrix, radians, glm::vec3(x, y, z));
 
         this->transforms = rotation_matrix * this->transforms;
+        this->view_dirty = true;
 
     }
 
@@ -277,6 +308,7 @@ namespace bgq_opengl {
 
         // Apply it to the transormations.
         this->transforms = trans_matrix * this->transforms;
+        this->view_dirty = true;
 
     }
 
@@ -289,6 +321,43 @@ namespace bgq_opengl {
     void Camera::setTransformMat(glm::mat4 transform) {
         
         this->transforms = transform;
+        this->view_dirty = true;
+        
+    }
+
+    void Camera::update() {
+        
+        if (!this->view_dirty && !this->projection_dirty)
+            return;
+        
+        if (this->view_dirty) {
+            
+            // Get the position and direction.
+            this->current_position = glm::vec3(this->transforms * glm::vec4(this->position, 1.0));
+            this->current_direction = glm::normalize(glm::vec3(this->transforms * glm::vec4(this->direction, 1.0)));
+            this->current_up = glm::normalize(glm::vec3(this->transforms * glm::vec4(this->up, 1.0)));
+            
+            // Calculate the view matrix.
+            this->view = glm::lookAt(this->current_position, this->current_position + this->current_direction, this->current_up);
+            this->inverse_view = glm::inverse(this->view);
+            
+        }
+        
+        if (this->projection_dirty) {
+            
+            // Adds perspective to the scene.
+            float ratio = (float)this->window_width / this->window_height;
+            this->projection = glm::perspective(glm::radians(this->fov), ratio, this->near, this->far);
+            this->inverse_projection = glm::inverse(this->projection);
+            
+        }
+        
+        // Either of them changes the product.
+        this->camera_matrix = this->projection * this->view;
+        this->inverse_camera_matrix = this->inverse_view * this->inverse_projection;
+        
+        this->view_dirty = false;
+        this->projection_dirty = false;
         
     }
 
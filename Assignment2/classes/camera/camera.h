@@ -54,6 +54,14 @@ namespace bgq_opengl {
 			 */
 			glm::mat4 getCameraMatrix();
 
+			/**
+			 * @brief Get the inverse camera matrix.
+			 *
+			 * Get the inverse of the camera matrix, which takes clip coordinates back to
+			 * the world.
+			 */
+			glm::mat4 getInverseCameraMatrix();
+
 			/**
 			 * @brief Get the camera direction.
 			 * 
@@ -75,6 +83,13 @@ namespace bgq_opengl {
 			 */
 			glm::mat4 getProjection();
 
+			/**
+			 * @brief Get the inverse projection matrix.
+			 *
+			 * Get the inverse of the projection matrix.
+			 */
+			glm::mat4 getInverseProjection();
+
 			/**
 			 * @brief Get the camera up vector.
 			 *
@@ -88,6 +103,13 @@ namespace bgq_opengl {
 			 * Get the view matrix corresponding to this camera.
 			 */
 			glm::mat4 getView();
+
+			/**
+			 * @brief Get the inverse view matrix.
+			 *
+			 * Get the inverse of the view matrix.
+			 */
+			glm::mat4 getInverseView();
         
             /**
              * @brief Set the width of the camera.
@@ -255,6 +277,14 @@ namespace bgq_opengl {
 
 		private:
 
+			/**
+			 * @brief Recompute the cached matrices.
+			 *
+			 * Recompute the cached vectors and matrices whose inputs changed since the
+			 * last call.
+			 */
+			void update();
+
 			glm::vec3 direction;		/// Vector indicating where the camera is looking.
 			float far;					/// Maximum clipping limit.
 			float fov;					/// Field of view;
@@ -265,6 +295,17 @@ namespace bgq_opengl {
 			int window_width;			/// Width of the GLUT window.
             glm::mat4 transforms = glm::mat4(1.0f); /// Tranform matrixes that will be passed to the shader.
 
+            bool view_dirty = true;                 /// Whether the view changed since it was cached.
+            bool projection_dirty = true;           /// Whether the projection changed since it was cached.
+            glm::vec3 current_position;             /// Cached position after the transforms.
+            glm::vec3 current_direction;            /// Cached direction after the transforms.
+            glm::vec3 current_up;                   /// Cached up vector after the transforms.
+            glm::mat4 view;                         /// Cached view matrix.
+            glm::mat4 projection;                   /// Cached projection matrix.
+            glm::mat4 camera_matrix;                /// Cached projection times view.
+            glm::mat4 inverse_view;                 /// Cached inverse of the view.
+            glm::mat4 inverse_projection;           /// Cached inverse of the projection.
+            glm::mat4 inverse_camera_matrix;        /// Cached inverse of the camera matrix.
 			const float speed = 0.25f;				/// Speed of the camera movement.
 			const float horizontal_rotation = 3.0f;	/// How much it rotates for every step.
 			const float vertical_rotation = 0.1f;	/// How much it rotates for every step.
@@ -0,0 +1,140 @@
+/**
+ * @file clip_sampler.cpp
+ * @brief Clip sampler class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "clip_sampler.h"
+
+#include <cmath>
+#include <vector>
+
+#include "structs/animation_clip/animation_clip.h"
+#include "structs/joint_pose/joint_pose.h"
+
+namespace bgq_opengl {
+
+	ClipSampler::ClipSampler() {}
+
+	ClipSampler::ClipSampler(const AnimationClip *clip) {
+
+		this->setClip(clip);
+
+	}
+
+	void ClipSampler::setClip(const AnimationClip *clip) {
+
+		this->clip = clip;
+
+		// Size everything once, sampling reuses it.
+		size_t tracks = clip ? clip->getNumTracks() : 0;
+		this->cursors.resize(tracks);
+		this->weights.resize(tracks);
+		this->from.resize(tracks);
+		this->to.resize(tracks);
+		this->blended.resize(tracks);
+
+		this->rewind();
+
+	}
+
+	const AnimationClip *ClipSampler::getClip() const {
+
+		return this->clip;
+
+	}
+
+	void ClipSampler::rewind() {
+
+		for (size_t i = 0; i < this->cursors.size(); i++)
+			this->cursors[i] = this->clip->starts[i];
+
+		this->last_time = 0.0f;
+
+	}
+
+	void ClipSampler::sample(float time, JointPose &pose) {
+
+		if (!this->clip || this->cursors.empty())
+			return;
+
+		const AnimationClip &c = *this->clip;
+
+		// Bring the time into the clip.
+		if (c.duration <= 0.0f) {
+			time = 0.0f;
+		} else if (c.loop) {
+			time = std::fmod(time, c.duration);
+			if (time < 0.0f)
+				time += c.duration;
+		} else {
+			time = time < 0.0f ? 0.0f : (time > c.duration ? c.duration : time);
+		}
+
+		// Going back, like when a loop wraps, starts the cursors over.
+		if (time < this->last_time)
+			this->rewind();
+		this->last_time = time;
+
+		// Move each cursor forward and gather the keys around the time.
+		for (size_t i = 0; i < this->cursors.size(); i++) {
+
+			// Every track has a key, addTrack skips the empty ones.
+			unsigned int last = c.starts[i + 1] - 1;
+			unsigned int k = this->cursors[i];
+			while (k < last && c.times[k + 1] <= time)
+				k++;
+			this->cursors[i] = k;
+
+			unsigned int next = k < last ? k + 1 : k;
+			float span = c.times[next] - c.times[k];
+			float weight = span > 0.0f ? (time - c.times[k]) / span : 0.0f;
+			this->weights[i] = weight < 0.0f ? 0.0f : (weight > 1.0f ? 1.0f : weight);
+
+			this->from.rx[i] = c.rx[k];
+			this->from.ry[i] = c.ry[k];
+			this->from.rz[i] = c.rz[k];
+			this->from.rw[i] = c.rw[k];
+			this->from.tx[i] = c.tx[k];
+			this->from.ty[i] = c.ty[k];
+			this->from.tz[i] = c.tz[k];
+
+			this->to.rx[i] = c.rx[next];
+			this->to.ry[i] = c.ry[next];
+			this->to.rz[i] = c.rz[next];
+			this->to.rw[i] = c.rw[next];
+			this->to.tx[i] = c.tx[next];
+			this->to.ty[i] = c.ty[next];
+			this->to.tz[i] = c.tz[next];
+
+		}
+
+		// Blend all the tracks at once.
+		JointPose::blend(this->from, this->to, this->weights.data(), this->blended);
+
+		// Hand each track to its joint.
+		for (size_t i = 0; i < this->cursors.size(); i++) {
+
+			unsigned int joint = c.joints[i];
+			pose.rx[joint] = this->blended.rx[i];
+			pose.ry[joint] = this->blended.ry[i];
+			pose.rz[joint] = this->blended.rz[i];
+			pose.rw[joint] = this->blended.rw[i];
+			pose.tx[joint] = this->blended.tx[i];
+			pose.ty[joint] = this->blended.ty[i];
+			pose.tz[joint] = this->blended.tz[i];
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,104 @@
+/**
+ * @file clip_sampler.h
+ * @brief Clip sampler class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_CLIP_SAMPLER_H_
+#define BGQ_OPENGL_CLASSES_CLIP_SAMPLER_H_
+
+#include <vector>
+
+#include "structs/animation_clip/animation_clip.h"
+#include "structs/joint_pose/joint_pose.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a sampler of animation clips.
+	 *
+	 * Implements the playback of a clip. Each track keeps a cursor on the key
+	 * it was last sampled at, so playing forward only looks at the next keys
+	 * instead of searching the whole track. The two keys around the time are
+	 * gathered for every track and then blended in a single pass over all of
+	 * them. Nothing is allocated once the clip is set.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ClipSampler {
+
+		public:
+
+			/**
+			 * @brief Build a sampler without a clip.
+			 *
+			 * Build a sampler without a clip, which leaves poses untouched.
+			 */
+			ClipSampler();
+
+			/**
+			 * @brief Build a sampler for a clip.
+			 *
+			 * @param clip The clip, which has to outlive the sampler.
+			 */
+			ClipSampler(const AnimationClip *clip);
+
+			/**
+			 * @brief Set the clip.
+			 *
+			 * Set the clip to play and rewind it.
+			 *
+			 * @param clip The clip, which has to outlive the sampler, or 0.
+			 */
+			void setClip(const AnimationClip *clip);
+
+			/**
+			 * @brief Get the clip.
+			 *
+			 * @returns The clip, or 0.
+			 */
+			const AnimationClip *getClip() const;
+
+			/**
+			 * @brief Rewind the clip.
+			 *
+			 * Move every cursor back to the first key of its track.
+			 */
+			void rewind();
+
+			/**
+			 * @brief Sample the clip.
+			 *
+			 * Write the transforms of the joints the clip has tracks for at a time,
+			 * wrapped around the clip if it loops and clamped to it if not. Joints
+			 * without a track keep what the pose held.
+			 *
+			 * @param time The time in seconds.
+			 * @param pose The pose, with at least the joints of the clip.
+			 */
+			void sample(float time, JointPose &pose);
+
+		private:
+
+			const AnimationClip *clip = 0;		/// The clip being played.
+			float last_time = 0.0f;				/// The time it was last sampled at, wrapped.
+			std::vector<unsigned int> cursors;	/// The key before the last time of each track.
+			std::vector<float> weights;			/// The blend weight of each track.
+			JointPose from;						/// The key before the time of each track.
+			JointPose to;						/// The key after the time of each track.
+			JointPose blended;					/// The blended transform of each track.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_CLIP_SAMPLER_H_
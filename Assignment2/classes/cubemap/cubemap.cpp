@@ -16,6 +16,7 @@
 #include "cubemap.h"
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 #include <cassert>
@@ -23,6 +24,12 @@
 #include "GL/glew.h"
 #include "stb/stb_image.h"
 
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
+#include "classes/texture/texture.h"
+#include "structs/texture_file/texture_file.h"
+
 namespace bgq_opengl {
 
     Cubemap::Cubemap(GLuint id, std::string name, GLuint slot) {
@@ -39,17 +46,49 @@ namespace bgq_opengl {
         if (slot < 1) assert(false);
 
         // Generate a texture in OpenGL and store the parameters in the attributes.
-        glGenTextures(1, &this->ID);
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->ID);
+        this->texture = std::make_shared<GLHandle>(GLHandle::TEXTURE);
+        this->ID = this->texture->get();
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, slot, this->ID);
         
         this->name = std::string(name);
         this->slot = slot;
         
         int width, height, channels;
+        bool generate_mipmap = false;
+        size_t bytes = 0;
+        
+        // A single compressed file can hold the six faces.
+        TextureFile file;
+        if (textures_faces.size() == 1 && TextureFile::isTextureFile(textures_faces[0])) {
+            
+            if (!TextureFile::read(textures_faces[0], file) || file.faces != 6 || !Texture::isFormatSupported(file.internal_format)) {
+                std::cerr << "Cubemap error: cubemap " << textures_faces[0] << " could not be loaded." << std::endl;
+                exit(1);
+            }
+            
+            for (int i = 0; i < 6; i++)
+                Texture::uploadFile(file, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, i, file.data.data());
+            bytes = file.data.size();
+            
+        }
         
         // Loop through the images, load them and pass them to OpenGL.
-        for (unsigned int i = 0; i < textures_faces.size(); i++) {
+        for (unsigned int i = 0; i < textures_faces.size() && file.levels == 0; i++) {
+            
+            // Compressed faces bring their own mip chain.
+            if (TextureFile::isTextureFile(textures_faces[i])) {
+                
+                if (!TextureFile::read(textures_faces[i], file) || !Texture::isFormatSupported(file.internal_format)) {
+                    std::cerr << "Cubemap error: cubemap " << textures_faces[i] << " could not be loaded." << std::endl;
+                    exit(1);
+                }
+                
+                Texture::uploadFile(file, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, file.data.data());
+                bytes += file.data.size();
+                file = TextureFile();
+                continue;
+                
+            }
             
             unsigned char *data = stbi_load(textures_faces[i].c_str(), &width, &height, &channels, 0);
             if (data) {
@@ -67,8 +106,9 @@ namespace bgq_opengl {
                     assert(false);
                 
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, width, height, 0, color_model, GL_UNSIGNED_BYTE, data);
-                glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
                 stbi_image_free(data);
+                generate_mipmap = true;
+                bytes += GPUMemory::getTextureSize(width, height, 1, true);
                 
             } else {
                 
@@ -79,6 +119,10 @@ namespace bgq_opengl {
             }
             
         }
+        
+        // Build the mip chain once all the faces are there, not once per face.
+        if (generate_mipmap)
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -87,7 +131,8 @@ namespace bgq_opengl {
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
         
         // Unbinds the OpenGL Texture.
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, slot, 0);
+        this->texture->account(GPUMemory::TEXTURES, bytes);
         
     }
 
@@ -112,20 +157,21 @@ namespace bgq_opengl {
     void Cubemap::bind() {
         
         // Activate the texture and bind it.
-        glActiveTexture(GL_TEXTURE0 + this->slot);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->ID);
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, this->slot, this->ID);
         
     }
 
     void Cubemap::remove() {
         
-        glDeleteTextures(1, &this->ID);
+        // It is deleted once no copy holds it.
+        this->texture.reset();
+        this->ID = 0;
         
     }
 
     void Cubemap::unbind() {
         
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, this->slot, 0);
         
     }
 
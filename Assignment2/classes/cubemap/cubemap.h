@@ -18,17 +18,21 @@
 #ifndef BGQ_OPENGL_CLASSES_CUBEMAP_H_
 #define BGQ_OPENGL_CLASSES_CUBEMAP_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "GL/glew.h"
 
+#include "classes/gl_handle/gl_handle.h"
+
 namespace bgq_opengl {
 
     /**
      * @brief Implements a skybox class.
      *
      * Implements a skybox class to handle the background texture on OpenGL.
+     * Copies share the texture, which is deleted once none of them holds it.
      *
      * @author Borja García Quiroga <garcaqub@tcd.ie>
      */
@@ -39,7 +43,7 @@ namespace bgq_opengl {
             /**
              * @brief Copies a cubemap from another.
              *
-             * Copies a cubemap from another.
+             * Copies a cubemap from another. The texture is not owned by the copy.
              *
              * @param id The cubemap to be copied.
              * @param name The name of this texture.
@@ -52,7 +56,7 @@ namespace bgq_opengl {
              *
              * Constructs a skybox instance.
              *
-             * @param textures_faces A vector containing the skybox faces in the right, left, top, bottom, back, and front order.
+             * @param textures_faces A vector containing the skybox faces in the right, left, top, bottom, back, and front order, or a single KTX or DDS cubemap.
              * @param type Texture type.
              * @param slot Texture slot.
              */
@@ -95,7 +99,8 @@ namespace bgq_opengl {
             /**
              * @brief Removes the texture from OpenGL.
              *
-             *  Removes the texture from OpenGL.
+             * Lets go of the texture, which is removed from OpenGL once no other copy
+             * holds it.
              */
             void remove();
 
@@ -109,6 +114,7 @@ namespace bgq_opengl {
         private:
 
             GLuint ID;                      /// Texture OpenGL ID.
+            std::shared_ptr<GLHandle> texture;  /// The texture, if this cubemap created it.
             GLuint slot;                    /// Stores the texture slot number.
             std::string name;               /// Texture name.
 
@@ -19,37 +19,69 @@
 
 #include "GL/glew.h"
 
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
+
 namespace bgq_opengl {
 
 	// Constructor that generates a Elements Buffer Object and links it to indices
 	EBO::EBO(const std::vector<GLuint> &indices) {
 		
 		// Generate the buffer.
-		glGenBuffers(1, &this->ID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
+		this->buffer = GLHandle(GLHandle::BUFFER);
+		GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->buffer.get());
 
 		// Link the indices.
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+		this->buffer.account(GPUMemory::INDICES, (size_t) (indices.size() * sizeof(GLuint)));
+	
+	}
+
+	// Constructor that generates a Elements Buffer Object and links it to 16 bits indices
+	EBO::EBO(const std::vector<GLushort> &indices) {
+		
+		// Generate the buffer.
+		this->buffer = GLHandle(GLHandle::BUFFER);
+		GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->buffer.get());
+
+		// Link the indices.
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+		this->buffer.account(GPUMemory::INDICES, (size_t) (indices.size() * sizeof(GLushort)));
+	
+	}
+
+	// Constructor that generates a Elements Buffer Object from already packed indices
+	EBO::EBO(const void *data, GLsizeiptr size) {
+		
+		// Generate the buffer.
+		this->buffer = GLHandle(GLHandle::BUFFER);
+		GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->buffer.get());
+
+		// Link the indices.
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+		this->buffer.account(GPUMemory::INDICES, (size_t) size);
 	
 	}
 
 	void EBO::bind() {
 
 		// Binds the EBO.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
+		GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->buffer.get());
 	
 	}
 
 	void EBO::remove() {
 
-		glDeleteBuffers(1, &this->ID);
+		// Delete the buffer in OpenGL now instead of when it goes out of scope.
+		this->buffer.reset();
 
 	}
 
 	void EBO::unbind() {
 
 		// Unbinds the EBO.
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	
 	}	
 
@@ -20,13 +20,16 @@
 
 #include "GL/glew.h"
 
+#include "classes/gl_handle/gl_handle.h"
+
 namespace bgq_opengl {
 
 	/**
 	 * @brief Implementation of a EBO class.
 	 *
 	 * Implementation of a EBO class that will allow us to bind it to the
-	 * OpenGL pipe, destroy it or deactivate it.
+	 * OpenGL pipe, destroy it or deactivate it. It owns the buffer, which is
+	 * deleted when it goes out of scope, so it can be moved but not copied.
 	 *
 	 * @author Borja García Quiroga <garcaqub@tcd.ie>
 	 */
@@ -43,6 +46,26 @@ namespace bgq_opengl {
 			 */
 			EBO(const std::vector<GLuint> &indices);
 
+			/**
+			 * @brief Constructs a 16 bits Elements Buffer Object.
+			 *
+			 * Constructs a Elements Buffer Object with 16 bits indices and links them.
+			 *
+			 * @param indices Indices that will be linked.
+			 */
+			EBO(const std::vector<GLushort> &indices);
+
+			/**
+			 * @brief Constructs a Elements Buffer Object from packed indices.
+			 *
+			 * Constructs a Elements Buffer Object from indices already laid out as they
+			 * go to the GPU, of whichever type.
+			 *
+			 * @param data The packed indices.
+			 * @param size The size of the data in bytes.
+			 */
+			EBO(const void *data, GLsizeiptr size);
+
 			/**
 			 * @brief Binds the EBO.
 			 *
@@ -53,7 +76,7 @@ namespace bgq_opengl {
 			/**
 			 * @brief Removes the EBO.
 			 *
-			 * Removes the EBO from OpenGL.
+			 * Removes the EBO from OpenGL before it goes out of scope.
 			 */
 			void remove();
 
@@ -66,7 +89,7 @@ namespace bgq_opengl {
 
 		private:
 
-			GLuint ID; // GL ID of the EBO.
+			GLHandle buffer; // The GL buffer of the EBO.
 
 	};
 
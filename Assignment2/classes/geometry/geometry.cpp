@@ -15,6 +15,8 @@
 
 #include "geometry.h"
 
+#include <memory>
+#include <utility>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
@@ -26,38 +28,120 @@
 
 #include "classes/camera/camera.h"
 #include "classes/ebo/ebo.h"
+#include "classes/render_stats/render_stats.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
+#include "classes/texture_cache/texture_cache.h"
 #include "classes/vao/vao.h"
 #include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/normal_matrix/normal_matrix.h"
 
 namespace bgq_opengl {
 
-	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess) {
+	Geometry::Residency Geometry::residency = Geometry::KEEP_ALL;
 
-		// Store a copy of these in the attributes.
+	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess) : Geometry(vertices, indices, textures, shininess, VertexLayout::full()) {}
+
+	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout) : Geometry(vertices, indices, textures, shininess, layout, {}) {}
+
+	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout, const std::vector<std::vector<GLuint>> &lods) {
+
+		// Store a copy of these in the attributes, until they are uploaded.
 		this->vertices = vertices;
 		this->indices = indices;
         this->textures = textures;
         this->shininess = shininess;
+        this->layout = layout;
+
+		// The vertices do not change, so the box is computed only once.
+		if (!vertices.empty())
+			this->bounds = this->getBoundingBox();
+
+		// Put every level of detail one after the other in the same buffer.
+		std::vector<GLuint> all_indices = indices;
+		this->lod_offsets = {0};
+		this->lod_counts = {(GLsizei) indices.size()};
+		for (size_t i = 0; i < lods.size(); i++) {
+			this->lod_offsets.push_back((GLsizei) all_indices.size());
+			this->lod_counts.push_back((GLsizei) lods[i].size());
+			all_indices.insert(all_indices.end(), lods[i].begin(), lods[i].end());
+		}
+
+		// Pack the vertices in the chosen layout.
+		std::vector<unsigned char> packed = layout.pack(vertices);
 
 		// Generate a VAO and bind it, generate a VBO for the vertices and a EBO for the indices.
 		this->vao.bind();
-		VBO vbo(vertices);
-		EBO ebo(indices);
+		this->vbo = std::make_shared<VBO>(packed.data(), (GLsizeiptr) packed.size());
+
+		// Use 16 bits indices whenever every vertex can be addressed with them.
+		this->index_type = vertices.size() <= 0x10000 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		if (this->index_type == GL_UNSIGNED_SHORT)
+			this->ebo = std::make_unique<EBO>(std::vector<GLushort>(all_indices.begin(), all_indices.end()));
+		else
+			this->ebo = std::make_unique<EBO>(all_indices);
 
-		// Links VBO attributes such as coordinates and colors to VAO.
-		vao.link_attribute(vbo, 0, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)0);
-		vao.link_attribute(vbo, 1, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(3 * sizeof(float)));
-		vao.link_attribute(vbo, 2, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(6 * sizeof(float)));
-        vao.link_attribute(vbo, 3, 2, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(9 * sizeof(float)));
-        vao.link_attribute(vbo, 4, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(11 * sizeof(float)));
-        vao.link_attribute(vbo, 5, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(14 * sizeof(float)));
+		// Links the VBO attributes stored by this layout to the VAO.
+		this->linkLayout(*this->vbo);
 
 		vao.unbind();
-		vbo.unbind();
-		ebo.unbind();
+		this->vbo->unbind();
+		this->ebo->unbind();
+
+		// The GPU has them now, keep only what was asked for.
+		this->release(Geometry::residency);
+
+	}
+
+	Geometry::Geometry(const void *vertex_data, GLsizeiptr vertex_size, const void *index_data, GLsizeiptr index_size, GLenum index_type, const std::vector<GLsizei> &lod_offsets, const std::vector<GLsizei> &lod_counts, const BoundingBox &bounds, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout) {
+
+		// Everything was computed when the buffers were packed.
+		this->textures = textures;
+		this->shininess = shininess;
+		this->layout = layout;
+		this->index_type = index_type;
+		this->bounds = bounds;
+		this->lod_offsets = lod_offsets;
+		this->lod_counts = lod_counts;
+
+		// Hand the buffers to OpenGL as they are.
+		this->vao.bind();
+		this->vbo = std::make_shared<VBO>(vertex_data, vertex_size);
+		this->ebo = std::make_unique<EBO>(index_data, index_size);
+
+		// Links the VBO attributes stored by this layout to the VAO.
+		this->linkLayout(*this->vbo);
+
+		vao.unbind();
+		this->vbo->unbind();
+		this->ebo->unbind();
+
+	}
+
+	Geometry::Geometry(std::shared_ptr<VBO> vbo, EBO &&ebo, GLenum index_type, GLsizei count, const BoundingBox &bounds, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout) {
+
+		// The buffers are already filled, only the VAO is new.
+		this->textures = textures;
+		this->shininess = shininess;
+		this->layout = layout;
+		this->index_type = index_type;
+		this->bounds = bounds;
+		this->lod_offsets = {0};
+		this->lod_counts = {count};
+
+		// Keep the shared buffer alive and take the indices.
+		this->vbo = vbo;
+		this->ebo = std::make_unique<EBO>(std::move(ebo));
+
+		this->vao.bind();
+		this->ebo->bind();
+		this->linkLayout(*this->vbo);
+
+		vao.unbind();
+		this->vbo->unbind();
+		this->ebo->unbind();
 
 	}
 
@@ -73,18 +157,47 @@ namespace bgq_opengl {
 
 	}
 
-	VAO Geometry::getVAO() {
+	VAO &Geometry::getVAO() {
 
 		return this->vao;
 
 	}
 
+	VertexLayout Geometry::getLayout() {
+
+		return this->layout;
+
+	}
+
 	std::vector<Vertex> Geometry::getVertices() {
 
 		return this->vertices;
 
 	}
 
+	void Geometry::release(Residency residency) {
+
+		if (residency == KEEP_ALL)
+			return;
+
+		// Clearing would keep the capacity, swapping frees it.
+		std::vector<Vertex>().swap(this->vertices);
+		std::vector<GLuint>().swap(this->indices);
+
+	}
+
+	void Geometry::setResidency(Residency residency) {
+
+		Geometry::residency = residency;
+
+	}
+
+	Geometry::Residency Geometry::getResidency() {
+
+		return Geometry::residency;
+
+	}
+
     float Geometry::getShininess() {
         
         return this->shininess;
@@ -106,20 +219,34 @@ namespace bgq_opengl {
     void Geometry::setTransformMat(glm::mat4 transform) {
         
         this->transforms = transform;
+        this->transform_kind = NormalMatrix::classify(transform);
+        this->transform_version++;
+        
+    }
+
+    unsigned long Geometry::getTransformVersion() const {
+        
+        return this->transform_version;
+        
+    }
+
+    NormalMatrix::Kind Geometry::getTransformKind() const {
+        
+        return this->transform_kind;
         
     }
 
     void Geometry::addTexture(const char* image, const char* name) {
         
-        // Create the new texture from the parameters.
-        Texture new_tex(image, name, (int) this->textures.size() + 1);
+        // Create the new texture from the parameters, sharing the image with every other geometry that uses it.
+        Texture new_tex(TextureCache::load(image), name, (int) this->textures.size() + 1);
         
         // Add this texture to the texture vector.
         this->textures.push_back(new_tex);
         
     }
 
-	void Geometry::draw(Shader &shader, Camera &camera) {
+	void Geometry::prepareDraw(Shader &shader, Camera &camera, GLint matrix_index) {
 
 		// Activate the VAO and the shader to access the uniforms.
 		shader.activate();
@@ -143,6 +270,16 @@ namespace bgq_opengl {
         // Pass the shininess to the shader.
         shader.passFloat("materialShininess", this->shininess);
         
+        // Pass what the shader needs to decode the vertex layout.
+        shader.passVec("positionScale", this->layout.position_scale);
+        shader.passVec("positionOffset", this->layout.position_offset);
+        shader.passBool("octNormals", this->layout.oct_normals);
+        
+        // Streamed matrices are already on the GPU, the shader only needs to know where.
+        shader.passInt("matrixIndex", matrix_index);
+        if (matrix_index >= 0)
+            return;
+        
 		// Get the model matrix and pass it.
 		glm::mat4 model = this->transforms;
 		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "Model"), 1, GL_FALSE, glm::value_ptr(model));
@@ -152,17 +289,77 @@ namespace bgq_opengl {
 		glm::mat4 model_view = view * model;
 		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "modelView"), 1, GL_FALSE, glm::value_ptr(model_view));
 
-		// Get the normal matrix and pass it.
-		glm::mat4 normal_matrix = glm::transpose(glm::inverse(model_view));
+		// Get the normal matrix and pass it. The view is rigid, so its rotation is its normal matrix.
+		glm::mat4 normal_matrix = glm::mat4(glm::mat3(view) * NormalMatrix::compute(model, this->transform_kind));
 		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "normalMatrix"), 1, GL_FALSE, glm::value_ptr(normal_matrix));
 
-		// Draw the actual Geometry
-		glDrawElements(GL_TRIANGLES, (GLsizei) indices.size(), GL_UNSIGNED_INT, 0);
+	}
+
+	void Geometry::draw(Shader &shader, Camera &camera) {
+
+		this->draw(shader, camera, -1);
+
+	}
+
+	void Geometry::draw(Shader &shader, Camera &camera, GLint matrix_index) {
+
+		this->prepareDraw(shader, camera, matrix_index);
+
+		// Draw the actual Geometry at the current level of detail.
+		size_t index_size = this->index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+		glDrawElements(GL_TRIANGLES, this->lod_counts[this->lod], this->index_type, (void*)(this->lod_offsets[this->lod] * index_size));
+		RenderStats::addTriangles(this->lod_counts[this->lod] / 3);
+
+	}
+
+	void Geometry::drawInstanced(Shader &shader, Camera &camera, GLsizei count) {
+
+		this->prepareDraw(shader, camera, -1);
+
+		// Draw all the instances at once.
+		size_t index_size = this->index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+		glDrawElementsInstanced(GL_TRIANGLES, this->lod_counts[this->lod], this->index_type, (void*)(this->lod_offsets[this->lod] * index_size), count);
+		RenderStats::addTriangles(this->lod_counts[this->lod] / 3 * count);
+
+	}
+
+	void Geometry::linkInstanceAttribute(VBO &vbo, GLuint location, GLsizei stride, GLuint offset) {
+
+		this->vao.bind();
+		this->vao.link_instance_attribute(vbo, location, 4, GL_FLOAT, stride, (void*)(size_t) offset);
+		this->vao.unbind();
+
+	}
+
+	void Geometry::linkConstantAttribute(std::shared_ptr<VBO> vbo, GLuint location, GLint components, GLuint offset) {
+
+		// The VAO reads from it, so it has to live as long as the geometry.
+		this->attached.push_back(vbo);
+
+		this->vao.bind();
+		this->vao.link_constant_attribute(*vbo, location, components, GL_FLOAT, (void*)(size_t) offset);
+		this->vao.unbind();
+
+	}
+
+	void Geometry::linkLayout(VBO &vbo) {
+
+		for (size_t i = 0; i < this->layout.attributes.size(); i++) {
+
+			const VertexAttribute &attr = this->layout.attributes[i];
+			GLsizei stride = attr.stride > 0 ? attr.stride : this->layout.stride;
+			this->vao.link_attribute(vbo, attr.location, attr.components, attr.type, attr.normalized, stride, (void*)(size_t) attr.offset);
+
+		}
 
 	}
 
 	BoundingBox Geometry::getBoundingBox() const {
 
+		// Geometries that do not keep their vertices only keep the box.
+		if (this->vertices.empty())
+			return this->bounds;
+
 		// Create the bb.
 		BoundingBox bb;
 
@@ -197,9 +394,41 @@ namespace bgq_opengl {
 
 	}
 
+	BoundingBox Geometry::getWorldBoundingBox() const {
+
+		return this->bounds.transform(this->transforms);
+
+	}
+
+	BoundingBox Geometry::getWorldBoundingBox(const glm::mat4 &transform) const {
+
+		return this->bounds.transform(transform);
+
+	}
+
+	bool Geometry::isEmpty() const {
+
+		return this->lod_counts.empty() || this->lod_counts[0] == 0;
+
+	}
+
+	int Geometry::getNumLODs() const {
+
+		return (int) this->lod_counts.size();
+
+	}
+
+	void Geometry::setLOD(int level) {
+
+		this->lod = glm::clamp(level, 0, this->getNumLODs() - 1);
+
+	}
+
 	void Geometry::resetTransforms() {
 
 		this->transforms = glm::mat4(1.0f);
+		this->transform_kind = NormalMatrix::RIGID;
+		this->transform_version++;
 
 	}
 
@@ -213,6 +442,7 @@ namespace bgq_opengl {
 		glm::mat4 rotation_matrix = glm::rotate(identity_matrix, radians, glm::vec3(x, y, z));
 
 		this->transforms = rotation_matrix * this->transforms;
+		this->transform_version++;
 
 	}
 
@@ -223,6 +453,8 @@ namespace bgq_opengl {
 		glm::mat4 scale_matrix = glm::scale(identity_matrix, glm::vec3(x, y, z));
 
         this->transforms = scale_matrix * this->transforms;
+        this->transform_kind = NormalMatrix::combine(this->transform_kind, x == y && y == z ? NormalMatrix::UNIFORM : NormalMatrix::GENERAL);
+        this->transform_version++;
 
 	}
 
@@ -233,6 +465,7 @@ namespace bgq_opengl {
 
 		// Apply it to the transormations.
         this->transforms = trans_matrix * this->transforms;
+        this->transform_version++;
 
 	}
 
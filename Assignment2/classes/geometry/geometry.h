@@ -16,6 +16,7 @@
 #ifndef BGQ_OPENGL_CLASSES_GEOMETRY_H_
 #define BGQ_OPENGL_CLASSES_GEOMETRY_H_
 
+#include <memory>
 #include <vector>
 
 #include "GL/glew.h"
@@ -29,7 +30,9 @@
 #include "classes/vbo/vbo.h"
 #include "classes/vao/vao.h"
 #include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/normal_matrix/normal_matrix.h"
 
 namespace bgq_opengl {
 
@@ -37,13 +40,23 @@ namespace bgq_opengl {
 	* @brief Implementation of a Geometry class.
 	*
 	* Implementation of a Geometry class that will allow us to handle the geometric part
-	* of the objects in the VBOs.
+	* of the objects in the VBOs. It owns its VAO and index buffer, and shares its
+	* vertex buffer, so it can be moved but not copied. Everything is deleted from
+	* OpenGL once it goes out of scope.
 	*
 	* @author Borja García Quiroga <garcaqub@tcd.ie>
 	*/
 	class Geometry {
 
 		public:
+
+			/**
+			 * @brief What a geometry keeps on the CPU once it is on the GPU.
+			 */
+			enum Residency {
+				KEEP_ALL,			/// The vertices and indices, as they were given.
+				KEEP_BOUNDS			/// Only the bounding box.
+			};
 			
 			/**
 			 * @brief Initializes the Geometry.
@@ -56,10 +69,78 @@ namespace bgq_opengl {
 			 */
 			Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess);
 
+			/**
+			 * @brief Initializes the Geometry with a vertex layout.
+			 *
+			 * Initializes the geometry and stores its vertices on the GPU using the
+			 * given layout.
+			 *
+			 * @param vertices Vertices of the object.
+			 * @param indices Indices of the vertices.
+			 * @param textures Textures in connection with this geometry.
+			 * @param shininess The shininess of the material.
+			 * @param layout The layout used to store the vertices on the GPU.
+			 */
+			Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout);
+
+			/**
+			 * @brief Initializes the Geometry with levels of detail.
+			 *
+			 * Initializes the geometry and stores its vertices on the GPU using the
+			 * given layout, and all its levels of detail in a single index buffer.
+			 *
+			 * @param vertices Vertices of the object.
+			 * @param indices Indices of the vertices.
+			 * @param textures Textures in connection with this geometry.
+			 * @param shininess The shininess of the material.
+			 * @param layout The layout used to store the vertices on the GPU.
+			 * @param lods Indices of the simplified levels, from the finest to the coarsest.
+			 */
+			Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout, const std::vector<std::vector<GLuint>> &lods);
+
+			/**
+			 * @brief Initializes the Geometry from packed buffers.
+			 *
+			 * Initializes the geometry from vertices and indices already packed as they
+			 * go to the GPU, such as the ones of a rig cache. No CPU copy is kept, so
+			 * getVertices and getIndices return nothing.
+			 *
+			 * @param vertex_data The vertices packed in the layout.
+			 * @param vertex_size The size of the vertices in bytes.
+			 * @param index_data The indices of every level of detail, one after the other.
+			 * @param index_size The size of the indices in bytes.
+			 * @param index_type The type of the indices, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+			 * @param lod_offsets First index of each level of detail.
+			 * @param lod_counts Number of indices of each level of detail.
+			 * @param bounds The bounding box of the vertices.
+			 * @param textures Textures in connection with this geometry.
+			 * @param shininess The shininess of the material.
+			 * @param layout The layout the vertices are packed in.
+			 */
+			Geometry(const void *vertex_data, GLsizeiptr vertex_size, const void *index_data, GLsizeiptr index_size, GLenum index_type, const std::vector<GLsizei> &lod_offsets, const std::vector<GLsizei> &lod_counts, const BoundingBox &bounds, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout);
+
+			/**
+			 * @brief Initializes the Geometry over buffers already on the GPU.
+			 *
+			 * Initializes the geometry reading its vertices from a buffer that may be
+			 * shared with other geometries, such as the binary chunk of a GLB file. No
+			 * CPU copy is kept, so getVertices and getIndices return nothing.
+			 *
+			 * @param vbo The buffer holding the vertices, where the layout says, kept alive as long as the geometry.
+			 * @param ebo The buffer holding the indices, from its start, which the geometry takes.
+			 * @param index_type The type of the indices, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+			 * @param count The number of indices.
+			 * @param bounds The bounding box of the vertices.
+			 * @param textures Textures in connection with this geometry.
+			 * @param shininess The shininess of the material.
+			 * @param layout Where the attributes are in the buffer.
+			 */
+			Geometry(std::shared_ptr<VBO> vbo, EBO &&ebo, GLenum index_type, GLsizei count, const BoundingBox &bounds, const std::vector<Texture> &textures, const float shininess, const VertexLayout &layout);
+
 			/**
 			 * @brief Get the indices of the geometry.
 			 *
-			 * Get the indices of the geometry.
+			 * Get the indices of the geometry, if it still keeps them.
 			 */
 			std::vector<GLuint> getIndices();
 			
@@ -73,16 +154,50 @@ namespace bgq_opengl {
 			/**
 			 * @brief Get the VAO.
 			 *
-			 * Get the VAO.
+			 * Get the VAO, which stays owned by the geometry.
+			 */
+			VAO &getVAO();
+
+			/**
+			 * @brief Get the vertex layout.
+			 *
+			 * Get the layout used to store the vertices on the GPU.
 			 */
-			VAO getVAO();
+			VertexLayout getLayout();
 			
 			/**
 			 * @brief Get the vertices of the geometry.
 			 *
-			 * Get the vertices of the geometry.
+			 * Get the vertices of the geometry, if it still keeps them.
 			 */
 			std::vector<Vertex> getVertices();
+
+			/**
+			 * @brief Release the CPU copies.
+			 *
+			 * Free the vertices and indices kept on the CPU, unless the residency asks
+			 * to keep them.
+			 *
+			 * @param residency What to keep.
+			 */
+			void release(Residency residency);
+
+			/**
+			 * @brief Set the residency of new geometries.
+			 *
+			 * Set what the geometries built from vertices from now on keep on the CPU
+			 * once they are uploaded. They keep everything by default.
+			 *
+			 * @param residency What to keep.
+			 */
+			static void setResidency(Residency residency);
+
+			/**
+			 * @brief Get the residency of new geometries.
+			 *
+			 * @returns What the geometries built from vertices keep on the CPU.
+			 */
+			static Residency getResidency();
         
             /**
              * @brief Get the object shininess.
@@ -116,6 +231,24 @@ namespace bgq_opengl {
              */
             void setTransformMat(glm::mat4 transform);
         
+            /**
+             * @brief Get the version of the transform.
+             *
+             * Get a counter that changes every time the transform matrix does.
+             *
+             * @returns The version of the transform.
+             */
+            unsigned long getTransformVersion() const;
+        
+            /**
+             * @brief Get the kind of the transform.
+             *
+             * Get whether the transform is rigid, uniformly scaled or general.
+             *
+             * @returns The kind of the transform.
+             */
+            NormalMatrix::Kind getTransformKind() const;
+        
             /**
              * @brief Add a new texture to the geometry.
              *
@@ -133,6 +266,50 @@ namespace bgq_opengl {
 			 */
 			void draw(Shader &shader, Camera &camera);
 
+			/**
+			 * @brief Draws the Geometry with streamed matrices.
+			 *
+			 * Displays the Geometry in OpenGL reading its matrices from a MatrixStream
+			 * instead of uniforms.
+			 *
+			 * @param matrix_index The index of its matrices in the stream, or -1 to pass them as uniforms.
+			 */
+			void draw(Shader &shader, Camera &camera, GLint matrix_index);
+
+			/**
+			 * @brief Draws several instances of the Geometry.
+			 *
+			 * Displays several instances of the Geometry in OpenGL with a single call.
+			 *
+			 * @param count The number of instances.
+			 */
+			void drawInstanced(Shader &shader, Camera &camera, GLsizei count);
+
+			/**
+			 * @brief Links a per instance attribute.
+			 *
+			 * Links a vec4 float attribute of an instance buffer to the VAO of the Geometry.
+			 *
+			 * @param vbo The instance buffer.
+			 * @param location The layout location in the shader.
+			 * @param stride The size in bytes of an instance.
+			 * @param offset The offset in bytes of the attribute.
+			 */
+			void linkInstanceAttribute(VBO &vbo, GLuint location, GLsizei stride, GLuint offset);
+
+			/**
+			 * @brief Links a constant attribute.
+			 *
+			 * Links a float attribute whose single value is used by every vertex, such
+			 * as the color of a material.
+			 *
+			 * @param vbo The buffer holding the value, kept alive as long as the geometry.
+			 * @param location The layout location in the shader.
+			 * @param components The number of components.
+			 * @param offset The offset in bytes of the value.
+			 */
+			void linkConstantAttribute(std::shared_ptr<VBO> vbo, GLuint location, GLint components, GLuint offset);
+
 			/**
 			 * @brief Gets the bounding box.
 			 * 
@@ -142,6 +319,53 @@ namespace bgq_opengl {
 			 */
 			BoundingBox getBoundingBox() const;
 
+			/**
+			 * @brief Gets the world bounding box.
+			 * 
+			 * Gets the bounding box of the geometry after its transforms.
+			 * 
+			 * @returns The bounding box struct.
+			 */
+			BoundingBox getWorldBoundingBox() const;
+
+			/**
+			 * @brief Gets the bounding box under a transform.
+			 * 
+			 * Gets the bounding box of the geometry after a transform other than its own.
+			 * 
+			 * @param transform The transform.
+			 * 
+			 * @returns The bounding box struct.
+			 */
+			BoundingBox getWorldBoundingBox(const glm::mat4 &transform) const;
+
+			/**
+			 * @brief Checks if the geometry has anything to draw.
+			 * 
+			 * Checks if the geometry has anything to draw.
+			 * 
+			 * @returns True if it has no triangles.
+			 */
+			bool isEmpty() const;
+
+			/**
+			 * @brief Gets the number of levels of detail.
+			 * 
+			 * Gets the number of levels of detail, the full mesh included.
+			 * 
+			 * @returns The number of levels.
+			 */
+			int getNumLODs() const;
+
+			/**
+			 * @brief Sets the level of detail.
+			 * 
+			 * Sets the level of detail used by the next draws, 0 being the full mesh.
+			 * 
+			 * @param level The level.
+			 */
+			void setLOD(int level);
+
 			/**
 			 * @brief Reset
 			 *
@@ -185,6 +409,24 @@ namespace bgq_opengl {
 
 		private:
 
+			/**
+			 * @brief Links the attributes of the layout.
+			 *
+			 * Links every attribute stored by the layout to the VAO, which has to be bound.
+			 *
+			 * @param vbo The buffer holding the vertices.
+			 */
+			void linkLayout(VBO &vbo);
+
+			/**
+			 * @brief Passes the uniforms of a draw.
+			 *
+			 * Activates the shader and the VAO and passes the camera, material and matrices.
+			 *
+			 * @param matrix_index The index of the streamed matrices, or -1 to pass them as uniforms.
+			 */
+			void prepareDraw(Shader &shader, Camera &camera, GLint matrix_index);
+
 			/**
 			 * @brief Updates the normal matrix.
 			 * 
@@ -195,9 +437,22 @@ namespace bgq_opengl {
 			std::vector<GLuint> indices;				/// Indices of the vertices.
 			std::vector<Texture> textures;				/// Textures that will color this geometry.
 			VAO vao;									/// VAO containing this object.
+			std::shared_ptr<VBO> vbo;					/// Buffer holding the vertices.
+			std::unique_ptr<EBO> ebo;					/// Buffer holding the indices.
+			std::vector<std::shared_ptr<VBO>> attached;	/// Buffers of the constant attributes.
 			std::vector<Vertex> vertices;				/// Geometry vertices.
 			glm::mat4 transforms = glm::mat4(1.0f);		/// Tranform matrixes that will be passed to the shader.
             float shininess = 1.0;
+            VertexLayout layout;						/// Layout of the vertices on the GPU.
+            GLenum index_type = GL_UNSIGNED_INT;		/// Type of the indices on the GPU.
+            BoundingBox bounds{glm::vec3(0.0f), glm::vec3(0.0f)};	/// Bounding box of the vertices.
+            std::vector<GLsizei> lod_offsets;			/// First index of each level of detail.
+            std::vector<GLsizei> lod_counts;			/// Number of indices of each level of detail.
+            int lod = 0;								/// Level of detail being drawn.
+            unsigned long transform_version = 1;		/// Changes every time the transforms do.
+            NormalMatrix::Kind transform_kind = NormalMatrix::RIGID;	/// Kind of the transforms.
+
+            static Residency residency;					/// What new geometries keep on the CPU.
 
 	};
 
@@ -0,0 +1,134 @@
+/**
+ * @file gl_handle.cpp
+ * @brief GLHandle class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gl_handle.h"
+
+#include <cstddef>
+#include <utility>
+
+#include "GL/glew.h"
+
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
+
+namespace bgq_opengl {
+
+	GLHandle::GLHandle() {}
+
+	GLHandle::GLHandle(Kind kind) {
+
+		this->kind = kind;
+
+		switch (kind) {
+			case BUFFER: glGenBuffers(1, &this->ID); break;
+			case VERTEX_ARRAY: glGenVertexArrays(1, &this->ID); break;
+			case TEXTURE: glGenTextures(1, &this->ID); break;
+			case RENDERBUFFER: glGenRenderbuffers(1, &this->ID); break;
+			case FRAMEBUFFER: glGenFramebuffers(1, &this->ID); break;
+		}
+
+	}
+
+	GLHandle::~GLHandle() {
+
+		this->reset();
+
+	}
+
+	GLHandle::GLHandle(GLHandle &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	GLHandle &GLHandle::operator=(GLHandle &&other) noexcept {
+
+		if (this == &other)
+			return *this;
+
+		this->reset();
+
+		// Take everything, including what was reported, so the registry does not notice.
+		this->kind = other.kind;
+		this->ID = other.ID;
+		this->category = other.category;
+		this->bytes = other.bytes;
+		this->accounted = other.accounted;
+
+		other.ID = 0;
+		other.bytes = 0;
+		other.accounted = false;
+
+		return *this;
+
+	}
+
+	GLuint GLHandle::get() const {
+
+		return this->ID;
+
+	}
+
+	void GLHandle::account(GPUMemory::Category category, size_t bytes) {
+
+		if (this->accounted)
+			GPUMemory::release(this->category, this->bytes);
+
+		GPUMemory::allocate(category, bytes);
+
+		this->category = category;
+		this->bytes = bytes;
+		this->accounted = true;
+
+	}
+
+	void GLHandle::reset() {
+
+		if (this->accounted)
+			GPUMemory::release(this->category, this->bytes);
+
+		this->bytes = 0;
+		this->accounted = false;
+
+		if (this->ID == 0)
+			return;
+
+		// The cached bindings would point to a name OpenGL may hand out again.
+		switch (this->kind) {
+			case BUFFER:
+				GLState::forgetBuffer(this->ID);
+				glDeleteBuffers(1, &this->ID);
+				break;
+			case VERTEX_ARRAY:
+				GLState::forgetVertexArray(this->ID);
+				glDeleteVertexArrays(1, &this->ID);
+				break;
+			case TEXTURE:
+				GLState::forgetTexture(this->ID);
+				glDeleteTextures(1, &this->ID);
+				break;
+			case RENDERBUFFER:
+				glDeleteRenderbuffers(1, &this->ID);
+				break;
+			case FRAMEBUFFER:
+				glDeleteFramebuffers(1, &this->ID);
+				break;
+		}
+
+		this->ID = 0;
+
+	}
+
+}  // namespace bgq_opengl
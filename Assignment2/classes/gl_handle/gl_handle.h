@@ -0,0 +1,133 @@
+/**
+ * @file gl_handle.h
+ * @brief GLHandle class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GL_HANDLE_H_
+#define BGQ_OPENGL_CLASSES_GL_HANDLE_H_
+
+#include <cstddef>
+
+#include "GL/glew.h"
+
+#include "classes/gpu_memory/gpu_memory.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of an owned GL object.
+	 *
+	 * Owns the name of a GL object and deletes it when it goes out of scope, so
+	 * it can be moved but never copied. It also reports the storage given to the
+	 * object to the GPUMemory registry. It must only be touched from the GL thread,
+	 * and has to be reset before the context is destroyed.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GLHandle {
+
+		public:
+
+			/**
+			 * @brief The kinds of GL objects.
+			 */
+			enum Kind {
+				BUFFER,
+				VERTEX_ARRAY,
+				TEXTURE,
+				RENDERBUFFER,
+				FRAMEBUFFER
+			};
+
+			/**
+			 * @brief Initializes an empty handle.
+			 *
+			 * Initializes a handle that owns no object.
+			 */
+			GLHandle();
+
+			/**
+			 * @brief Creates a GL object.
+			 *
+			 * Generates a new GL object of a kind and takes ownership of it.
+			 *
+			 * @param kind The kind of object.
+			 */
+			explicit GLHandle(Kind kind);
+
+			/**
+			 * @brief Deletes the GL object.
+			 *
+			 * Deletes the GL object, if it owns one.
+			 */
+			~GLHandle();
+
+			GLHandle(const GLHandle &) = delete;
+			GLHandle &operator=(const GLHandle &) = delete;
+
+			/**
+			 * @brief Takes the object of another handle.
+			 *
+			 * @param other The handle, which is left empty.
+			 */
+			GLHandle(GLHandle &&other) noexcept;
+
+			/**
+			 * @brief Takes the object of another handle.
+			 *
+			 * Deletes the object it owned and takes the one of the other handle.
+			 *
+			 * @param other The handle, which is left empty.
+			 *
+			 * @returns This handle.
+			 */
+			GLHandle &operator=(GLHandle &&other) noexcept;
+
+			/**
+			 * @brief Get the GL name.
+			 *
+			 * @returns The name of the object, or 0 if it owns none.
+			 */
+			GLuint get() const;
+
+			/**
+			 * @brief Account the storage.
+			 *
+			 * Report the storage the object was given, replacing what was reported
+			 * before, for example when a buffer grows.
+			 *
+			 * @param category What the storage is used for.
+			 * @param bytes The size of the storage.
+			 */
+			void account(GPUMemory::Category category, size_t bytes);
+
+			/**
+			 * @brief Delete the object.
+			 *
+			 * Delete the GL object now and leave the handle empty.
+			 */
+			void reset();
+
+		private:
+
+			Kind kind = BUFFER;										/// The kind of object.
+			GLuint ID = 0;											/// The GL name of the object.
+			GPUMemory::Category category = GPUMemory::VERTICES;		/// What its storage is used for.
+			size_t bytes = 0;										/// The storage reported to the registry.
+			bool accounted = false;									/// Whether it was reported to the registry.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_GL_HANDLE_H_
@@ -0,0 +1,215 @@
+/**
+ * @file gl_state.cpp
+ * @brief GLState class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gl_state.h"
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	// A new context starts with nothing bound and GL_LESS as the depth function.
+	GLuint GLState::program = 0;
+	GLuint GLState::vertex_array = 0;
+	GLuint GLState::array_buffer = 0;
+	GLuint GLState::element_buffer = 0;
+	GLuint GLState::active_unit = 0;
+	GLuint GLState::textures_2d[GL_STATE_MAX_UNITS] = {};
+	GLuint GLState::textures_cube[GL_STATE_MAX_UNITS] = {};
+	GLenum GLState::depth_func = GL_LESS;
+	unsigned long GLState::elided = 0;
+	unsigned long GLState::issued = 0;
+
+	void GLState::useProgram(GLuint program) {
+
+		if (GLState::program == program) {
+			elided++;
+			return;
+		}
+
+		glUseProgram(program);
+		GLState::program = program;
+		issued++;
+
+	}
+
+	void GLState::bindVertexArray(GLuint vao) {
+
+		if (vertex_array == vao) {
+			elided++;
+			return;
+		}
+
+		glBindVertexArray(vao);
+		vertex_array = vao;
+		issued++;
+
+		// The element buffer is part of the VAO, so we no longer know which one is bound.
+		element_buffer = UNKNOWN;
+
+	}
+
+	void GLState::bindBuffer(GLenum target, GLuint buffer) {
+
+		// Get the cached binding for this target.
+		GLuint *cached;
+		if (target == GL_ARRAY_BUFFER) {
+			cached = &array_buffer;
+		} else if (target == GL_ELEMENT_ARRAY_BUFFER) {
+			cached = &element_buffer;
+		} else {
+			glBindBuffer(target, buffer);
+			issued++;
+			return;
+		}
+
+		if (*cached == buffer) {
+			elided++;
+			return;
+		}
+
+		glBindBuffer(target, buffer);
+		*cached = buffer;
+		issued++;
+
+	}
+
+	void GLState::activeTexture(GLuint unit) {
+
+		if (active_unit == unit) {
+			elided++;
+			return;
+		}
+
+		glActiveTexture(GL_TEXTURE0 + unit);
+		active_unit = unit;
+		issued++;
+
+	}
+
+	void GLState::bindTexture(GLenum target, GLuint unit, GLuint texture) {
+
+		// Get the cached binding for this unit and target.
+		GLuint *cached = 0;
+		if (unit < GL_STATE_MAX_UNITS) {
+			if (target == GL_TEXTURE_2D)
+				cached = &textures_2d[unit];
+			else if (target == GL_TEXTURE_CUBE_MAP)
+				cached = &textures_cube[unit];
+		}
+
+		if (cached != 0 && *cached == texture) {
+			elided++;
+			return;
+		}
+
+		// Binding always applies to the active unit.
+		activeTexture(unit);
+		glBindTexture(target, texture);
+		issued++;
+
+		if (cached != 0)
+			*cached = texture;
+
+	}
+
+	void GLState::depthFunc(GLenum func) {
+
+		if (depth_func == func) {
+			elided++;
+			return;
+		}
+
+		glDepthFunc(func);
+		depth_func = func;
+		issued++;
+
+	}
+
+	void GLState::forgetProgram(GLuint program) {
+
+		if (GLState::program == program)
+			GLState::program = UNKNOWN;
+
+	}
+
+	void GLState::forgetVertexArray(GLuint vao) {
+
+		if (vertex_array == vao) {
+			vertex_array = UNKNOWN;
+			element_buffer = UNKNOWN;
+		}
+
+	}
+
+	void GLState::forgetBuffer(GLuint buffer) {
+
+		if (array_buffer == buffer)
+			array_buffer = UNKNOWN;
+
+		if (element_buffer == buffer)
+			element_buffer = UNKNOWN;
+
+	}
+
+	void GLState::forgetTexture(GLuint texture) {
+
+		for (int i = 0; i < GL_STATE_MAX_UNITS; i++) {
+
+			if (textures_2d[i] == texture)
+				textures_2d[i] = UNKNOWN;
+
+			if (textures_cube[i] == texture)
+				textures_cube[i] = UNKNOWN;
+
+		}
+
+	}
+
+	void GLState::invalidate() {
+
+		program = UNKNOWN;
+		vertex_array = UNKNOWN;
+		array_buffer = UNKNOWN;
+		element_buffer = UNKNOWN;
+		active_unit = UNKNOWN;
+		depth_func = GL_NONE;
+
+		for (int i = 0; i < GL_STATE_MAX_UNITS; i++) {
+			textures_2d[i] = UNKNOWN;
+			textures_cube[i] = UNKNOWN;
+		}
+
+	}
+
+	unsigned long GLState::getElidedCalls() {
+
+		return elided;
+
+	}
+
+	unsigned long GLState::getIssuedCalls() {
+
+		return issued;
+
+	}
+
+	void GLState::resetCounters() {
+
+		elided = 0;
+		issued = 0;
+
+	}
+
+}  // namespace bgq_opengl
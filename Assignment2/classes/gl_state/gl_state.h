@@ -0,0 +1,186 @@
+/**
+ * @file gl_state.h
+ * @brief GLState class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GL_STATE_H_
+#define BGQ_OPENGL_CLASSES_GL_STATE_H_
+
+#include "GL/glew.h"
+
+#define GL_STATE_MAX_UNITS 48
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a GL state tracker.
+	 *
+	 * Keeps a shadow copy of the bound program, VAO, buffers, textures and depth
+	 * function so that redundant state changes never reach the driver. Every class
+	 * that binds something in OpenGL should go through this one.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GLState {
+
+		public:
+
+			/**
+			 * @brief Use a shader program.
+			 *
+			 * Calls glUseProgram only if the program is not already in use.
+			 *
+			 * @param program The OpenGL program ID.
+			 */
+			static void useProgram(GLuint program);
+
+			/**
+			 * @brief Bind a vertex array.
+			 *
+			 * Calls glBindVertexArray only if the VAO is not already bound.
+			 *
+			 * @param vao The OpenGL VAO ID.
+			 */
+			static void bindVertexArray(GLuint vao);
+
+			/**
+			 * @brief Bind a buffer.
+			 *
+			 * Calls glBindBuffer only if the buffer is not already bound to that target.
+			 * The element array binding belongs to the VAO, so it is forgotten whenever
+			 * the VAO changes.
+			 *
+			 * @param target GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER.
+			 * @param buffer The OpenGL buffer ID.
+			 */
+			static void bindBuffer(GLenum target, GLuint buffer);
+
+			/**
+			 * @brief Select the active texture unit.
+			 *
+			 * Calls glActiveTexture only if the unit is not already active.
+			 *
+			 * @param unit The texture unit, starting at 0 (not GL_TEXTURE0).
+			 */
+			static void activeTexture(GLuint unit);
+
+			/**
+			 * @brief Bind a texture to a unit.
+			 *
+			 * Activates the unit and binds the texture, skipping whatever is already
+			 * in place.
+			 *
+			 * @param target GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP.
+			 * @param unit The texture unit, starting at 0 (not GL_TEXTURE0).
+			 * @param texture The OpenGL texture ID.
+			 */
+			static void bindTexture(GLenum target, GLuint unit, GLuint texture);
+
+			/**
+			 * @brief Set the depth function.
+			 *
+			 * Calls glDepthFunc only if the function changes.
+			 *
+			 * @param func The depth comparison function.
+			 */
+			static void depthFunc(GLenum func);
+
+			/**
+			 * @brief Forget a deleted program.
+			 *
+			 * Must be called when a program is deleted, as its ID can be reused.
+			 *
+			 * @param program The OpenGL program ID.
+			 */
+			static void forgetProgram(GLuint program);
+
+			/**
+			 * @brief Forget a deleted vertex array.
+			 *
+			 * Must be called when a VAO is deleted, as its ID can be reused.
+			 *
+			 * @param vao The OpenGL VAO ID.
+			 */
+			static void forgetVertexArray(GLuint vao);
+
+			/**
+			 * @brief Forget a deleted buffer.
+			 *
+			 * Must be called when a buffer is deleted, as its ID can be reused.
+			 *
+			 * @param buffer The OpenGL buffer ID.
+			 */
+			static void forgetBuffer(GLuint buffer);
+
+			/**
+			 * @brief Forget a deleted texture.
+			 *
+			 * Must be called when a texture is deleted, as its ID can be reused.
+			 *
+			 * @param texture The OpenGL texture ID.
+			 */
+			static void forgetTexture(GLuint texture);
+
+			/**
+			 * @brief Invalidate the whole cache.
+			 *
+			 * Call it after code that touches OpenGL without going through this class,
+			 * so that the next call of each kind always reaches the driver.
+			 */
+			static void invalidate();
+
+			/**
+			 * @brief Get the number of elided calls.
+			 *
+			 * Get the number of state changes that were skipped since the last reset.
+			 *
+			 * @returns The number of elided calls.
+			 */
+			static unsigned long getElidedCalls();
+
+			/**
+			 * @brief Get the number of issued calls.
+			 *
+			 * Get the number of state changes that reached OpenGL since the last reset.
+			 *
+			 * @returns The number of issued calls.
+			 */
+			static unsigned long getIssuedCalls();
+
+			/**
+			 * @brief Reset the counters.
+			 *
+			 * Reset the elided and issued counters, usually once per frame.
+			 */
+			static void resetCounters();
+
+		private:
+
+			static const GLuint UNKNOWN = 0xFFFFFFFF;	/// Value used when the state is not known.
+
+			static GLuint program;								/// Program in use.
+			static GLuint vertex_array;							/// Bound VAO.
+			static GLuint array_buffer;							/// Bound GL_ARRAY_BUFFER.
+			static GLuint element_buffer;						/// Bound GL_ELEMENT_ARRAY_BUFFER of the bound VAO.
+			static GLuint active_unit;							/// Active texture unit.
+			static GLuint textures_2d[GL_STATE_MAX_UNITS];		/// GL_TEXTURE_2D bound to each unit.
+			static GLuint textures_cube[GL_STATE_MAX_UNITS];	/// GL_TEXTURE_CUBE_MAP bound to each unit.
+			static GLenum depth_func;							/// Current depth function.
+			static unsigned long elided;						/// Calls that were skipped.
+			static unsigned long issued;						/// Calls that reached OpenGL.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_GL_STATE_H_
@@ -0,0 +1,97 @@
+/**
+ * @file gpu_memory.cpp
+ * @brief GPUMemory class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gpu_memory.h"
+
+#include <cassert>
+#include <cstddef>
+
+namespace bgq_opengl {
+
+	size_t GPUMemory::bytes[GPUMemory::NUM_CATEGORIES] = {};
+	unsigned int GPUMemory::counts[GPUMemory::NUM_CATEGORIES] = {};
+
+	void GPUMemory::allocate(Category category, size_t size) {
+
+		bytes[category] += size;
+		counts[category]++;
+
+	}
+
+	void GPUMemory::release(Category category, size_t size) {
+
+		assert(counts[category] > 0 && bytes[category] >= size);
+
+		bytes[category] -= size;
+		counts[category]--;
+
+	}
+
+	size_t GPUMemory::getBytes(Category category) {
+
+		return bytes[category];
+
+	}
+
+	unsigned int GPUMemory::getCount(Category category) {
+
+		return counts[category];
+
+	}
+
+	size_t GPUMemory::getTotalBytes() {
+
+		size_t total = 0;
+		for (int i = 0; i < NUM_CATEGORIES; i++)
+			total += bytes[i];
+
+		return total;
+
+	}
+
+	const char *GPUMemory::getName(Category category) {
+
+		switch (category) {
+			case VERTICES: return "Vertices";
+			case INDICES: return "Indices";
+			case STREAMS: return "Streams";
+			case TEXTURES: return "Textures";
+			case TARGETS: return "Targets";
+			default: return "";
+		}
+
+	}
+
+	size_t GPUMemory::getTextureSize(int width, int height, int faces, bool mipmaps) {
+
+		size_t size = 0;
+
+		// Every level is half the size of the previous one, down to a single pixel.
+		while (true) {
+
+			size += (size_t) width * height * 4 * faces;
+			if (!mipmaps || (width == 1 && height == 1))
+				break;
+
+			width = width > 1 ? width / 2 : 1;
+			height = height > 1 ? height / 2 : 1;
+
+		}
+
+		return size;
+
+	}
+
+}  // namespace bgq_opengl
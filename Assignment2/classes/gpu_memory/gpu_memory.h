@@ -0,0 +1,126 @@
+/**
+ * @file gpu_memory.h
+ * @brief GPUMemory class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GPU_MEMORY_H_
+#define BGQ_OPENGL_CLASSES_GPU_MEMORY_H_
+
+#include <cstddef>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of the GPU memory registry.
+	 *
+	 * Keeps the number of live GL objects and the bytes of storage they were given,
+	 * by category. The GLHandles report to it as their storage is allocated and
+	 * deleted, so the totals are always those of the objects alive right now. The
+	 * sizes are the ones asked to OpenGL, drivers may pad them.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GPUMemory {
+
+		public:
+
+			/**
+			 * @brief What the storage is used for.
+			 */
+			enum Category {
+				VERTICES,		/// Vertex buffers.
+				INDICES,		/// Index buffers.
+				STREAMS,		/// Buffers rewritten every frame, such as the matrix stream.
+				TEXTURES,		/// Textures and cubemaps.
+				TARGETS,		/// Render targets.
+				NUM_CATEGORIES
+			};
+
+			/**
+			 * @brief Count an allocation.
+			 *
+			 * Count an object of a category and its storage.
+			 *
+			 * @param category The category.
+			 * @param bytes The size of the storage.
+			 */
+			static void allocate(Category category, size_t bytes);
+
+			/**
+			 * @brief Count a release.
+			 *
+			 * Stop counting an object of a category and its storage.
+			 *
+			 * @param category The category.
+			 * @param bytes The size of the storage.
+			 */
+			static void release(Category category, size_t bytes);
+
+			/**
+			 * @brief Get the bytes of a category.
+			 *
+			 * @param category The category.
+			 *
+			 * @returns The bytes held by its live objects.
+			 */
+			static size_t getBytes(Category category);
+
+			/**
+			 * @brief Get the objects of a category.
+			 *
+			 * @param category The category.
+			 *
+			 * @returns The number of live objects.
+			 */
+			static unsigned int getCount(Category category);
+
+			/**
+			 * @brief Get the bytes of every category.
+			 *
+			 * @returns The bytes held by all the live objects.
+			 */
+			static size_t getTotalBytes();
+
+			/**
+			 * @brief Get the name of a category.
+			 *
+			 * @param category The category.
+			 *
+			 * @returns Its name, to be shown.
+			 */
+			static const char *getName(Category category);
+
+			/**
+			 * @brief Get the size of a texture.
+			 *
+			 * Get the storage of an uncompressed RGBA8 texture.
+			 *
+			 * @param width The width in pixels.
+			 * @param height The height in pixels.
+			 * @param faces The number of faces, 6 for cubemaps.
+			 * @param mipmaps Whether it has a full mip chain.
+			 *
+			 * @returns The size in bytes.
+			 */
+			static size_t getTextureSize(int width, int height, int faces, bool mipmaps);
+
+		private:
+
+			static size_t bytes[NUM_CATEGORIES];		/// Bytes held in each category.
+			static unsigned int counts[NUM_CATEGORIES];	/// Live objects in each category.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_GPU_MEMORY_H_
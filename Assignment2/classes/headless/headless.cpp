@@ -0,0 +1,217 @@
+/**
+ * @file headless.cpp
+ * @brief Headless class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "headless.h"
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gpu_memory/gpu_memory.h"
+
+#ifndef __APPLE__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace bgq_opengl {
+
+	int Headless::width = 0;
+	int Headless::height = 0;
+	GLHandle Headless::framebuffer;
+	GLHandle Headless::color;
+	GLHandle Headless::depth;
+
+#ifndef __APPLE__
+
+	namespace {
+
+		EGLDisplay display = EGL_NO_DISPLAY;	// The EGL display.
+		EGLContext context = EGL_NO_CONTEXT;	// The EGL context.
+
+		// Get a display that needs neither a window system nor a GPU.
+		EGLDisplay getDisplay() {
+
+			// Prefer the surfaceless platform.
+			PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+			if (getPlatformDisplay) {
+
+				EGLDisplay surfaceless = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+				if (surfaceless != EGL_NO_DISPLAY)
+					return surfaceless;
+
+			}
+
+			// Fall back to whatever the default one is.
+			return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+		}
+
+	}
+
+	bool Headless::init(int width, int height) {
+
+		Headless::width = width;
+		Headless::height = height;
+
+		// Get the display.
+		display = getDisplay();
+		if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+
+			std::cerr << "Error 121-1003 - Could not get an EGL display." << std::endl;
+			return false;
+
+		}
+
+		// We want desktop OpenGL, not ES.
+		eglBindAPI(EGL_OPENGL_API);
+
+		// Choose any config that can render OpenGL. The default surface type is a window,
+		// which surfaceless displays never offer.
+		const EGLint config_attribs[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+
+		EGLConfig config;
+		EGLint num_configs = 0;
+		if (!eglChooseConfig(display, config_attribs, &config, 1, &num_configs) || num_configs == 0) {
+
+			std::cerr << "Error 121-1004 - No EGL config supports OpenGL." << std::endl;
+			return false;
+
+		}
+
+		// Create the same 3.3 core context the windowed mode gets.
+		const EGLint context_attribs[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 3,
+			EGL_CONTEXT_MINOR_VERSION, 3,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+
+		context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attribs);
+		if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+
+			std::cerr << "Error 121-1005 - Could not create an OpenGL 3.3 core context." << std::endl;
+			return false;
+
+		}
+
+		// Initialize GLEW. A GLX build of GLEW complains about the missing X display
+		// but still loads every entry point through the current context.
+		glewExperimental = GL_TRUE;
+		GLenum res = glewInit();
+
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+		if (res == GLEW_ERROR_NO_GLX_DISPLAY)
+			res = GLEW_OK;
+#endif
+
+		if (res != GLEW_OK) {
+
+			std::cerr << "Error 121-1002 - GLEW could not be initialized:" << glewGetErrorString(res) << std::endl;
+			return false;
+
+		}
+
+		// There is no default framebuffer, so render into our own.
+		color = GLHandle(GLHandle::RENDERBUFFER);
+		glBindRenderbuffer(GL_RENDERBUFFER, color.get());
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+		color.account(GPUMemory::TARGETS, (size_t) width * height * 4);
+
+		// Drivers store 24 bits depth in 32 bits.
+		depth = GLHandle(GLHandle::RENDERBUFFER);
+		glBindRenderbuffer(GL_RENDERBUFFER, depth.get());
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+		depth.account(GPUMemory::TARGETS, (size_t) width * height * 4);
+
+		framebuffer = GLHandle(GLHandle::FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.get());
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color.get());
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth.get());
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+
+			std::cerr << "Error 121-1006 - The offscreen framebuffer is incomplete." << std::endl;
+			return false;
+
+		}
+
+		glViewport(0, 0, width, height);
+
+		return true;
+
+	}
+
+	void Headless::terminate() {
+
+		// They have to go before the context does.
+		framebuffer.reset();
+		color.reset();
+		depth.reset();
+
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(display, context);
+		eglTerminate(display);
+
+	}
+
+#else
+
+	bool Headless::init(int width, int height) {
+
+		std::cerr << "Error 121-1003 - Headless mode needs EGL, which is not available on macOS." << std::endl;
+		return false;
+
+	}
+
+	void Headless::terminate() {}
+
+#endif
+
+	bool Headless::saveFrame(const char *filename) {
+
+		// Read the color attachment.
+		std::vector<unsigned char> pixels(width * height * 3);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.get());
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+		FILE *file = fopen(filename, "wb");
+		if (!file) {
+
+			std::cerr << "Could not write the frame to " << filename << std::endl;
+			return false;
+
+		}
+
+		// OpenGL starts at the bottom row, PPM at the top one.
+		fprintf(file, "P6\n%d %d\n255\n", width, height);
+		for (int y = height - 1; y >= 0; y--)
+			fwrite(&pixels[y * width * 3], 1, width * 3, file);
+
+		fclose(file);
+
+		return true;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,82 @@
+/**
+ * @file headless.h
+ * @brief Headless class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_HEADLESS_H_
+#define BGQ_OPENGL_CLASSES_HEADLESS_H_
+
+#include "GL/glew.h"
+
+#include "classes/gl_handle/gl_handle.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a headless OpenGL backend.
+	 *
+	 * Creates an OpenGL 3.3 core context without any window through EGL on the
+	 * surfaceless platform (Mesa llvmpipe works without a GPU or a display) and
+	 * renders into an offscreen framebuffer. It is not available on macOS, which
+	 * has no EGL.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Headless {
+
+		public:
+
+			/**
+			 * @brief Create the context and the framebuffer.
+			 *
+			 * Create the offscreen context, make it current, initialize GLEW and bind a
+			 * framebuffer with a color and a depth attachment.
+			 *
+			 * @param width The width of the framebuffer.
+			 * @param height The height of the framebuffer.
+			 *
+			 * @returns False if the context could not be created.
+			 */
+			static bool init(int width, int height);
+
+			/**
+			 * @brief Save the framebuffer.
+			 *
+			 * Read the color attachment back and save it as a binary PPM image.
+			 *
+			 * @param filename The name of the image file.
+			 *
+			 * @returns False if the file could not be written.
+			 */
+			static bool saveFrame(const char *filename);
+
+			/**
+			 * @brief Destroy the framebuffer and the context.
+			 *
+			 * Destroy the framebuffer and the context.
+			 */
+			static void terminate();
+
+		private:
+
+			static int width;				/// Width of the framebuffer.
+			static int height;				/// Height of the framebuffer.
+			static GLHandle framebuffer;	/// The offscreen framebuffer.
+			static GLHandle color;			/// The color renderbuffer.
+			static GLHandle depth;			/// The depth renderbuffer.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_HEADLESS_H_
@@ -28,6 +28,8 @@ namespace bgq_opengl {
 
 	}
 
+	Loader::~Loader() {}
+
     inline void Loader::loadModel() {}
 
 	std::string Loader::readFileContents(const char* filename) {
@@ -48,10 +48,17 @@ namespace bgq_opengl {
 			 */
 			Loader(const char *filename);
 
+			/**
+			 * @brief Destroys the loader.
+			 *
+			 * Destroys the loader and whatever geometries were not handed over.
+			 */
+			virtual ~Loader();
+
 			/**
 			 * @brief Get the geometries from the loaded model.
 			 *
-			 * Get the geometries from the loaded model.
+			 * Get the geometries from the loaded model, which are moved out of the loader.
 			 *
 			 * @param geoms Outputs the geometries returned.
 			 * @param matrices Outputs the transformation matrices.
@@ -16,6 +16,7 @@
 #include "loader_assimp.h"
 #include "classes/loader/loader.h"
 
+#include <utility>
 #include <vector>
 #include <iostream>
 
@@ -26,7 +27,10 @@
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include "classes/mesh_converter/mesh_converter.h"
+#include "classes/mesh_optimizer/mesh_optimizer.h"
 #include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
 
 namespace bgq_opengl {
 
@@ -51,14 +55,24 @@ namespace bgq_opengl {
         std::cerr << "  " << scene->mNumMeshes << " meshes" << std::endl;
         std::cerr << "  " << scene->mNumTextures << " textures" << std::endl;
         
-        // Loop through the different meshes in the scene.
+        // Convert and optimize every mesh at once.
+        std::vector<std::vector<Vertex>> vertices(scene->mNumMeshes);
+        std::vector<std::vector<GLuint>> indices(scene->mNumMeshes);
+        std::vector<MeshOptimizer::Stats> stats(scene->mNumMeshes);
+        MeshConverter::parallelFor(scene->mNumMeshes, [&](size_t i) {
+            MeshConverter::convert(scene, scene->mMeshes[i], vertices[i], indices[i]);
+            stats[i] = MeshOptimizer::optimize(vertices[i], indices[i]);
+        });
+        
+        // Create their GL objects on this thread, which owns the context.
         for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
             
             // Get the mesh itself.
             const aiMesh* mesh = scene->mMeshes[i];
+            std::cerr << "  mesh " << mesh->mName.C_Str() << ": " << stats[i].vertices_before << " -> " << stats[i].vertices_after << " vertices, ACMR " << stats[i].acmr_before << " -> " << stats[i].acmr_after << std::endl;
             
             // Load this mesh.
-            loadGeometry(scene, mesh);
+            loadGeometry(scene, mesh, vertices[i], indices[i]);
             
         }
 
@@ -66,88 +80,21 @@ namespace bgq_opengl {
 
 	}
 
-	void LoaderAssimp::loadGeometry(const aiScene* scene, const aiMesh* mesh) {
-        
-        // Init the ds.
-        std::vector<bgq_opengl::Vertex> vertices(0);
-        std::vector<GLuint> indices(0);
+	void LoaderAssimp::loadGeometry(const aiScene* scene, const aiMesh* mesh, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices) {
         
         // If has materials, pass them.
         aiMaterial *mat = scene->mMaterials[mesh->mMaterialIndex];
-        aiColor3D color;
-        mat->Get(AI_MATKEY_COLOR_DIFFUSE, color);
         float shine = 0.0;
         mat->Get(AI_MATKEY_SHININESS, shine);
-        
-        // Iterate through the vertices in the mesh.
-        for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-            
-            // Build an empty vertex.
-            bgq_opengl::Vertex vertex{
-                glm::vec3(0.0f, 0.0f, 0.0f),    // Position.
-                glm::vec3(1.0f, 1.0f, 1.0f),    // Normal.
-                glm::vec3(0.0f, 0.0f, 1.0f),    // Color.
-                glm::vec2(0.0f, 0.0f),          // UV coords.
-                glm::vec3(0.0f, 1.0f, 0.0f),    // Tangente.
-                glm::vec3(1.0f, 0.0f, 0.0f)     // Bitangente.
-            };
-            
-            // If it has a position, subtitute it in the vertex.
-            if (mesh->HasPositions()) {
-                
-                const aiVector3D* vp = &(mesh->mVertices[i]);
-                vertex.position = glm::vec3(vp->x, vp->y, vp->z);
-                
-            }
-            
-            vertex.color = glm::vec3(color.r, color.g, color.b);
-            
-            // If it has a normal, subtitute it in the vertex.
-            if (mesh->HasNormals()) {
-                
-                const aiVector3D* vn = &(mesh->mNormals[i]);
-                vertex.normal = glm::vec3(vn->x, vn->y, vn->z);
-                
-            }
-            
-            // If it has UV textures, subtitute it in the vertex.
-            if (mesh->HasTextureCoords(0)) {
-                                
-                const aiVector3D* vt = &(mesh->mTextureCoords[0][i]);
-                vertex.uv = glm::vec2(-vt->y, vt->x);
-                
-            }
-            
-            // Check if it has tangents.
-            if (mesh->HasTangentsAndBitangents()) {
-                
-                const aiVector3D* tangent = &(mesh->mTangents[i]);
-                vertex.tangent = glm::vec3(tangent->x, tangent->y, tangent->z);
-                
-                const aiVector3D* bitangent = &(mesh->mBitangents[i]);
-                vertex.bitangent = glm::vec3(bitangent->x, bitangent->y, bitangent->z);
-                                
-            }
-            
-            // Add that to vertices.
-            vertices.push_back(vertex);
-
-        }
-        
-        // Lets store all the indices or faces.
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-            
-            indices.push_back(mesh->mFaces[j].mIndices[0]);
-            indices.push_back(mesh->mFaces[j].mIndices[1]);
-            indices.push_back(mesh->mFaces[j].mIndices[2]);
-        
-        }
 
 		// Obtain the textures.
 		std::vector<bgq_opengl::Texture> textures = getTextures();
 
+		// Choose the most compact layout this mesh can use.
+		VertexLayout layout = VertexLayout::choose(vertices, !textures.empty());
+
 		// Create a Geometry object that contains all this data.
-		this->geometries.push_back(bgq_opengl::Geometry(vertices, indices, textures, shine));
+		this->geometries.push_back(bgq_opengl::Geometry(vertices, indices, textures, shine, layout));
 
 	}
 
@@ -172,7 +119,8 @@ namespace bgq_opengl {
 
 	void LoaderAssimp::getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) {
 
-		(*geoms) = this->geometries;
+		// The geometries own their GL objects, so they are handed over.
+		(*geoms) = std::move(this->geometries);
 		(*matrices) = this->transform_matrixes;
 
 	}
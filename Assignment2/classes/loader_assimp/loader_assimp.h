@@ -20,11 +20,14 @@
 
 #include <vector>
 
+#include "GL/glew.h"
 #include "glm/glm.hpp"
 #include "assimp/cimport.h"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include "structs/vertex/vertex.h"
+
 namespace bgq_opengl {
 
 	/**
@@ -48,7 +51,7 @@ namespace bgq_opengl {
 			/**
 			 * @brief Get the geometries from the loaded model.
 			 * 
-			 * Get the geometries from the loaded model.
+			 * Get the geometries from the loaded model, which are moved out of the loader.
 			 * 
 			 * @param geoms Outputs the geometries returned.
 			 * @param matrices Outputs the transformation matrices.
@@ -65,13 +68,15 @@ namespace bgq_opengl {
 		private:
 
 			/**
-			 * @brief Loads a mesh by its index.
+			 * @brief Loads a converted mesh.
 			 *
-			 * Loads a mesh by its index.
+			 * Creates the geometry of a mesh already converted and optimized.
 			 *
 			 * @param mesh the assimp  mesh.
+			 * @param vertices The vertices of the mesh.
+			 * @param indices The indices of the mesh.
 			 */
-			void loadGeometry(const aiScene* scene, const aiMesh* mesh);
+			void loadGeometry(const aiScene* scene, const aiMesh* mesh, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices);
         
             /**
              * @brief Load the textures for this model.
@@ -0,0 +1,253 @@
+/**
+ * @file loader_glb.cpp
+ * @brief Loader class implementation file for binary glTF files.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "loader_glb.h"
+#include "classes/loader/loader.h"
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/ebo/ebo.h"
+#include "classes/mapped_file/mapped_file.h"
+#include "classes/mesh_converter/mesh_converter.h"
+#include "classes/mesh_optimizer/mesh_optimizer.h"
+#include "classes/vbo/vbo.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/gltf_file/gltf_file.h"
+#include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
+
+namespace bgq_opengl {
+
+	LoaderGLB::LoaderGLB(const char* filename) : Loader(filename) {}
+
+	void LoaderGLB::loadModel() {
+
+		// Map the file, its binary chunk is read in place.
+		MappedFile mapped;
+		GltfFile file;
+		std::string error;
+
+		if (!mapped.open(filename)) {
+
+			std::cerr << "Error 121-1011 - Could not read the GLB file " << filename << "." << std::endl;
+			exit(1);
+
+		}
+
+		if (!GltfFile::read(mapped.getData(), mapped.getSize(), file, error)) {
+
+			std::cerr << "Error 121-1011 - Could not read the GLB file " << filename << ": " << error << "." << std::endl;
+			exit(1);
+
+		}
+
+		// Print info from the scene.
+		std::cerr << "  " << filename << std::endl;
+		std::cerr << "  " << file.materials.size() << " materials" << std::endl;
+		std::cerr << "  " << file.meshes.size() << " meshes" << std::endl;
+		std::cerr << "  " << file.nodes.size() << " nodes" << std::endl;
+
+		// Collect the primitives of every node in the scene, parents first.
+		std::vector<Part> parts;
+		std::vector<int> stack(file.roots.rbegin(), file.roots.rend());
+		while (!stack.empty()) {
+
+			int node = stack.back();
+			stack.pop_back();
+
+			const GltfFile::Node &n = file.nodes[node];
+			if (n.mesh >= 0) {
+				for (size_t i = 0; i < file.meshes[n.mesh].primitives.size(); i++) {
+					Part part;
+					part.node = node;
+					part.mesh = n.mesh;
+					part.primitive = (int) i;
+					part.direct = LoaderGLB::isDirect(file, file.meshes[n.mesh].primitives[i]);
+					parts.push_back(part);
+				}
+			}
+
+			for (size_t i = n.children.size(); i > 0; i--)
+				stack.push_back(n.children[i - 1]);
+
+		}
+
+		// Convert and optimize the primitives that cannot be read in place at once.
+		std::vector<MeshOptimizer::Stats> stats(parts.size());
+		MeshConverter::parallelFor(parts.size(), [&](size_t i) {
+			Part &part = parts[i];
+			if (part.direct)
+				return;
+			MeshConverter::convert(file, file.meshes[part.mesh].primitives[part.primitive], part.vertices, part.indices);
+			stats[i] = MeshOptimizer::optimize(part.vertices, part.indices);
+		});
+
+		// Upload the binary chunk once for all the direct primitives, which share it.
+		std::shared_ptr<VBO> binary = std::make_shared<VBO>(file.binary, (GLsizeiptr) file.binary_size);
+		binary->unbind();
+
+		// The color of each material, and white for primitives without one.
+		std::vector<float> material_colors;
+		for (size_t i = 0; i < file.materials.size(); i++) {
+			material_colors.push_back(file.materials[i].base_color.x);
+			material_colors.push_back(file.materials[i].base_color.y);
+			material_colors.push_back(file.materials[i].base_color.z);
+		}
+		material_colors.insert(material_colors.end(), {1.0f, 1.0f, 1.0f});
+		std::shared_ptr<VBO> colors = std::make_shared<VBO>(material_colors.data(), (GLsizeiptr) (material_colors.size() * sizeof(float)));
+		colors->unbind();
+
+		// Create their GL objects in order.
+		for (size_t i = 0; i < parts.size(); i++) {
+
+			Part &part = parts[i];
+			const GltfFile::Primitive &primitive = file.meshes[part.mesh].primitives[part.primitive];
+			std::string name = file.meshes[part.mesh].name;
+
+			if (part.direct) {
+
+				std::cerr << "  mesh " << name << ": in place" << std::endl;
+				this->loadDirect(file, primitive, binary, colors);
+
+			} else {
+
+				if (part.indices.empty()) {
+					std::cerr << "  mesh " << name << ": skipped, it has no triangles" << std::endl;
+					continue;
+				}
+
+				std::cerr << "  mesh " << name << ": converted, " << stats[i].vertices_before << " -> " << stats[i].vertices_after << " vertices, ACMR " << stats[i].acmr_before << " -> " << stats[i].acmr_after << std::endl;
+
+				// There are no textures, so UVs are not kept.
+				std::vector<Texture> textures;
+				VertexLayout layout = VertexLayout::choose(part.vertices, !textures.empty());
+				this->geometries.push_back(Geometry(part.vertices, part.indices, textures, LoaderGLB::getShininess(file, primitive.material), layout));
+
+			}
+
+			// Assimp would have baked it, here it becomes the matrix of the geometry.
+			this->transform_matrixes.push_back(file.getWorldMatrix(part.node));
+
+		}
+
+	}
+
+	bool LoaderGLB::isDirect(const GltfFile &file, const GltfFile::Primitive &primitive) {
+
+		if (primitive.mode != GL_TRIANGLES || primitive.indices < 0)
+			return false;
+
+		// Positions and normals, three components of any type, aligned for the GPU.
+		const char *names[] = {"POSITION", "NORMAL"};
+		for (int i = 0; i < 2; i++) {
+
+			int accessor = primitive.getAttribute(names[i]);
+			if (accessor < 0)
+				return false;
+
+			const GltfFile::Accessor &a = file.accessors[accessor];
+			if (a.view < 0 || a.sparse || a.components != 3 || file.getOffset(accessor) % 4 != 0 || file.getStride(accessor) % 4 != 0)
+				return false;
+
+		}
+
+		// Tightly packed indices.
+		const GltfFile::Accessor &a = file.accessors[primitive.indices];
+		if (a.view < 0 || a.sparse || a.components != 1 || file.views[a.view].stride != 0)
+			return false;
+
+		return a.component_type == GL_UNSIGNED_BYTE || a.component_type == GL_UNSIGNED_SHORT || a.component_type == GL_UNSIGNED_INT;
+
+	}
+
+	void LoaderGLB::loadDirect(const GltfFile &file, const GltfFile::Primitive &primitive, std::shared_ptr<VBO> binary, std::shared_ptr<VBO> colors) {
+
+		// Point the attributes at their buffer views, each with its own stride.
+		VertexLayout layout = VertexLayout::full();
+		layout.stride = 0;
+		layout.attributes.clear();
+
+		const char *names[] = {"POSITION", "NORMAL"};
+		for (GLuint i = 0; i < 2; i++) {
+			int accessor = primitive.getAttribute(names[i]);
+			const GltfFile::Accessor &a = file.accessors[accessor];
+			layout.attributes.push_back({i, 3, a.component_type, (GLboolean) (a.normalized ? GL_TRUE : GL_FALSE), (GLuint) file.getOffset(accessor), file.getStride(accessor)});
+		}
+
+		// The bounds are in the file, they only have to be read if they are missing.
+		int position = primitive.getAttribute("POSITION");
+		const GltfFile::Accessor &p = file.accessors[position];
+		BoundingBox bounds{p.min, p.max};
+		if (!p.has_bounds) {
+			std::vector<float> values;
+			file.readFloats(position, 3, values);
+			bounds.min = glm::vec3(INFINITY);
+			bounds.max = glm::vec3(-INFINITY);
+			for (size_t i = 0; i + 2 < values.size(); i += 3) {
+				bounds.min = glm::min(bounds.min, glm::vec3(values[i], values[i + 1], values[i + 2]));
+				bounds.max = glm::max(bounds.max, glm::vec3(values[i], values[i + 1], values[i + 2]));
+			}
+		}
+
+		// Byte indices cannot be drawn fast, widen them to shorts.
+		const GltfFile::Accessor &a = file.accessors[primitive.indices];
+		const unsigned char *index_data = file.binary + file.getOffset(primitive.indices);
+		GLenum index_type = a.component_type;
+		std::vector<GLushort> widened;
+		if (index_type == GL_UNSIGNED_BYTE) {
+			widened.assign(index_data, index_data + a.count);
+			index_data = (const unsigned char *) widened.data();
+			index_type = GL_UNSIGNED_SHORT;
+		}
+
+		EBO ebo(index_data, (GLsizeiptr) (a.count * GltfFile::getComponentSize(index_type)));
+
+		std::vector<Texture> textures;
+		Geometry geometry(binary, std::move(ebo), index_type, (GLsizei) a.count, bounds, textures, LoaderGLB::getShininess(file, primitive.material), layout);
+
+		// Every vertex takes the color of the material.
+		int material = primitive.material >= 0 ? primitive.material : (int) file.materials.size();
+		geometry.linkConstantAttribute(colors, 2, 3, (GLuint) (material * 3 * sizeof(float)));
+
+		this->geometries.push_back(std::move(geometry));
+
+	}
+
+	float LoaderGLB::getShininess(const GltfFile &file, int material) {
+
+		// The same conversion from roughness as Assimp does.
+		float roughness = material >= 0 ? file.materials[material].roughness : 1.0f;
+
+		return (1.0f - roughness) * (1.0f - roughness) * 1000.0f;
+
+	}
+
+	void LoaderGLB::getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) {
+
+		// The geometries own their GL objects, so they are handed over.
+		(*geoms) = std::move(this->geometries);
+		(*matrices) = this->transform_matrixes;
+
+	}
+
+}
@@ -0,0 +1,130 @@
+/**
+ * @file loader_glb.h
+ * @brief Loader GLB class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_LOADER_GLB_H_
+#define BGQ_OPENGL_CLASSES_LOADER_GLB_H_
+
+#include "classes/loader/loader.h"
+
+#include <memory>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/ebo/ebo.h"
+#include "classes/vbo/vbo.h"
+#include "structs/gltf_file/gltf_file.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a GLB Loader class.
+	 *
+	 * Implements a loader class that reads binary glTF files without Assimp. The
+	 * file is memory mapped and its binary chunk is uploaded once, so that the
+	 * geometries read their positions and normals straight from the buffer views.
+	 * Primitives whose attributes OpenGL cannot read as they are go through the
+	 * same conversion and optimization as the Assimp loader.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class LoaderGLB : public Loader {
+
+		public:
+
+			/**
+			 * @brief Build a loader instance.
+			 *
+			 * Build a loader instance.
+			 */
+			LoaderGLB(const char* filename);
+
+			/**
+			 * @brief Get the geometries from the loaded model.
+			 *
+			 * Get the geometries from the loaded model, which are moved out of the loader.
+			 *
+			 * @param geoms Outputs the geometries returned.
+			 * @param matrices Outputs the transformation matrices.
+			 */
+			void getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices);
+
+			/**
+			 * @brief Loads the data from the file.
+			 *
+			 * Loads the data from the file.
+			 *
+			 * @throws 121-1011 Could not read the GLB file.
+			 */
+			void loadModel();
+
+		private:
+
+			/**
+			 * @brief A primitive of a node, ready to become a geometry.
+			 */
+			struct Part {
+
+				int node;						/// The node holding it.
+				int mesh;						/// Its mesh.
+				int primitive;					/// Its index in the mesh.
+				bool direct;					/// Whether it is read straight from the buffer views.
+				std::vector<Vertex> vertices;	/// The converted vertices, if it is not direct.
+				std::vector<GLuint> indices;	/// The converted indices, if it is not direct.
+
+			};
+
+			/**
+			 * @brief Check whether a primitive can be read in place.
+			 *
+			 * Check whether OpenGL can read the positions, normals and indices of a
+			 * primitive straight from the binary chunk.
+			 *
+			 * @param file The GLB file.
+			 * @param primitive The primitive.
+			 *
+			 * @returns Whether it can.
+			 */
+			static bool isDirect(const GltfFile &file, const GltfFile::Primitive &primitive);
+
+			/**
+			 * @brief Loads a primitive in place.
+			 *
+			 * Creates the geometry of a primitive over the uploaded binary chunk.
+			 *
+			 * @param file The GLB file.
+			 * @param primitive The primitive.
+			 * @param binary The buffer holding the binary chunk.
+			 * @param colors The buffer holding the color of each material.
+			 */
+			void loadDirect(const GltfFile &file, const GltfFile::Primitive &primitive, std::shared_ptr<VBO> binary, std::shared_ptr<VBO> colors);
+
+			/**
+			 * @brief Get the shininess of a material.
+			 *
+			 * @param file The GLB file.
+			 * @param material The material, or -1.
+			 *
+			 * @returns The shininess.
+			 */
+			static float getShininess(const GltfFile &file, int material);
+
+	};
+
+}
+
+#endif  //!BGQ_OPENGL_CLASSES_LOADER_GLB_H_
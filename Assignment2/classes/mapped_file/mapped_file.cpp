@@ -0,0 +1,117 @@
+/**
+ * @file mapped_file.cpp
+ * @brief MappedFile class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mapped_file.h"
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bgq_opengl {
+
+	MappedFile::MappedFile() {}
+
+	MappedFile::~MappedFile() {
+
+		this->close();
+
+	}
+
+	bool MappedFile::open(const std::string &path) {
+
+		this->close();
+
+#ifdef _WIN32
+
+		// Read it whole instead.
+		std::ifstream in(path, std::ios::binary);
+		if (!in)
+			return false;
+
+		this->contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		this->data = this->contents.data();
+		this->size = this->contents.size();
+
+		return true;
+
+#else
+
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+			::close(fd);
+			return false;
+		}
+
+		// The mapping keeps the file alive once the descriptor is closed.
+		void *mapping = mmap(0, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+
+		if (mapping == MAP_FAILED)
+			return false;
+
+		// Everything is going to be read right away.
+		madvise(mapping, (size_t) info.st_size, MADV_WILLNEED);
+
+		this->data = (const unsigned char *) mapping;
+		this->size = (size_t) info.st_size;
+		this->mapped = true;
+
+		return true;
+
+#endif
+
+	}
+
+	void MappedFile::close() {
+
+#ifndef _WIN32
+		if (this->mapped)
+			munmap((void *) this->data, this->size);
+#endif
+
+		this->data = 0;
+		this->size = 0;
+		this->mapped = false;
+		this->contents.clear();
+		this->contents.shrink_to_fit();
+
+	}
+
+	const unsigned char *MappedFile::getData() const {
+
+		return this->data;
+
+	}
+
+	size_t MappedFile::getSize() const {
+
+		return this->size;
+
+	}
+
+}  // namespace bgq_opengl
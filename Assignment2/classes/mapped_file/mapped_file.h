@@ -0,0 +1,98 @@
+/**
+ * @file mapped_file.h
+ * @brief MappedFile class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MAPPED_FILE_H_
+#define BGQ_OPENGL_CLASSES_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a read only memory mapped file.
+	 *
+	 * Maps a whole file in memory so that its contents can be read, or handed to
+	 * OpenGL, without copying them first. Where there is no mmap the file is read
+	 * into memory instead.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MappedFile {
+
+		public:
+
+			/**
+			 * @brief Initializes an empty mapping.
+			 *
+			 * Initializes a mapping with no file open.
+			 */
+			MappedFile();
+
+			/**
+			 * @brief Closes the mapping.
+			 *
+			 * Unmaps the file if there is one.
+			 */
+			~MappedFile();
+
+			MappedFile(const MappedFile &) = delete;
+			MappedFile &operator=(const MappedFile &) = delete;
+
+			/**
+			 * @brief Map a file.
+			 *
+			 * Map a whole file in memory, closing the previous one.
+			 *
+			 * @param path The path of the file.
+			 *
+			 * @returns Whether it could be mapped.
+			 */
+			bool open(const std::string &path);
+
+			/**
+			 * @brief Unmap the file.
+			 *
+			 * Unmap the file. Its contents cannot be read afterwards.
+			 */
+			void close();
+
+			/**
+			 * @brief Get the contents.
+			 *
+			 * @returns The first byte of the file, or 0 if there is none.
+			 */
+			const unsigned char *getData() const;
+
+			/**
+			 * @brief Get the size.
+			 *
+			 * @returns The size of the file in bytes.
+			 */
+			size_t getSize() const;
+
+		private:
+
+			const unsigned char *data = 0;			/// The mapped file.
+			size_t size = 0;						/// Size of the mapped file.
+			bool mapped = false;					/// Whether data is mapped or points to contents.
+			std::vector<unsigned char> contents;	/// The file, where it cannot be mapped.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_MAPPED_FILE_H_
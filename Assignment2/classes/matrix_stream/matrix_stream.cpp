@@ -0,0 +1,199 @@
+/**
+ * @file matrix_stream.cpp
+ * @brief MatrixStream class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "matrix_stream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
+#include "classes/render_stats/render_stats.h"
+#include "classes/shader/shader.h"
+#include "structs/normal_matrix/normal_matrix.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		// Bytes taken by one node.
+		const GLsizeiptr NODE_SIZE = MATRIX_STREAM_TEXELS * 4 * sizeof(float);
+
+	}
+
+	MatrixStream::MatrixStream(GLsizei capacity) {
+
+		this->capacity = std::max(capacity, 1);
+
+		// No region holds any transform yet.
+		this->versions.assign(MATRIX_STREAM_REGIONS * this->capacity, 0);
+
+		// Allocate all the regions at once.
+		this->buffer = GLHandle(GLHandle::BUFFER);
+		GLState::bindBuffer(GL_TEXTURE_BUFFER, this->buffer.get());
+		glBufferData(GL_TEXTURE_BUFFER, MATRIX_STREAM_REGIONS * this->capacity * NODE_SIZE, NULL, GL_STREAM_DRAW);
+		GLState::bindBuffer(GL_TEXTURE_BUFFER, 0);
+		this->buffer.account(GPUMemory::STREAMS, (size_t) (MATRIX_STREAM_REGIONS * this->capacity * NODE_SIZE));
+
+		// Let the shaders read it as an array of vec4.
+		this->texture = GLHandle(GLHandle::TEXTURE);
+		GLState::bindTexture(GL_TEXTURE_BUFFER, MATRIX_STREAM_TEXTURE_UNIT, this->texture.get());
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, this->buffer.get());
+
+	}
+
+	MatrixStream::~MatrixStream() {
+
+		this->remove();
+
+	}
+
+	void MatrixStream::begin() {
+
+		this->region = (this->region + 1) % MATRIX_STREAM_REGIONS;
+
+		// Wait until the frame that last read this region has been drawn.
+		GLsync &sync = this->fences[this->region];
+		if (sync != 0) {
+
+			GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			while (result == GL_TIMEOUT_EXPIRED)
+				result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+			if (result == GL_WAIT_FAILED)
+				std::cerr << "Error 121-1007 - Waiting on a matrix stream fence failed." << std::endl;
+
+			glDeleteSync(sync);
+			sync = 0;
+
+		}
+
+		// The GPU is done with it, so it can be mapped without any implicit synchronization.
+		GLState::bindBuffer(GL_TEXTURE_BUFFER, this->buffer.get());
+		this->mapped = (unsigned char *) glMapBufferRange(GL_TEXTURE_BUFFER, this->region * this->capacity * NODE_SIZE, this->capacity * NODE_SIZE, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+
+		if (this->mapped == 0)
+			std::cerr << "Error 121-1008 - The matrix stream could not be mapped." << std::endl;
+
+		this->first_written = this->capacity;
+		this->last_written = -1;
+
+	}
+
+	void MatrixStream::write(GLsizei slot, unsigned long version, const glm::mat4 &model, NormalMatrix::Kind kind) {
+
+		assert(slot >= 0 && slot < this->capacity);
+
+		// Skip the nodes that have not moved since this region was written. Version 0 is never stored.
+		unsigned long &written = this->versions[this->region * this->capacity + slot];
+		if ((version != 0 && written == version) || this->mapped == 0)
+			return;
+
+		// Keep it until the end of the frame so all the normal matrices are computed together.
+		this->staged_slots.push_back(slot);
+		this->staged_models.push_back(model);
+		this->staged_kinds.push_back(kind);
+
+		written = version;
+
+	}
+
+	void MatrixStream::end() {
+
+		if (this->mapped == 0)
+			return;
+
+		// Compute the normal matrices of all the nodes that moved at once.
+		size_t count = this->staged_slots.size();
+		this->staged_normals.resize(count);
+		NormalMatrix::computeBatch(this->staged_models.data(), this->staged_kinds.data(), count, this->staged_normals.data());
+
+		for (size_t i = 0; i < count; i++) {
+
+			// The model matrix goes in the first four texels, the normal matrix in the next three.
+			const glm::mat3 &normal = this->staged_normals[i];
+			float data[MATRIX_STREAM_TEXELS * 4];
+			std::memcpy(data, &this->staged_models[i][0][0], 16 * sizeof(float));
+			for (int j = 0; j < 3; j++) {
+				data[16 + 4 * j + 0] = normal[j][0];
+				data[16 + 4 * j + 1] = normal[j][1];
+				data[16 + 4 * j + 2] = normal[j][2];
+				data[16 + 4 * j + 3] = 0.0f;
+			}
+
+			GLsizei slot = this->staged_slots[i];
+			std::memcpy(this->mapped + slot * NODE_SIZE, data, NODE_SIZE);
+
+			this->first_written = std::min(this->first_written, slot);
+			this->last_written = std::max(this->last_written, slot);
+
+		}
+
+		RenderStats::addMatrices((unsigned int) count);
+		this->staged_slots.clear();
+		this->staged_models.clear();
+		this->staged_kinds.clear();
+
+		// Flush only the slots that were written.
+		GLState::bindBuffer(GL_TEXTURE_BUFFER, this->buffer.get());
+		if (this->last_written >= this->first_written)
+			glFlushMappedBufferRange(GL_TEXTURE_BUFFER, this->first_written * NODE_SIZE, (this->last_written - this->first_written + 1) * NODE_SIZE);
+
+		glUnmapBuffer(GL_TEXTURE_BUFFER);
+		GLState::bindBuffer(GL_TEXTURE_BUFFER, 0);
+		this->mapped = 0;
+
+	}
+
+	void MatrixStream::bind(Shader &shader) {
+
+		GLState::bindTexture(GL_TEXTURE_BUFFER, MATRIX_STREAM_TEXTURE_UNIT, this->texture.get());
+		shader.passInt("nodeMatrices", MATRIX_STREAM_TEXTURE_UNIT);
+
+	}
+
+	void MatrixStream::fence() {
+
+		this->fences[this->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	}
+
+	GLint MatrixStream::getIndex(GLsizei slot) const {
+
+		return this->region * this->capacity + slot;
+
+	}
+
+	void MatrixStream::remove() {
+
+		for (int i = 0; i < MATRIX_STREAM_REGIONS; i++) {
+			if (this->fences[i] != 0)
+				glDeleteSync(this->fences[i]);
+			this->fences[i] = 0;
+		}
+
+		this->texture.reset();
+		this->buffer.reset();
+
+	}
+
+}  // namespace bgq_opengl
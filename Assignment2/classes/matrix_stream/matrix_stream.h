@@ -0,0 +1,150 @@
+/**
+ * @file matrix_stream.h
+ * @brief MatrixStream class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MATRIX_STREAM_H_
+#define BGQ_OPENGL_CLASSES_MATRIX_STREAM_H_
+
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/shader/shader.h"
+#include "structs/normal_matrix/normal_matrix.h"
+
+#define MATRIX_STREAM_REGIONS 3         // Number of regions of the ring, one per frame in flight.
+#define MATRIX_STREAM_TEXELS 7          // RGBA32F texels per node: the model matrix and the normal matrix.
+#define MATRIX_STREAM_TEXTURE_UNIT 15   // Texture unit the stream is bound to.
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a streaming buffer for node matrices.
+	 *
+	 * Implements a ring of MATRIX_STREAM_REGIONS regions inside a texture buffer,
+	 * one region per frame in flight. Each frame the next region is mapped without
+	 * synchronization once its fence has signaled, and only the nodes whose
+	 * transform changed since that region was last written are rewritten. Draws
+	 * index into the region through a uniform instead of receiving their matrices.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MatrixStream {
+
+		public:
+
+			/**
+			 * @brief Build a matrix stream.
+			 *
+			 * Build a matrix stream with room for a number of nodes.
+			 *
+			 * @param capacity The number of nodes.
+			 */
+			MatrixStream(GLsizei capacity);
+
+			/**
+			 * @brief Delete the stream.
+			 *
+			 * Delete the stream if it has not been removed yet.
+			 */
+			~MatrixStream();
+
+			/**
+			 * @brief Start writing a frame.
+			 *
+			 * Move to the next region of the ring, wait until the GPU is done with it
+			 * and map it.
+			 */
+			void begin();
+
+			/**
+			 * @brief Write the matrices of a node.
+			 *
+			 * Write the model matrix of a node and its normal matrix, unless this region
+			 * already holds that version of the transform. Version 0 is always written,
+			 * for matrices that do not belong to any stored transform. The writes are
+			 * staged and the normal matrices computed in a batch when the frame ends.
+			 *
+			 * @param slot The slot of the node.
+			 * @param version The version of the transform.
+			 * @param model The model matrix.
+			 * @param kind The kind of the model matrix.
+			 */
+			void write(GLsizei slot, unsigned long version, const glm::mat4 &model, NormalMatrix::Kind kind);
+
+			/**
+			 * @brief Finish writing a frame.
+			 *
+			 * Compute the normal matrices of the staged nodes, copy them to the region,
+			 * flush it and unmap it.
+			 */
+			void end();
+
+			/**
+			 * @brief Bind the stream.
+			 *
+			 * Bind the texture buffer and pass it to the shader.
+			 *
+			 * @param shader The shader that will read the matrices.
+			 */
+			void bind(Shader &shader);
+
+			/**
+			 * @brief Fence the frame.
+			 *
+			 * Fence the draws that read the current region, to be called after them.
+			 */
+			void fence();
+
+			/**
+			 * @brief Get the index of a node.
+			 *
+			 * Get the index the shader has to read for a node in the current region.
+			 *
+			 * @param slot The slot of the node.
+			 *
+			 * @returns The index in the texture buffer.
+			 */
+			GLint getIndex(GLsizei slot) const;
+
+			/**
+			 * @brief Delete the stream.
+			 *
+			 * Delete the buffer, the texture and the pending fences before it goes out of scope.
+			 */
+			void remove();
+
+		private:
+
+			GLHandle buffer;							/// The buffer.
+			GLHandle texture;							/// The buffer texture.
+			GLsizei capacity = 0;						/// Number of nodes per region.
+			int region = MATRIX_STREAM_REGIONS - 1;		/// Region being written or drawn.
+			GLsync fences[MATRIX_STREAM_REGIONS] = {};	/// Fence of the last frame that read each region.
+			std::vector<unsigned long> versions;		/// Version of the transform written in each slot of each region.
+			unsigned char *mapped = 0;					/// Mapped memory of the current region.
+			GLsizei first_written = 0;					/// First slot written this frame.
+			GLsizei last_written = -1;					/// Last slot written this frame.
+			std::vector<GLsizei> staged_slots;			/// Slots of the nodes to write this frame.
+			std::vector<glm::mat4> staged_models;		/// Model matrices of the nodes to write this frame.
+			std::vector<NormalMatrix::Kind> staged_kinds;	/// Kinds of the model matrices.
+			std::vector<glm::mat3> staged_normals;		/// Normal matrices computed for them.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_MATRIX_STREAM_H_
@@ -0,0 +1,201 @@
+/**
+ * @file mesh_converter.cpp
+ * @brief MeshConverter class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mesh_converter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+#include "assimp/scene.h"
+
+#include "structs/gltf_file/gltf_file.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	void MeshConverter::convert(const aiScene *scene, const aiMesh *mesh, std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+		// Get the diffuse color of its material.
+		aiColor3D color;
+		scene->mMaterials[mesh->mMaterialIndex]->Get(AI_MATKEY_COLOR_DIFFUSE, color);
+
+		// Start every vertex with the defaults of the attributes the mesh may not have.
+		const Vertex empty{
+			glm::vec3(0.0f, 0.0f, 0.0f),			// Position.
+			glm::vec3(1.0f, 1.0f, 1.0f),			// Normal.
+			glm::vec3(color.r, color.g, color.b),	// Color.
+			glm::vec2(0.0f, 0.0f),					// UV coords.
+			glm::vec3(0.0f, 1.0f, 0.0f),			// Tangente.
+			glm::vec3(1.0f, 0.0f, 0.0f)				// Bitangente.
+		};
+
+		const unsigned int count = mesh->mNumVertices;
+		vertices.assign(count, empty);
+
+		// Copy each attribute array in a loop of its own.
+		if (mesh->HasPositions()) {
+			const aiVector3D *positions = mesh->mVertices;
+			for (unsigned int i = 0; i < count; i++)
+				vertices[i].position = glm::vec3(positions[i].x, positions[i].y, positions[i].z);
+		}
+
+		if (mesh->HasNormals()) {
+			const aiVector3D *normals = mesh->mNormals;
+			for (unsigned int i = 0; i < count; i++)
+				vertices[i].normal = glm::vec3(normals[i].x, normals[i].y, normals[i].z);
+		}
+
+		if (mesh->HasTextureCoords(0)) {
+			const aiVector3D *uvs = mesh->mTextureCoords[0];
+			for (unsigned int i = 0; i < count; i++)
+				vertices[i].uv = glm::vec2(-uvs[i].y, uvs[i].x);
+		}
+
+		if (mesh->HasTangentsAndBitangents()) {
+			const aiVector3D *tangents = mesh->mTangents;
+			const aiVector3D *bitangents = mesh->mBitangents;
+			for (unsigned int i = 0; i < count; i++) {
+				vertices[i].tangent = glm::vec3(tangents[i].x, tangents[i].y, tangents[i].z);
+				vertices[i].bitangent = glm::vec3(bitangents[i].x, bitangents[i].y, bitangents[i].z);
+			}
+		}
+
+		// The scene was triangulated, so every face has three indices.
+		indices.resize((size_t) mesh->mNumFaces * 3);
+		for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
+			const unsigned int *face = mesh->mFaces[j].mIndices;
+			indices[j * 3] = face[0];
+			indices[j * 3 + 1] = face[1];
+			indices[j * 3 + 2] = face[2];
+		}
+
+	}
+
+	void MeshConverter::convert(const GltfFile &file, const GltfFile::Primitive &primitive, std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+		// Start every vertex with the same defaults as Assimp meshes.
+		glm::vec4 color = primitive.material >= 0 ? file.materials[primitive.material].base_color : glm::vec4(1.0f);
+		const Vertex empty{
+			glm::vec3(0.0f, 0.0f, 0.0f),			// Position.
+			glm::vec3(1.0f, 1.0f, 1.0f),			// Normal.
+			glm::vec3(color.x, color.y, color.z),	// Color.
+			glm::vec2(0.0f, 0.0f),					// UV coords.
+			glm::vec3(0.0f, 1.0f, 0.0f),			// Tangente.
+			glm::vec3(1.0f, 0.0f, 0.0f)				// Bitangente.
+		};
+
+		int position = primitive.getAttribute("POSITION");
+		if (position < 0)
+			return;
+
+		size_t count = file.accessors[position].count;
+		vertices.assign(count, empty);
+
+		// Copy each attribute array in a loop of its own.
+		std::vector<float> values;
+		if (file.readFloats(position, 3, values))
+			for (size_t i = 0; i < count; i++)
+				vertices[i].position = glm::vec3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
+
+		int normal = primitive.getAttribute("NORMAL");
+		if (normal >= 0 && file.accessors[normal].count == count && file.readFloats(normal, 3, values))
+			for (size_t i = 0; i < count; i++)
+				vertices[i].normal = glm::vec3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
+
+		int uv = primitive.getAttribute("TEXCOORD_0");
+		if (uv >= 0 && file.accessors[uv].count == count && file.readFloats(uv, 2, values))
+			for (size_t i = 0; i < count; i++)
+				vertices[i].uv = glm::vec2(-values[i * 2 + 1], values[i * 2]);
+
+		int tangent = primitive.getAttribute("TANGENT");
+		if (tangent >= 0 && file.accessors[tangent].count == count && file.readFloats(tangent, 4, values)) {
+			for (size_t i = 0; i < count; i++) {
+				vertices[i].tangent = glm::vec3(values[i * 4], values[i * 4 + 1], values[i * 4 + 2]);
+				vertices[i].bitangent = glm::cross(vertices[i].normal, vertices[i].tangent) * values[i * 4 + 3];
+			}
+		}
+
+		// Get the indices, or number the vertices if there are none.
+		std::vector<GLuint> order;
+		if (primitive.indices < 0 || !file.readIndices(primitive.indices, order)) {
+			order.resize(count);
+			for (size_t i = 0; i < count; i++)
+				order[i] = (GLuint) i;
+		}
+
+		for (size_t i = 0; i < order.size(); i++)
+			if (order[i] >= count)
+				return;
+
+		// Turn strips and fans into triangles, points and lines are not drawn.
+		indices.clear();
+		if (primitive.mode == GL_TRIANGLES) {
+			indices.assign(order.begin(), order.begin() + order.size() / 3 * 3);
+		} else if (primitive.mode == GL_TRIANGLE_STRIP) {
+			for (size_t i = 2; i < order.size(); i++) {
+				bool odd = i % 2 == 1;
+				indices.insert(indices.end(), {order[i - 2], order[odd ? i : i - 1], order[odd ? i - 1 : i]});
+			}
+		} else if (primitive.mode == GL_TRIANGLE_FAN) {
+			for (size_t i = 2; i < order.size(); i++)
+				indices.insert(indices.end(), {order[0], order[i - 1], order[i]});
+		}
+
+	}
+
+	void MeshConverter::parallelFor(size_t count, const std::function<void(size_t)> &task) {
+
+		size_t num_threads = std::min((size_t) MeshConverter::getNumThreads(), count);
+
+		// Not worth a thread.
+		if (num_threads <= 1) {
+			for (size_t i = 0; i < count; i++)
+				task(i);
+			return;
+		}
+
+		// Every thread takes the next item until there are none left, this one included.
+		std::atomic<size_t> next(0);
+		auto work = [&next, &task, count]() {
+			for (size_t i = next++; i < count; i = next++)
+				task(i);
+		};
+
+		std::vector<std::thread> pool;
+		for (size_t i = 1; i < num_threads; i++)
+			pool.emplace_back(work);
+
+		work();
+
+		for (size_t i = 0; i < pool.size(); i++)
+			pool[i].join();
+
+	}
+
+	unsigned int MeshConverter::getNumThreads() {
+
+		unsigned int cores = std::thread::hardware_concurrency();
+
+		return std::max(1u, std::min(cores, (unsigned int) MESH_CONVERTER_MAX_THREADS));
+
+	}
+
+}  // namespace bgq_opengl
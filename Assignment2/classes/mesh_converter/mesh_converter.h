@@ -0,0 +1,98 @@
+/**
+ * @file mesh_converter.h
+ * @brief MeshConverter class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MESH_CONVERTER_H_
+#define BGQ_OPENGL_CLASSES_MESH_CONVERTER_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "GL/glew.h"
+#include "assimp/scene.h"
+
+#include "structs/gltf_file/gltf_file.h"
+#include "structs/vertex/vertex.h"
+
+#define MESH_CONVERTER_MAX_THREADS 8     // Maximum number of threads converting meshes at once.
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of the mesh conversion.
+	 *
+	 * Converts Assimp meshes and glTF primitives into vertices and indices one
+	 * attribute array at a time, and spreads the work of several meshes over a pool of threads. Only
+	 * CPU work is done here, GL objects have to be created afterwards on the
+	 * thread that owns the context.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MeshConverter {
+
+		public:
+
+			/**
+			 * @brief Convert a mesh.
+			 *
+			 * Convert the positions, normals, UVs and tangents of a triangulated mesh and
+			 * its diffuse color into vertices, and its faces into indices.
+			 *
+			 * @param scene The scene the mesh belongs to.
+			 * @param mesh The mesh.
+			 * @param vertices Outputs the vertices.
+			 * @param indices Outputs the indices.
+			 */
+			static void convert(const aiScene *scene, const aiMesh *mesh, std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+			/**
+			 * @brief Convert a glTF primitive.
+			 *
+			 * Convert the attributes of a primitive and the base color of its material
+			 * into vertices, turning strips and fans into triangles. Points and lines
+			 * give no indices.
+			 *
+			 * @param file The GLB file the primitive belongs to.
+			 * @param primitive The primitive.
+			 * @param vertices Outputs the vertices.
+			 * @param indices Outputs the indices.
+			 */
+			static void convert(const GltfFile &file, const GltfFile::Primitive &primitive, std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+			/**
+			 * @brief Run a task for several items in parallel.
+			 *
+			 * Run a task once for every item, spread over as many threads as there are
+			 * cores, and wait for all of them. The task must not touch OpenGL.
+			 *
+			 * @param count The number of items.
+			 * @param task The task, given the index of the item.
+			 */
+			static void parallelFor(size_t count, const std::function<void(size_t)> &task);
+
+			/**
+			 * @brief Get the number of threads.
+			 *
+			 * Get the number of threads parallelFor uses at most.
+			 *
+			 * @returns The number of threads.
+			 */
+			static unsigned int getNumThreads();
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_MESH_CONVERTER_H_
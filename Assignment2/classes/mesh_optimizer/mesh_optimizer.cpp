@@ -0,0 +1,641 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @brief MeshOptimizer class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+    namespace {
+
+        // Hash the raw bytes of a vertex (FNV-1a).
+        struct VertexHash {
+
+            size_t operator()(const Vertex &v) const {
+
+                const unsigned char *bytes = (const unsigned char *) &v;
+                size_t hash = 14695981039346656037ull;
+                for (size_t i = 0; i < sizeof(Vertex); i++) {
+                    hash ^= bytes[i];
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+
+            }
+
+        };
+
+        // Compare the raw bytes of two vertices.
+        struct VertexEqual {
+
+            bool operator()(const Vertex &a, const Vertex &b) const {
+
+                return std::memcmp(&a, &b, sizeof(Vertex)) == 0;
+
+            }
+
+        };
+
+        // Hash the position of a vertex.
+        struct PositionHash {
+
+            size_t operator()(const glm::vec3 &p) const {
+
+                const unsigned char *bytes = (const unsigned char *) &p;
+                size_t hash = 14695981039346656037ull;
+                for (size_t i = 0; i < sizeof(glm::vec3); i++) {
+                    hash ^= bytes[i];
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+
+            }
+
+        };
+
+        // Compare two positions.
+        struct PositionEqual {
+
+            bool operator()(const glm::vec3 &a, const glm::vec3 &b) const {
+
+                return a.x == b.x && a.y == b.y && a.z == b.z;
+
+            }
+
+        };
+
+        // A symmetric 4x4 error quadric (Garland and Heckbert).
+        struct Quadric {
+
+            double xx, xy, xz, xw, yy, yz, yw, zz, zw, ww;
+
+            // Add the squared distance to a plane ax + by + cz + d = 0.
+            void addPlane(double a, double b, double c, double d, double weight) {
+
+                xx += weight * a * a; xy += weight * a * b; xz += weight * a * c; xw += weight * a * d;
+                yy += weight * b * b; yz += weight * b * c; yw += weight * b * d;
+                zz += weight * c * c; zw += weight * c * d;
+                ww += weight * d * d;
+
+            }
+
+            void add(const Quadric &q) {
+
+                xx += q.xx; xy += q.xy; xz += q.xz; xw += q.xw;
+                yy += q.yy; yz += q.yz; yw += q.yw;
+                zz += q.zz; zw += q.zw;
+                ww += q.ww;
+
+            }
+
+            // Error of placing a vertex at p.
+            double evaluate(const glm::vec3 &p) const {
+
+                double x = p.x, y = p.y, z = p.z;
+
+                return xx * x * x + 2 * xy * x * y + 2 * xz * x * z + 2 * xw * x
+                    + yy * y * y + 2 * yz * y * z + 2 * yw * y
+                    + zz * z * z + 2 * zw * z
+                    + ww;
+
+            }
+
+        };
+
+        // A candidate collapse of vertex from into vertex to.
+        struct Collapse {
+
+            GLuint from;
+            GLuint to;
+            double error;
+
+        };
+
+        // How different the attributes of two vertices are.
+        float attributeDistance(const Vertex &a, const Vertex &b) {
+
+            glm::vec3 normal = a.normal - b.normal;
+            glm::vec3 color = a.color - b.color;
+            glm::vec2 uv = a.uv - b.uv;
+
+            return glm::dot(normal, normal) + glm::dot(color, color) + glm::dot(uv, uv);
+
+        }
+
+        // Score of a vertex given its position in the LRU cache and its remaining triangles.
+        float vertexScore(int cache_position, unsigned int valence) {
+
+            // Vertices with nothing left to draw are useless.
+            if (valence == 0)
+                return -1.0f;
+
+            float score = 0.0f;
+
+            if (cache_position >= 0) {
+
+                // The last triangle's vertices get a fixed score so that strips are not favoured.
+                if (cache_position < 3) {
+                    score = 0.75f;
+                } else {
+                    float scale = 1.0f / (MESH_OPTIMIZER_CACHE_SIZE - 3);
+                    score = std::pow(1.0f - (cache_position - 3) * scale, 1.5f);
+                }
+
+            }
+
+            // Boost vertices with few triangles left so that lone triangles are not left behind.
+            score += 2.0f * std::pow((float) valence, -0.5f);
+
+            return score;
+
+        }
+
+    }
+
+    MeshOptimizer::Stats MeshOptimizer::optimize(std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+        Stats stats;
+        stats.vertices_before = vertices.size();
+        stats.acmr_before = computeACMR(indices, vertices.size());
+
+        weldVertices(vertices, indices);
+        optimizeVertexCache(indices, vertices.size());
+        optimizeVertexFetch(vertices, indices);
+
+        stats.vertices_after = vertices.size();
+        stats.acmr_after = computeACMR(indices, vertices.size());
+
+        return stats;
+
+    }
+
+    void MeshOptimizer::weldVertices(std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+        std::unordered_map<Vertex, GLuint, VertexHash, VertexEqual> unique;
+        unique.reserve(vertices.size());
+
+        std::vector<GLuint> remap(vertices.size());
+        std::vector<Vertex> welded;
+        welded.reserve(vertices.size());
+
+        // Keep the first copy of every vertex.
+        for (size_t i = 0; i < vertices.size(); i++) {
+
+            auto inserted = unique.emplace(vertices[i], (GLuint) welded.size());
+            if (inserted.second)
+                welded.push_back(vertices[i]);
+
+            remap[i] = inserted.first->second;
+
+        }
+
+        for (size_t i = 0; i < indices.size(); i++)
+            indices[i] = remap[indices[i]];
+
+        vertices.swap(welded);
+
+    }
+
+    void MeshOptimizer::optimizeVertexCache(std::vector<GLuint> &indices, size_t num_vertices) {
+
+        size_t num_triangles = indices.size() / 3;
+        if (num_triangles == 0)
+            return;
+
+        // Count the triangles that use each vertex.
+        std::vector<unsigned int> valence(num_vertices, 0);
+        for (size_t i = 0; i < num_triangles * 3; i++)
+            valence[indices[i]]++;
+
+        // Build the vertex to triangle adjacency.
+        std::vector<unsigned int> adjacency_offset(num_vertices + 1, 0);
+        for (size_t v = 0; v < num_vertices; v++)
+            adjacency_offset[v + 1] = adjacency_offset[v] + valence[v];
+
+        std::vector<unsigned int> adjacency(num_triangles * 3);
+        std::vector<unsigned int> fill(adjacency_offset.begin(), adjacency_offset.end() - 1);
+        for (size_t t = 0; t < num_triangles; t++)
+            for (int k = 0; k < 3; k++)
+                adjacency[fill[indices[t * 3 + k]]++] = (unsigned int) t;
+
+        // Initial vertex scores.
+        std::vector<float> vertex_score(num_vertices);
+        for (size_t v = 0; v < num_vertices; v++)
+            vertex_score[v] = vertexScore(-1, valence[v]);
+
+        std::vector<bool> emitted(num_triangles, false);
+
+        std::vector<GLuint> cache;
+        std::vector<GLuint> new_cache;
+        std::vector<GLuint> result;
+        result.reserve(num_triangles * 3);
+
+        size_t scan = 0;
+        long best = -1;
+
+        for (size_t drawn = 0; drawn < num_triangles; drawn++) {
+
+            // Nothing good in the cache, take the next triangle in input order.
+            if (best < 0) {
+                while (emitted[scan])
+                    scan++;
+                best = (long) scan;
+            }
+
+            // Emit it.
+            const GLuint *tri = &indices[best * 3];
+            result.insert(result.end(), tri, tri + 3);
+            emitted[best] = true;
+
+            // Remove it from the adjacency of its vertices.
+            for (int k = 0; k < 3; k++) {
+
+                GLuint v = tri[k];
+                unsigned int *first = &adjacency[adjacency_offset[v]];
+                for (unsigned int j = 0; j < valence[v]; j++) {
+                    if (first[j] == (unsigned int) best) {
+                        first[j] = first[valence[v] - 1];
+                        break;
+                    }
+                }
+                valence[v]--;
+
+            }
+
+            // Move its vertices to the front of the cache.
+            new_cache.assign(tri, tri + 3);
+            for (GLuint v : cache)
+                if (v != tri[0] && v != tri[1] && v != tri[2])
+                    new_cache.push_back(v);
+
+            // Evicted vertices leave the cache.
+            for (size_t j = MESH_OPTIMIZER_CACHE_SIZE; j < new_cache.size(); j++)
+                vertex_score[new_cache[j]] = vertexScore(-1, valence[new_cache[j]]);
+
+            if (new_cache.size() > MESH_OPTIMIZER_CACHE_SIZE)
+                new_cache.resize(MESH_OPTIMIZER_CACHE_SIZE);
+
+            cache.swap(new_cache);
+
+            // Update the scores of the cached vertices.
+            for (size_t j = 0; j < cache.size(); j++)
+                vertex_score[cache[j]] = vertexScore((int) j, valence[cache[j]]);
+
+            // Update the scores of their triangles and pick the best one.
+            best = -1;
+            float best_score = -1.0f;
+            for (GLuint v : cache) {
+
+                for (unsigned int j = 0; j < valence[v]; j++) {
+
+                    unsigned int t = adjacency[adjacency_offset[v] + j];
+                    float score = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+
+                    if (score > best_score) {
+                        best_score = score;
+                        best = t;
+                    }
+
+                }
+
+            }
+
+        }
+
+        indices.swap(result);
+
+    }
+
+    void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+        const GLuint unused = 0xFFFFFFFF;
+        std::vector<GLuint> remap(vertices.size(), unused);
+        std::vector<Vertex> reordered;
+        reordered.reserve(vertices.size());
+
+        // Number the vertices in order of first use.
+        for (size_t i = 0; i < indices.size(); i++) {
+
+            GLuint &index = indices[i];
+            if (remap[index] == unused) {
+                remap[index] = (GLuint) reordered.size();
+                reordered.push_back(vertices[index]);
+            }
+
+            index = remap[index];
+
+        }
+
+        // Keep the unreferenced ones at the end.
+        for (size_t v = 0; v < vertices.size(); v++)
+            if (remap[v] == unused)
+                reordered.push_back(vertices[v]);
+
+        vertices.swap(reordered);
+
+    }
+
+    float MeshOptimizer::computeACMR(const std::vector<GLuint> &indices, size_t num_vertices) {
+
+        size_t num_triangles = indices.size() / 3;
+        if (num_triangles == 0)
+            return 0.0f;
+
+        // Remember when each vertex entered the FIFO.
+        std::vector<size_t> timestamp(num_vertices, 0);
+        size_t time = MESH_OPTIMIZER_FIFO_SIZE + 1;
+        size_t misses = 0;
+
+        for (size_t i = 0; i < num_triangles * 3; i++) {
+
+            GLuint v = indices[i];
+            if (time - timestamp[v] > MESH_OPTIMIZER_FIFO_SIZE) {
+                timestamp[v] = time++;
+                misses++;
+            }
+
+        }
+
+        return (float) misses / num_triangles;
+
+    }
+
+    std::vector<GLuint> MeshOptimizer::simplify(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, size_t target_index_count, const std::vector<bool> &locked) {
+
+        size_t num_vertices = vertices.size();
+        std::vector<GLuint> result = indices;
+
+        // Vertices that share a position are copies of the same point with other attributes,
+        // so the collapses work on positions and move all of them together.
+        std::unordered_map<glm::vec3, GLuint, PositionHash, PositionEqual> unique;
+        std::vector<GLuint> position_of(num_vertices);
+        std::vector<glm::vec3> points;
+        for (size_t v = 0; v < num_vertices; v++) {
+            auto inserted = unique.emplace(vertices[v].position, (GLuint) points.size());
+            if (inserted.second)
+                points.push_back(vertices[v].position);
+            position_of[v] = inserted.first->second;
+        }
+
+        size_t num_points = points.size();
+
+        // The copies of each position, to pick from when a corner moves there.
+        std::vector<unsigned int> copies_offset(num_points + 1, 0);
+        std::vector<GLuint> copies(num_vertices);
+        for (size_t v = 0; v < num_vertices; v++)
+            copies_offset[position_of[v] + 1]++;
+        for (size_t p = 0; p < num_points; p++)
+            copies_offset[p + 1] += copies_offset[p];
+        std::vector<unsigned int> copies_fill(copies_offset.begin(), copies_offset.end() - 1);
+        for (size_t v = 0; v < num_vertices; v++)
+            copies[copies_fill[position_of[v]]++] = (GLuint) v;
+
+        // Positions that can never move, because one of their copies is locked.
+        std::vector<bool> fixed(num_points, false);
+        for (size_t v = 0; v < locked.size() && v < num_vertices; v++)
+            if (locked[v])
+                fixed[position_of[v]] = true;
+
+        // Edges used by a single triangle are on an open border.
+        std::unordered_map<unsigned long long, int> edge_use;
+        for (size_t i = 0; i + 2 < result.size(); i += 3) {
+            for (int k = 0; k < 3; k++) {
+                unsigned long long a = position_of[result[i + k]], b = position_of[result[i + (k + 1) % 3]];
+                if (a != b)
+                    edge_use[a < b ? (a << 32) | b : (b << 32) | a]++;
+            }
+        }
+        for (auto &edge : edge_use) {
+            if (edge.second == 1) {
+                fixed[edge.first >> 32] = true;
+                fixed[edge.first & 0xFFFFFFFF] = true;
+            }
+        }
+
+        // Accumulate the planes of the triangles around each position, weighted by area.
+        std::vector<Quadric> quadrics(num_points, Quadric{0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+        for (size_t i = 0; i + 2 < result.size(); i += 3) {
+
+            glm::vec3 p0 = vertices[result[i]].position;
+            glm::vec3 p1 = vertices[result[i + 1]].position;
+            glm::vec3 p2 = vertices[result[i + 2]].position;
+
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(normal);
+            if (area <= 0.0f)
+                continue;
+
+            normal /= area;
+            double d = -glm::dot(normal, p0);
+
+            for (int k = 0; k < 3; k++)
+                quadrics[position_of[result[i + k]]].addPlane(normal.x, normal.y, normal.z, d, area);
+
+        }
+
+        std::vector<GLuint> remap(num_points);
+        std::vector<bool> touched(num_points);
+        std::vector<Collapse> collapses;
+        std::vector<unsigned int> adjacency_offset(num_points + 1);
+        std::vector<unsigned int> adjacency;
+        std::vector<unsigned int> fill;
+
+        while (result.size() > target_index_count) {
+
+            // Build the position to triangle adjacency of the current mesh.
+            std::fill(adjacency_offset.begin(), adjacency_offset.end(), 0);
+            for (size_t i = 0; i < result.size(); i++)
+                adjacency_offset[position_of[result[i]] + 1]++;
+            for (size_t p = 0; p < num_points; p++)
+                adjacency_offset[p + 1] += adjacency_offset[p];
+
+            adjacency.resize(result.size());
+            fill.assign(adjacency_offset.begin(), adjacency_offset.end() - 1);
+            for (size_t i = 0; i < result.size(); i++)
+                adjacency[fill[position_of[result[i]]]++] = (unsigned int) (i / 3);
+
+            // Get the cost of every collapse, in the cheapest direction.
+            collapses.clear();
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; k++) {
+
+                    GLuint a = position_of[result[i + k]], b = position_of[result[i + (k + 1) % 3]];
+
+                    // Each inner edge appears twice, keep one.
+                    if (a >= b)
+                        continue;
+
+                    Quadric q = quadrics[a];
+                    q.add(quadrics[b]);
+
+                    // Rounding takes the error of flat regions slightly below zero.
+                    double error_ab = std::max(0.0, q.evaluate(points[b]));
+                    double error_ba = std::max(0.0, q.evaluate(points[a]));
+
+                    if (!fixed[a] && (fixed[b] || error_ab <= error_ba))
+                        collapses.push_back(Collapse{a, b, error_ab});
+                    else if (!fixed[b])
+                        collapses.push_back(Collapse{b, a, error_ba});
+
+                }
+            }
+
+            if (collapses.empty())
+                break;
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse &x, const Collapse &y) { return x.error < y.error; });
+
+            // Apply the cheapest ones, touching each position once per pass.
+            for (size_t p = 0; p < num_points; p++) {
+                remap[p] = (GLuint) p;
+                touched[p] = false;
+            }
+
+            size_t triangles_left = result.size() / 3;
+            size_t target_triangles = target_index_count / 3;
+            size_t applied = 0;
+
+            for (const Collapse &c : collapses) {
+
+                if (triangles_left <= target_triangles)
+                    break;
+
+                if (touched[c.from] || touched[c.to])
+                    continue;
+
+                // Reject the collapse if any remaining triangle around from would flip.
+                bool flips = false;
+                unsigned int shared = 0;
+                for (unsigned int j = adjacency_offset[c.from]; j < adjacency_offset[c.from + 1] && !flips; j++) {
+
+                    GLuint tri[3];
+                    for (int k = 0; k < 3; k++)
+                        tri[k] = position_of[result[adjacency[j] * 3 + k]];
+
+                    if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                        shared++;
+                        continue;
+                    }
+
+                    glm::vec3 p[3], q[3];
+                    for (int k = 0; k < 3; k++) {
+                        p[k] = points[tri[k]];
+                        q[k] = tri[k] == c.from ? points[c.to] : p[k];
+                    }
+
+                    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+                    flips = glm::dot(before, after) <= 0.0f;
+
+                }
+
+                if (flips)
+                    continue;
+
+                remap[c.from] = c.to;
+                quadrics[c.to].add(quadrics[c.from]);
+
+                // Lock the whole neighbourhood so the flip test stays valid this pass.
+                for (unsigned int j = adjacency_offset[c.from]; j < adjacency_offset[c.from + 1]; j++)
+                    for (int k = 0; k < 3; k++)
+                        touched[position_of[result[adjacency[j] * 3 + k]]] = true;
+
+                triangles_left -= shared;
+                applied++;
+
+            }
+
+            if (applied == 0)
+                break;
+
+            // Rewrite the triangles, moving each corner to the copy of its new position
+            // whose attributes are the closest, and drop the degenerate ones.
+            size_t write = 0;
+            for (size_t i = 0; i < result.size(); i += 3) {
+
+                GLuint corner[3];
+                for (int k = 0; k < 3; k++) {
+
+                    GLuint v = result[i + k];
+                    GLuint p = remap[position_of[v]];
+                    corner[k] = v;
+
+                    if (p == position_of[v])
+                        continue;
+
+                    float best = -1.0f;
+                    for (unsigned int j = copies_offset[p]; j < copies_offset[p + 1]; j++) {
+                        float distance = attributeDistance(vertices[v], vertices[copies[j]]);
+                        if (best < 0.0f || distance < best) {
+                            best = distance;
+                            corner[k] = copies[j];
+                        }
+                    }
+
+                }
+
+                if (position_of[corner[0]] == position_of[corner[1]] || position_of[corner[1]] == position_of[corner[2]] || position_of[corner[0]] == position_of[corner[2]])
+                    continue;
+
+                result[write++] = corner[0];
+                result[write++] = corner[1];
+                result[write++] = corner[2];
+
+            }
+            result.resize(write);
+
+        }
+
+        return result;
+
+    }
+
+    std::vector<std::vector<GLuint>> MeshOptimizer::buildLODs(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<bool> &locked) {
+
+        std::vector<std::vector<GLuint>> levels;
+        const std::vector<GLuint> *previous = &indices;
+
+        for (int level = 1; level < MESH_OPTIMIZER_LOD_LEVELS; level++) {
+
+            // Aim for half the triangles of the previous level.
+            size_t target = (previous->size() / 6) * 3;
+            std::vector<GLuint> lod = simplify(vertices, *previous, target, locked);
+
+            // Not worth another level if it barely shrank.
+            if (lod.empty() || lod.size() * 10 > previous->size() * 9)
+                break;
+
+            optimizeVertexCache(lod, vertices.size());
+            levels.push_back(lod);
+            previous = &levels.back();
+
+        }
+
+        return levels;
+
+    }
+
+}  // namespace bgq_opengl
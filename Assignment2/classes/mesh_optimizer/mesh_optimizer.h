@@ -0,0 +1,153 @@
+/**
+ * @file mesh_optimizer.h
+ * @brief MeshOptimizer class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MESH_OPTIMIZER_H_
+#define BGQ_OPENGL_CLASSES_MESH_OPTIMIZER_H_
+
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/vertex/vertex.h"
+
+#define MESH_OPTIMIZER_CACHE_SIZE 32    // Size of the LRU cache the triangle order targets.
+#define MESH_OPTIMIZER_FIFO_SIZE 16     // Size of the FIFO cache used to measure the ACMR.
+#define MESH_OPTIMIZER_LOD_LEVELS 4     // Maximum number of levels of detail, the full mesh included.
+
+namespace bgq_opengl {
+
+    /**
+     * @brief Implementation of a mesh optimizer.
+     *
+     * Implements the load-time passes that make a triangle mesh cheaper to draw:
+     * vertex welding, triangle reordering for the post-transform vertex cache
+     * (Forsyth's linear-speed algorithm) and vertex reordering for fetch locality,
+     * plus quadric edge-collapse simplification to build levels of detail.
+     *
+     * @author Borja García Quiroga <garcaqub@tcd.ie>
+     */
+    class MeshOptimizer {
+
+        public:
+
+            /**
+             * @brief The result of an optimization.
+             *
+             * The sizes and average cache miss ratios before and after optimizing.
+             */
+            struct Stats {
+
+                size_t vertices_before;     /// Number of vertices before welding.
+                size_t vertices_after;      /// Number of vertices after welding.
+                float acmr_before;          /// Average cache miss ratio before.
+                float acmr_after;           /// Average cache miss ratio after.
+
+            };
+
+            /**
+             * @brief Run all the passes on a mesh.
+             *
+             * Welds, reorders triangles and reorders vertices in place.
+             *
+             * @param vertices The vertices of the mesh.
+             * @param indices The triangle indices of the mesh.
+             *
+             * @returns The stats of the optimization.
+             */
+            static Stats optimize(std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+            /**
+             * @brief Merge identical vertices.
+             *
+             * Merge the vertices whose attributes are bit-identical and remap the indices.
+             *
+             * @param vertices The vertices of the mesh.
+             * @param indices The triangle indices of the mesh.
+             */
+            static void weldVertices(std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+            /**
+             * @brief Reorder the triangles for the vertex cache.
+             *
+             * Reorder the triangles so that consecutive ones share as many vertices as
+             * possible.
+             *
+             * @param indices The triangle indices of the mesh.
+             * @param num_vertices The number of vertices of the mesh.
+             */
+            static void optimizeVertexCache(std::vector<GLuint> &indices, size_t num_vertices);
+
+            /**
+             * @brief Reorder the vertices for fetch locality.
+             *
+             * Reorder the vertices in the order they are first used by the indices.
+             * Unused vertices are kept at the end so the bounds do not change.
+             *
+             * @param vertices The vertices of the mesh.
+             * @param indices The triangle indices of the mesh.
+             */
+            static void optimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+            /**
+             * @brief Compute the average cache miss ratio.
+             *
+             * Compute the number of vertex shader invocations per triangle with a FIFO
+             * post-transform cache.
+             *
+             * @param indices The triangle indices of the mesh.
+             * @param num_vertices The number of vertices of the mesh.
+             *
+             * @returns The ACMR, between 0.5 and 3.
+             */
+            static float computeACMR(const std::vector<GLuint> &indices, size_t num_vertices);
+
+            /**
+             * @brief Simplify a mesh.
+             *
+             * Collapse the edges with the lowest quadric error until the target is reached
+             * or no edge can be collapsed. The vertices are not modified, only the indices,
+             * so every level can share the same vertex buffer. Vertices on the same position
+             * collapse together, each corner taking the copy of its new position with the
+             * closest attributes, so flat shaded meshes and seams simplify too. Locked
+             * vertices and open borders never move.
+             *
+             * @param vertices The vertices of the mesh.
+             * @param indices The triangle indices of the mesh.
+             * @param target_index_count The number of indices to reach.
+             * @param locked Which vertices must not be collapsed, or empty for none.
+             *
+             * @returns The indices of the simplified mesh.
+             */
+            static std::vector<GLuint> simplify(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, size_t target_index_count, const std::vector<bool> &locked);
+
+            /**
+             * @brief Build the levels of detail of a mesh.
+             *
+             * Build up to MESH_OPTIMIZER_LOD_LEVELS - 1 simplified levels, halving the
+             * triangles each time, and stopping when a level barely shrinks.
+             *
+             * @param vertices The vertices of the mesh.
+             * @param indices The triangle indices of the full mesh.
+             * @param locked Which vertices must not be collapsed, or empty for none.
+             *
+             * @returns The indices of each simplified level, the full mesh excluded.
+             */
+            static std::vector<std::vector<GLuint>> buildLODs(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<bool> &locked);
+
+    };
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_MESH_OPTIMIZER_H_
@@ -15,31 +15,47 @@
 
 #include "node.h"
 
+#include <cassert>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "GL/glew.h"
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
 #include "glm/gtc/type_ptr.hpp"
 #include "glm/gtx/string_cast.hpp"
 
 #include "classes/camera/camera.h"
 #include "classes/ebo/ebo.h"
+#include "classes/matrix_stream/matrix_stream.h"
+#include "classes/render_stats/render_stats.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
 #include "classes/vao/vao.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
 #include "structs/control_point/control_point.h"
+#include "structs/frustum/frustum.h"
+#include "structs/joint_pose/joint_pose.h"
 
 namespace bgq_opengl {
 
-    Node::Node(const int id, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const std::vector<Node> &children) : geometry(vertices, indices, textures, 1.0) {
+    Node::Node(const int id, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, std::vector<Node> &&children, const VertexLayout &layout, const std::vector<std::vector<GLuint>> &lods) : geometry(vertices, indices, textures, 1.0, layout, lods) {
         
-        this->children = children;
+        this->node_id = id;
+        this->children = std::move(children);
+        
+    }
+
+    Node::Node(const int id, Geometry &&geometry, std::vector<Node> &&children) : geometry(std::move(geometry)) {
+        
+        this->node_id = id;
+        this->children = std::move(children);
         
     }
 
@@ -49,6 +65,40 @@ namespace bgq_opengl {
         
     }
 
+    std::vector<glm::vec3> Node::getControl() {
+        
+        return this->control;
+        
+    }
+
+    void Node::setControlPoints(const glm::vec3 &anchor, const std::vector<glm::vec3> &control) {
+        
+        this->anchor = anchor;
+        this->control = control;
+        this->anchor_original = this->anchor;
+        this->control_original = this->control;
+        this->rest_anchor = this->anchor;
+        this->rest_control = this->control;
+        
+    }
+
+    Node *Node::find(const int id) {
+        
+        if (this->node_id == id)
+            return this;
+        
+        for (int i = 0; i < this->children.size(); i++) {
+            
+            Node *found = this->children[i].find(id);
+            if (found)
+                return found;
+            
+        }
+        
+        return 0;
+        
+    }
+
     std::vector<ControlPoint> Node::getControlPoints() {
         
         // Get the values for this node itself.
@@ -193,6 +243,8 @@ namespace bgq_opengl {
         
         this->anchor_original = this->anchor;
         this->control_original = this->control;
+        this->rest_anchor = this->anchor;
+        this->rest_control = this->control;
 
     }
 
@@ -258,10 +310,12 @@ namespace bgq_opengl {
         
         this->anchor_original = this->anchor;
         this->control_original = this->control;
+        this->rest_anchor = this->anchor;
+        this->rest_control = this->control;
         
     }
 
-    Geometry Node::getGeometry() {
+    Geometry &Node::getGeometry() {
         
         return this->geometry;
         
@@ -300,6 +354,47 @@ namespace bgq_opengl {
 
         return global_bb;
 
+    }
+
+    bool Node::getWorldBoundingBox(BoundingBox &bb) {
+
+        bool found = false;
+
+        // Start with this geometry.
+        if (!this->geometry.isEmpty()) {
+            bb = this->geometry.getWorldBoundingBox();
+            found = true;
+        }
+
+        // Add the children.
+        for (int i = 0; i < this->children.size(); i++) {
+
+            BoundingBox child_bb;
+            if (!this->children[i].getWorldBoundingBox(child_bb))
+                continue;
+
+            if (found)
+                bb.merge(child_bb);
+            else
+                bb = child_bb;
+
+            found = true;
+
+        }
+
+        return found;
+
+    }
+
+    unsigned int Node::getNumSegments() {
+
+        unsigned int count = this->geometry.isEmpty() ? 0 : 1;
+
+        for (int i = 0; i < this->children.size(); i++)
+            count += this->children[i].getNumSegments();
+
+        return count;
+
     }
 
 	void Node::draw(Shader &shader, Camera &camera) {
@@ -312,6 +407,165 @@ namespace bgq_opengl {
 
 	}
 
+    void Node::assignMatrixSlots(GLsizei &next) {
+        
+        this->matrix_slot = next++;
+        
+        for (int i = 0; i < this->children.size(); i++)
+            this->children[i].assignMatrixSlots(next);
+        
+    }
+
+    void Node::capturePose(Pose &pose) {
+        
+        pose.matrices[this->matrix_slot] = this->geometry.getTransformMat();
+        pose.kinds[this->matrix_slot] = this->geometry.getTransformKind();
+        pose.versions[this->matrix_slot] = this->geometry.getTransformVersion();
+        
+        for (int i = 0; i < this->children.size(); i++)
+            this->children[i].capturePose(pose);
+        
+    }
+
+    void Node::applyJointPose(const JointPose &pose, const glm::mat4 &parent) {
+        
+        GLsizei slot = this->matrix_slot;
+        
+        // Rotate about the rest anchor, then translate, on top of the parent.
+        glm::mat4 local = glm::translate(glm::mat4(1.0f), this->rest_anchor) * glm::mat4_cast(pose.getRotation(slot));
+        local = glm::translate(local, pose.getTranslation(slot) - this->rest_anchor);
+        glm::mat4 world = parent * local;
+        
+        // Only a new transform gets a new version, so still joints are not uploaded again.
+        if (world != this->geometry.getTransformMat())
+            this->geometry.setTransformMat(world);
+        
+        this->anchor = glm::vec3(world * glm::vec4(this->rest_anchor, 1.0f));
+        this->control.resize(this->rest_control.size());
+        for (size_t i = 0; i < this->rest_control.size(); i++)
+            this->control[i] = glm::vec3(world * glm::vec4(this->rest_control[i], 1.0f));
+        
+        for (size_t i = 0; i < this->children.size(); i++)
+            this->children[i].applyJointPose(pose, world);
+        
+    }
+
+    void Node::captureJointPose(JointPose &pose, const glm::mat4 &parent) {
+        
+        glm::mat4 world = this->geometry.getTransformMat();
+        glm::mat4 local = glm::inverse(parent) * world;
+        
+        // The local transform is T(anchor) R T(translation - anchor), so its last column is anchor + R (translation - anchor).
+        glm::quat rotation = glm::normalize(glm::quat_cast(glm::mat3(local)));
+        glm::vec3 translation = glm::transpose(glm::mat3_cast(rotation)) * (glm::vec3(local[3]) - this->rest_anchor) + this->rest_anchor;
+        pose.set(this->matrix_slot, rotation, translation);
+        
+        for (size_t i = 0; i < this->children.size(); i++)
+            this->children[i].captureJointPose(pose, world);
+        
+    }
+
+    void Node::getRestJoints(int parent, std::vector<int> &parents, std::vector<glm::vec3> &anchors, std::vector<std::vector<glm::vec3>> &controls) {
+        
+        parents[this->matrix_slot] = parent;
+        anchors[this->matrix_slot] = this->rest_anchor;
+        controls[this->matrix_slot] = this->rest_control;
+        
+        for (size_t i = 0; i < this->children.size(); i++)
+            this->children[i].getRestJoints(this->matrix_slot, parents, anchors, controls);
+        
+    }
+
+    bool Node::getWorldBoundingBox(BoundingBox &bb, const Pose &pose) {
+
+        bool found = false;
+
+        // Start with this geometry.
+        if (!this->geometry.isEmpty()) {
+            bb = this->geometry.getWorldBoundingBox(pose.matrices[this->matrix_slot]);
+            found = true;
+        }
+
+        // Add the children.
+        for (int i = 0; i < this->children.size(); i++) {
+
+            BoundingBox child_bb;
+            if (!this->children[i].getWorldBoundingBox(child_bb, pose))
+                continue;
+
+            if (found)
+                bb.merge(child_bb);
+            else
+                bb = child_bb;
+
+            found = true;
+
+        }
+
+        return found;
+
+    }
+
+    void Node::writeMatrices(MatrixStream &stream, const Pose &pose) {
+        
+        GLsizei slot = this->matrix_slot;
+        if (!this->geometry.isEmpty())
+            stream.write(slot, pose.versions[slot], pose.matrices[slot], pose.kinds[slot]);
+        
+        for (int i = 0; i < this->children.size(); i++)
+            this->children[i].writeMatrices(stream, pose);
+        
+    }
+
+	void Node::draw(Shader &shader, Camera &camera, const Frustum &frustum, const MatrixStream &stream, const Pose &pose) {
+        
+        // Draw this segment only if it can be seen.
+        if (!this->geometry.isEmpty()) {
+            
+            BoundingBox bb = this->geometry.getWorldBoundingBox(pose.matrices[this->matrix_slot]);
+            
+            if (frustum.intersects(bb)) {
+                this->geometry.setLOD(this->chooseLOD(bb, camera));
+                this->geometry.draw(shader, camera, stream.getIndex(this->matrix_slot));
+                RenderStats::addDrawn(1);
+            } else {
+                RenderStats::addCulled(1);
+            }
+            
+        }
+        
+        // Do the same for its children.
+        for (int i = 0; i < this->children.size(); i++)
+            this->children[i].draw(shader, camera, frustum, stream, pose);
+
+	}
+
+    int Node::chooseLOD(const BoundingBox &bb, Camera &camera) {
+        
+        // Get the bounding sphere of the box.
+        glm::vec3 centre = (bb.min + bb.max) / 2.0f;
+        float radius = glm::length(bb.max - bb.min) / 2.0f;
+        
+        // The camera is inside the sphere.
+        float depth = -(camera.getView() * glm::vec4(centre, 1.0f)).z;
+        if (depth <= radius)
+            return 0;
+        
+        // Fraction of the screen height that the sphere covers.
+        float size = radius * camera.getProjection()[1][1] / depth;
+        
+        // Go one level down every time it halves.
+        int level = 0;
+        float threshold = NODE_LOD_SCREEN_SIZE;
+        while (level + 1 < this->geometry.getNumLODs() && size < threshold) {
+            level++;
+            threshold /= 2.0f;
+        }
+        
+        return level;
+        
+    }
+
 	void Node::resetTransforms() {
 
         geometry.resetTransforms();
@@ -25,14 +25,21 @@
 
 #include "classes/camera/camera.h"
 #include "classes/geometry/geometry.h"
+#include "classes/matrix_stream/matrix_stream.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
 #include "classes/ebo/ebo.h"
 #include "classes/vbo/vbo.h"
 #include "classes/vao/vao.h"
 #include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
 #include "structs/bounding_box/bounding_box.h"
 #include "structs/control_point/control_point.h"
+#include "structs/frustum/frustum.h"
+#include "structs/joint_pose/joint_pose.h"
+#include "structs/pose/pose.h"
+
+#define NODE_LOD_SCREEN_SIZE 0.25f      // Fraction of the screen height under which the first simplified level is used.
 
 namespace bgq_opengl {
 
@@ -56,8 +63,22 @@ namespace bgq_opengl {
 			 * @param vertices Vertices of the object.
 			 * @param indices Indices of the vertices.
 			 * @param textures Textures in connection with this geometry.
+			 * @param children The children nodes, which the node takes.
+			 * @param layout The layout used to store the vertices on the GPU.
+			 * @param lods Indices of the simplified levels, from the finest to the coarsest.
+			 */
+			Node(const int id, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, std::vector<Node> &&children, const VertexLayout &layout, const std::vector<std::vector<GLuint>> &lods);
+
+			/**
+			 * @brief Initializes the node with a built geometry.
+			 *
+			 * Initializes the node around a geometry that is already on the GPU.
+			 *
+			 * @param id The id of the node.
+			 * @param geometry The geometry, which the node takes.
+			 * @param children The children nodes, which the node takes.
 			 */
-			Node(const int id, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const std::vector<Node> &children);
+			Node(const int id, Geometry &&geometry, std::vector<Node> &&children);
         
             /**
              * @brief Get the anchor point of this node.
@@ -65,6 +86,37 @@ namespace bgq_opengl {
              * Get the anchor point of this node.
              */
             glm::vec3 getAnchor();
+
+            /**
+             * @brief Get the control points of this node.
+             *
+             * Get the control points of this node alone, without the ones of its children.
+             *
+             * @returns The control points.
+             */
+            std::vector<glm::vec3> getControl();
+
+            /**
+             * @brief Set the anchor and control points.
+             *
+             * Set the anchor and control points of this node alone, as
+             * calculateControlPoints would, for nodes whose points were computed before.
+             *
+             * @param anchor The anchor point.
+             * @param control The control points.
+             */
+            void setControlPoints(const glm::vec3 &anchor, const std::vector<glm::vec3> &control);
+
+            /**
+             * @brief Find a node.
+             *
+             * Find a node by its id among this one and its descendants.
+             *
+             * @param id The id of the node.
+             *
+             * @returns The node, or 0 if there is none.
+             */
+            Node *find(const int id);
         
             /**
              * @brief Get the control points for this object.
@@ -118,15 +170,114 @@ namespace bgq_opengl {
              * @returns The bounding box struct.
              */
             BoundingBox getBoundingBox();
+
+            /**
+             * @brief Gets the world bounding box.
+             *
+             * Gets the bounding box of the node and its children after their transforms.
+             *
+             * @param bb The box where the result will be stored.
+             *
+             * @returns False if there is nothing to draw in this subtree.
+             */
+            bool getWorldBoundingBox(BoundingBox &bb);
+
+            /**
+             * @brief Gets the number of segments.
+             *
+             * Gets the number of drawable geometries of the node and its children.
+             *
+             * @returns The number of segments.
+             */
+            unsigned int getNumSegments();
+
+            /**
+             * @brief Assigns the matrix slots.
+             *
+             * Gives the node and its children consecutive slots in a MatrixStream.
+             *
+             * @param next The next free slot, which is advanced.
+             */
+            void assignMatrixSlots(GLsizei &next);
+
+            /**
+             * @brief Captures the pose.
+             *
+             * Copies the transforms of the node and its children into a pose, at their
+             * matrix slots.
+             *
+             * @param pose The pose, already sized for every slot.
+             */
+            void capturePose(Pose &pose);
+
+            /**
+             * @brief Places the node in a joint pose.
+             *
+             * Sets the transforms of the node and its children from their local joint
+             * transforms, indexed by matrix slot, starting over from the rest pose.
+             * The anchors and control points follow.
+             *
+             * @param pose The joint pose, sized for every slot.
+             * @param parent The world transform of the parent.
+             */
+            void applyJointPose(const JointPose &pose, const glm::mat4 &parent);
+
+            /**
+             * @brief Captures the joint pose.
+             *
+             * Recovers the local joint transforms of the node and its children from
+             * their current transforms, at their matrix slots.
+             *
+             * @param pose The joint pose, already sized for every slot.
+             * @param parent The world transform of the parent.
+             */
+            void captureJointPose(JointPose &pose, const glm::mat4 &parent);
+
+            /**
+             * @brief Gets the rest joints.
+             *
+             * Writes the parent, rest anchor and rest control points of the node and
+             * its children at their matrix slots.
+             *
+             * @param parent The slot of the parent, or -1.
+             * @param parents Outputs the parent of each joint, already sized.
+             * @param anchors Outputs the rest anchor of each joint, already sized.
+             * @param controls Outputs the rest control points of each joint, already sized.
+             */
+            void getRestJoints(int parent, std::vector<int> &parents, std::vector<glm::vec3> &anchors, std::vector<std::vector<glm::vec3>> &controls);
+
+            /**
+             * @brief Gets the world bounding box in a pose.
+             *
+             * Gets the box that contains every geometry of the node and its children
+             * when they are placed as in a pose.
+             *
+             * @param bb Where the box is stored.
+             * @param pose The pose.
+             *
+             * @returns Whether there was any geometry.
+             */
+            bool getWorldBoundingBox(BoundingBox &bb, const Pose &pose);
+
+            /**
+             * @brief Writes the matrices.
+             *
+             * Writes the matrices of the node and its children in a pose to a
+             * MatrixStream. Only the ones that changed are actually uploaded.
+             *
+             * @param stream The stream being written.
+             * @param pose The pose.
+             */
+            void writeMatrices(MatrixStream &stream, const Pose &pose);
         
             /**
              * @brief Gets the geometry.
              *
-             * Gets the geometry.
+             * Gets the geometry, which stays owned by the node.
              *
              * @returns The geometry.
              */
-            Geometry getGeometry();
+            Geometry &getGeometry();
 
 			/**
 			 * @brief Draws the Geometry.
@@ -135,6 +286,19 @@ namespace bgq_opengl {
 			 */
 			void draw(Shader &shader, Camera &camera);
 
+			/**
+			 * @brief Draws the visible Geometry.
+			 *
+			 * Displays the Geometry of this node and its children that is inside the frustum,
+			 * each at the level of detail that matches its size on screen, placed as in a
+			 * pose whose matrices were written to a stream.
+			 *
+			 * @param frustum The camera frustum.
+			 * @param stream The stream holding the matrices of this frame.
+			 * @param pose The pose.
+			 */
+			void draw(Shader &shader, Camera &camera, const Frustum &frustum, const MatrixStream &stream, const Pose &pose);
+
 			/**
 			 * @brief Reset
 			 *
@@ -265,7 +429,21 @@ namespace bgq_opengl {
 			 */
 			void updateNormalMatrix();
 
+            /**
+             * @brief Choose the level of detail.
+             *
+             * Choose the level of detail from the fraction of the screen height covered
+             * by the bounding sphere of a box, halving the threshold every level.
+             *
+             * @param bb The world bounding box of the geometry.
+             * @param camera The camera.
+             *
+             * @returns The level.
+             */
+            int chooseLOD(const BoundingBox &bb, Camera &camera);
+
             int node_id;                                    /// The id representing this node.
+            GLsizei matrix_slot = 0;                        /// The slot of the node in the matrix stream.
             Geometry geometry;                              /// The geometry corresponding to the node.
             std::vector<Node> children;                     /// The children nodes.
 			glm::mat4 transforms = glm::mat4(1.0f);		    /// Tranform matrixes that will be passed to the shader.
@@ -273,6 +451,8 @@ namespace bgq_opengl {
             glm::vec3 anchor_original = glm::vec3(0.0f);    /// The original anchor point of the node.
             std::vector<glm::vec3> control;                 /// The control points of this node.
             std::vector<glm::vec3> control_original;        /// The original ontrol points of this node.
+            glm::vec3 rest_anchor = glm::vec3(0.0f);        /// The anchor point in the rest pose.
+            std::vector<glm::vec3> rest_control;            /// The control points in the rest pose.
 
 	};
 
@@ -16,12 +16,17 @@
 #include "object.h"
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <utility>
 
 #include "classes/loader/loader.h"
 #include "classes/loader_assimp/loader_assimp.h"
+#include "classes/loader_glb/loader_glb.h"
+#include "classes/render_stats/render_stats.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/frustum/frustum.h"
 
 namespace bgq_opengl {
 
@@ -37,6 +42,12 @@ namespace bgq_opengl {
 
             model_loader = new LoaderAssimp(filename);
 
+        } else if (strcmp(filetype, "GLB") == 0) {
+
+            std::cerr << "glb" << std::endl;
+
+            model_loader = new LoaderGLB(filename);
+
         } else {
 
 			assert(false);
@@ -47,16 +58,20 @@ namespace bgq_opengl {
         (*model_loader).loadModel();
 
 		(*model_loader).getGeometries(&this->geoms, &this->matrices_geoms);
+		delete model_loader;
+
+		// Start each geometry with the transform its loader gave it, if any.
+		this->resetTransforms();
 
 	}
 
 	Object::Object(std::vector<Geometry> geometries) {
 
-		// Copy the geometries.
-		this->geoms = geometries;
+		// Take the geometries, they cannot be copied.
+		this->geoms = std::move(geometries);
 
 		// Get an identity matrix for each.
-		this->matrices_geoms = std::vector<glm::mat4>(geometries.size(), glm::mat4(1.0f));
+		this->matrices_geoms = std::vector<glm::mat4>(this->geoms.size(), glm::mat4(1.0f));
 
 	}
 
@@ -81,14 +96,43 @@ namespace bgq_opengl {
 
 	void Object::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera) {
         
-		// Go over all meshes and draw each one
+		// Get the frustum of the camera.
+		Frustum frustum = Frustum::fromMatrix(camera.getCameraMatrix());
+
+		// Go over all meshes and draw each visible one
 		for (unsigned int i = 0; i < this->geoms.size(); i++)
 		{
+			if (geoms[i].isEmpty())
+				continue;
+
+			if (!frustum.intersects(geoms[i].getWorldBoundingBox())) {
+				RenderStats::addCulled(1);
+				continue;
+			}
+
 			geoms[i].draw(shader, camera);
+			RenderStats::addDrawn(1);
 		}
         
 	}
 
+	void Object::drawInstanced(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera, GLsizei count) {
+
+		// Go over all meshes and draw all the instances of each one.
+		for (unsigned int i = 0; i < this->geoms.size(); i++)
+		{
+			geoms[i].drawInstanced(shader, camera, count);
+		}
+
+	}
+
+	void Object::linkInstanceAttribute(VBO &vbo, GLuint location, GLsizei stride, GLuint offset) {
+
+		for (size_t i = 0; i < this->geoms.size(); i++)
+			this->geoms[i].linkInstanceAttribute(vbo, location, stride, offset);
+
+	}
+
 	BoundingBox Object::getBoundingBox() {
 
 		// Create the bb.
@@ -124,7 +168,7 @@ namespace bgq_opengl {
 
 	}
 
-	std::vector<Geometry> Object::getGeometries() {
+	std::vector<Geometry> &Object::getGeometries() {
 
 		return this->geoms;
 
@@ -164,11 +208,14 @@ namespace bgq_opengl {
 
 	void Object::resetTransforms() {
 
-		// Do the same for the subobjects.
+		// Do the same for the subobjects, back to the transforms they were loaded with.
 		for (size_t i = 0; i < geoms.size(); i++) {
 
 			geoms[i].resetTransforms();
 
+			if (i < this->matrices_geoms.size())
+				geoms[i].setTransformMat(this->matrices_geoms[i]);
+
 		}
 
 	}
@@ -40,7 +40,7 @@ namespace bgq_opengl {
 			/**
 			 * @brief Loads the object from specified geometries.
 			 * 
-			 * Loads the object from specified geometries.
+			 * Loads the object from specified geometries, which the object takes.
 			 * 
 			 * @param geometries The geometries that will be part of the object.
 			 */
@@ -74,6 +74,27 @@ namespace bgq_opengl {
 			 */
 			void draw(Shader &shader, Camera &camera);
 
+			/**
+			 * @brief Draws several instances of this object.
+			 *
+			 * Draws several instances of this object with one call per geometry.
+			 *
+			 * @param count The number of instances.
+			 */
+			void drawInstanced(Shader &shader, Camera &camera, GLsizei count);
+
+			/**
+			 * @brief Links a per instance attribute.
+			 *
+			 * Links a vec4 float attribute of an instance buffer to all the geometries.
+			 *
+			 * @param vbo The instance buffer.
+			 * @param location The layout location in the shader.
+			 * @param stride The size in bytes of an instance.
+			 * @param offset The offset in bytes of the attribute.
+			 */
+			void linkInstanceAttribute(VBO &vbo, GLuint location, GLsizei stride, GLuint offset);
+
 			/**
 			 * @brief Gets the bounding box.
 			 *
@@ -86,9 +107,9 @@ namespace bgq_opengl {
 			/**
 			 * @brief Get the geometries of the object.
 			 * 
-			 * Get the geometries of the object.
+			 * Get the geometries of the object, which stay owned by it.
 			 */
-			std::vector<Geometry> getGeometries();
+			std::vector<Geometry> &getGeometries();
 
 			/**
 			 * @brief Get the matrices of the geometries.
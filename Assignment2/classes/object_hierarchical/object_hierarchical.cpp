@@ -15,9 +15,15 @@
 
 #include "object_hierarchical.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <utility>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/glm.hpp"
@@ -27,51 +33,342 @@
 #include "assimp/postprocess.h"
 
 #include "classes/loader/loader.h"
+#include "classes/mapped_file/mapped_file.h"
+#include "classes/matrix_stream/matrix_stream.h"
+#include "classes/mesh_converter/mesh_converter.h"
 #include "classes/node/node.h"
+#include "classes/render_stats/render_stats.h"
+#include "classes/mesh_optimizer/mesh_optimizer.h"
+#include "classes/rig_cache/rig_cache.h"
 #include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
 #include "structs/bounding_box/bounding_box.h"
 #include "structs/control_point/control_point.h"
+#include "structs/frustum/frustum.h"
+#include "structs/gltf_file/gltf_file.h"
+#include "structs/joint_pose/joint_pose.h"
 
 namespace bgq_opengl {
 
-ObjectHierarchical::ObjectHierarchical(const char *filename, const std::vector<int> &indexes, const std::vector<int> &parents, const char* first, const char* middle, const char* end) : root(0, {}, {}, {}, {}) {
+    namespace {
 
-        // Import the scene from the file.
-        const aiScene* scene = aiImportFile(filename, aiProcess_Triangulate | aiProcess_PreTransformVertices);
+        // Get the bounding box of the positions of an assimp mesh.
+        BoundingBox meshBounds(const aiMesh* mesh) {
+
+            BoundingBox bb{glm::vec3(0.0f), glm::vec3(0.0f)};
+
+            for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
+
+                glm::vec3 p(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+
+                if (i == 0)
+                    bb = BoundingBox{p, p};
+                else
+                    bb.merge(BoundingBox{p, p});
+
+            }
+
+            return bb;
 
-        // Check if the scene was not read correctly.
-        if (!scene) {
-            
-            std::cerr << "Could not read mesh on file " << filename << std::endl;
-            exit(1);
-            
         }
 
-        // Print info from the scene.
-        std::cerr << "  " << filename << std::endl;
-        std::cerr << "  " << scene->mNumMaterials << " materials" << std::endl;
-        std::cerr << "  " << scene->mNumMeshes << " meshes" << std::endl;
-        std::cerr << "  " << scene->mNumTextures << " textures" << std::endl;
-        
-        // Load this node.
-        this->root = loadNode(scene, 0, indexes, parents);
-    
-        // Load the control points.
+        // A node still to visit in the pass over the glTF tree.
+        struct TreeStep {
+
+            int node;           // The node.
+            int parent_node;    // Its parent node, or -1.
+            int parent_joint;   // The joint it hangs from, or -1.
+
+        };
+
+        // A converted primitive whose triangles are still to be handed to the joints.
+        struct RigPart {
+
+            int node = -1;                  // The node holding it.
+            int primitive = -1;             // Its index in the mesh.
+            std::vector<Vertex> vertices;   // Its vertices, in world space.
+            std::vector<GLuint> indices;    // Its indices.
+            std::vector<int> joints;        // The joint of each triangle.
+
+        };
+
+        // Move a range of vertices by a transform.
+        void transformVertices(std::vector<Vertex> &vertices, size_t first, size_t last, const glm::mat4 &matrix) {
+
+            glm::mat3 linear(matrix);
+            glm::mat3 normal = glm::transpose(glm::inverse(linear));
+
+            for (size_t i = first; i < last; i++) {
+
+                Vertex &v = vertices[i];
+                v.position = glm::vec3(matrix * glm::vec4(v.position, 1.0f));
+                v.normal = glm::normalize(normal * v.normal);
+                v.tangent = glm::normalize(linear * v.tangent);
+                v.bitangent = glm::normalize(linear * v.bitangent);
+
+            }
+
+        }
+
+        // Keep the triangles facing out after a mirroring transform.
+        void flipTriangles(std::vector<GLuint> &indices) {
+
+            for (size_t i = 0; i + 2 < indices.size(); i += 3)
+                std::swap(indices[i + 1], indices[i + 2]);
+
+        }
+
+        // Get where a ray from a point through the centre of a box leaves it.
+        glm::vec3 exitPoint(const BoundingBox &bb, const glm::vec3 &from) {
+
+            glm::vec3 centre = (bb.min + bb.max) / 2.0f;
+            glm::vec3 direction = centre - from;
+
+            float t = INFINITY;
+            for (int i = 0; i < 3; i++)
+                if (std::fabs(direction[i]) > 1e-6f)
+                    t = std::min(t, ((direction[i] > 0.0f ? bb.max[i] : bb.min[i]) - centre[i]) / direction[i]);
+
+            return std::isinf(t) ? centre : centre + direction * t;
+
+        }
+
+    }
+
+ObjectHierarchical::ObjectHierarchical(const char *filename, const std::vector<int> &indexes, const std::vector<int> &parents, const char* first, const char* middle, const char* end) : root(0, {}, {}, {}, {}, VertexLayout::full(), {}) {
+
         this->first = strdup(first);
         this->middle = strdup(middle);
         this->end = strdup(end);
-        this->root.calculateControlPoints(first, middle, end);
 
-        aiReleaseImport(scene);
+        // Use the rig as it was left by a previous run if the model and parameters did not change.
+        unsigned long long key = RigCache::getKey(filename, indexes, parents, first, middle, end);
+
+        this->load(filename, key, [&](std::vector<int> &rig_parents, std::vector<PreparedMesh> &meshes) {
+
+            // Import the scene from the file.
+            const aiScene* scene = aiImportFile(filename, aiProcess_Triangulate | aiProcess_PreTransformVertices);
+
+            // Check if the scene was not read correctly.
+            if (!scene) {
+                
+                std::cerr << "Could not read mesh on file " << filename << std::endl;
+                exit(1);
+                
+            }
+
+            // Print info from the scene.
+            std::cerr << "  " << filename << std::endl;
+            std::cerr << "  " << scene->mNumMaterials << " materials" << std::endl;
+            std::cerr << "  " << scene->mNumMeshes << " meshes" << std::endl;
+            std::cerr << "  " << scene->mNumTextures << " textures" << std::endl;
+            
+            // Convert every mesh at once, then create their GL objects here.
+            meshes.resize(parents.size());
+            MeshConverter::parallelFor(meshes.size(), [&](size_t i) {
+                ObjectHierarchical::prepareMesh(scene, (int) i, indexes, parents, meshes[i]);
+            });
+            
+            rig_parents = parents;
+            aiReleaseImport(scene);
+
+            // The points come from the bounding boxes once the nodes exist.
+            return true;
+
+        });
 
 	}
 
+    ObjectHierarchical::ObjectHierarchical(const char *filename) : root(0, {}, {}, {}, {}, VertexLayout::full(), {}) {
+
+        // The points are placed from the file itself.
+        this->first = strdup("gltf");
+        this->middle = strdup("gltf");
+        this->end = strdup("gltf");
+
+        unsigned long long key = RigCache::getKey(filename, {}, {}, this->first, this->middle, this->end);
+
+        this->load(filename, key, [&](std::vector<int> &parents, std::vector<PreparedMesh> &meshes) {
+
+            // Map the file, its buffers are read in place.
+            MappedFile mapped;
+            GltfFile file;
+            std::string error;
+
+            if (!mapped.open(filename) || !GltfFile::read(mapped.getData(), mapped.getSize(), file, error)) {
+
+                std::cerr << "Error 121-1011 - Could not read the GLB file " << filename << (error.empty() ? "" : ": " + error) << "." << std::endl;
+                exit(1);
+
+            }
+
+            // Print info from the scene.
+            std::cerr << "  " << filename << std::endl;
+            std::cerr << "  " << file.meshes.size() << " meshes" << std::endl;
+            std::cerr << "  " << file.nodes.size() << " nodes" << std::endl;
+            std::cerr << "  " << file.skins.size() << " skins" << std::endl;
+
+            ObjectHierarchical::buildRig(file, parents, meshes);
+            std::cerr << "  " << parents.size() << " joints" << std::endl;
+
+            // Optimize every joint at once, keeping the regions where it meets the others.
+            std::vector<std::vector<int>> children = ObjectHierarchical::getChildren(parents);
+            MeshConverter::parallelFor(meshes.size(), [&](size_t i) {
+                std::vector<BoundingBox> joints;
+                if (parents[i] >= 0)
+                    joints.push_back(meshes[parents[i]].bounds);
+                for (size_t j = 0; j < children[i].size(); j++)
+                    joints.push_back(meshes[children[i][j]].bounds);
+                ObjectHierarchical::optimizeMesh(meshes[i], joints);
+            });
+
+            ObjectHierarchical::placeJoints(parents, children, meshes);
+
+            return false;
+
+        });
+
+    }
+
+    void ObjectHierarchical::load(const char *filename, unsigned long long key, const std::function<bool(std::vector<int> &, std::vector<PreparedMesh> &)> &build) {
+
+        std::string cache_path = RigCache::getPath(filename);
+        RigCache cache;
+
+        if (!RigCache::getRebuild() && cache.open(cache_path, key) && cache.find(0)) {
+
+            std::cerr << "  " << filename << " (from " << cache_path << ")" << std::endl;
+            std::cerr << "  " << cache.getNumRecords() << " meshes" << std::endl;
+
+            // Find the children of every record in one pass over the ids and one over the parents.
+            int num_records = (int) cache.getNumRecords();
+            std::vector<std::vector<uint32_t>> children(num_records);
+            std::vector<int> index_of(num_records, -1);
+            for (int i = 0; i < num_records; i++) {
+                const RigCache::Record &record = cache.getRecords()[i];
+                if (record.id >= 0 && record.id < num_records)
+                    index_of[record.id] = i;
+            }
+            for (int i = 0; i < num_records; i++) {
+                const RigCache::Record &record = cache.getRecords()[i];
+                if (record.parent >= 0 && record.parent < num_records && record.parent != record.id && index_of[record.parent] >= 0)
+                    children[index_of[record.parent]].push_back((uint32_t) i);
+            }
+
+            this->root = loadNode(cache, (uint32_t) (cache.find(0) - cache.getRecords()), children);
+
+        } else {
+
+            std::vector<int> parents;
+            std::vector<PreparedMesh> meshes;
+            bool calculate = build(parents, meshes);
+
+            // Load this node.
+            std::vector<RigCache::Record> records;
+            std::vector<unsigned char> data;
+            this->root = loadNode(0, parents, ObjectHierarchical::getChildren(parents), meshes, records, data);
+        
+            // Load the control points.
+            if (calculate) {
+
+                this->root.calculateControlPoints(this->first, this->middle, this->end);
+
+                for (size_t i = 0; i < records.size(); i++) {
+
+                    Node *node = this->root.find(records[i].id);
+                    if (node)
+                        RigCache::packControlPoints(records[i], node->getAnchor(), node->getControl(), data);
+
+                }
+
+            }
+
+            // Keep the finished rig for the next run.
+            if (RigCache::write(cache_path, key, records, data))
+                std::cerr << "  rig cached in " << cache_path << std::endl;
+
+        }
+
+        // Give every node a slot in the stream of matrices.
+        this->root.assignMatrixSlots(this->num_slots);
+        this->matrices = new MatrixStream(this->num_slots);
+
+    }
+
+    ObjectHierarchical::~ObjectHierarchical() {
+
+        // The nodes delete their own geometries.
+        delete this->matrices;
+
+    }
+
     BoundingBox ObjectHierarchical::getBoundingBox() {
 
         return this->root.getBoundingBox();
 
     }
 
+    BoundingBox ObjectHierarchical::getWorldBoundingBox() {
+
+        BoundingBox bb{glm::vec3(0.0f), glm::vec3(0.0f)};
+        this->root.getWorldBoundingBox(bb);
+
+        return bb;
+
+    }
+
+    BoundingBox ObjectHierarchical::getWorldBoundingBox(const Pose &pose) {
+
+        BoundingBox bb{glm::vec3(0.0f), glm::vec3(0.0f)};
+        this->root.getWorldBoundingBox(bb, pose);
+
+        return bb;
+
+    }
+
+    void ObjectHierarchical::capturePose(Pose &pose) {
+
+        pose.matrices.resize(this->num_slots);
+        pose.kinds.resize(this->num_slots);
+        pose.versions.resize(this->num_slots);
+        this->root.capturePose(pose);
+
+    }
+
+    unsigned int ObjectHierarchical::getNumJoints() {
+
+        return (unsigned int) this->num_slots;
+
+    }
+
+    void ObjectHierarchical::applyJointPose(const JointPose &pose) {
+
+        this->root.applyJointPose(pose, glm::mat4(1.0f));
+
+    }
+
+    void ObjectHierarchical::captureJointPose(JointPose &pose) {
+
+        pose.resize(this->num_slots);
+        this->root.captureJointPose(pose, glm::mat4(1.0f));
+
+    }
+
+    void ObjectHierarchical::getRestJoints(std::vector<int> &parents, std::vector<glm::vec3> &anchors, std::vector<std::vector<glm::vec3>> &controls) {
+
+        parents.resize(this->num_slots);
+        anchors.resize(this->num_slots);
+        controls.resize(this->num_slots);
+        this->root.getRestJoints(-1, parents, anchors, controls);
+
+    }
+
+    unsigned int ObjectHierarchical::getNumSegments() {
+
+        return this->root.getNumSegments();
+
+    }
+
     std::vector<ControlPoint> ObjectHierarchical::getControlPoints() {
         
         return this->root.getControlPoints();
@@ -86,7 +383,42 @@ ObjectHierarchical::ObjectHierarchical(const char *filename, const std::vector<i
 
 	void ObjectHierarchical::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera) {
         
-        this->root.draw(shader, camera);
+        // Cull against the current camera.
+        this->draw(shader, camera, Frustum::fromMatrix(camera.getCameraMatrix()));
+        
+	}
+
+	void ObjectHierarchical::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera, const Frustum &frustum) {
+        
+        // Draw the transforms as they are now.
+        this->capturePose(this->current_pose);
+        this->draw(shader, camera, frustum, this->current_pose);
+        
+	}
+
+	void ObjectHierarchical::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera, const Frustum &frustum, const Pose &pose) {
+        
+        // Skip the whole rig if it cannot be seen.
+        BoundingBox bb;
+        if (!this->root.getWorldBoundingBox(bb, pose) || !frustum.intersects(bb)) {
+            RenderStats::addCulled(this->root.getNumSegments());
+            return;
+        }
+        
+        this->drawVisible(shader, camera, frustum, pose);
+        
+	}
+
+	void ObjectHierarchical::drawVisible(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera, const Frustum &frustum, const Pose &pose) {
+        
+        // Upload the matrices that changed, then draw reading them from the stream.
+        this->matrices->begin();
+        this->root.writeMatrices(*this->matrices, pose);
+        this->matrices->end();
+        
+        this->matrices->bind(shader);
+        this->root.draw(shader, camera, frustum, *this->matrices, pose);
+        this->matrices->fence();
         
 	}
 
@@ -139,108 +471,421 @@ ObjectHierarchical::ObjectHierarchical(const char *filename, const std::vector<i
 
 	}
     
-    Node ObjectHierarchical::loadNode(const aiScene* scene, const int currentInd, const std::vector<int> &node_indexes, const std::vector<int> &parents) {
+    void ObjectHierarchical::prepareMesh(const aiScene* scene, const int currentInd, const std::vector<int> &node_indexes, const std::vector<int> &parents, PreparedMesh &prepared) {
+        
+        // Get this mesh from assimp and convert it.
+        const aiMesh* mesh = scene->mMeshes[node_indexes[currentInd]];
+        prepared.name = mesh->mName.C_Str();
+        MeshConverter::convert(scene, mesh, prepared.vertices, prepared.indices);
+
+        // The joints are where this segment overlaps its parent and its children.
+        std::vector<BoundingBox> joints;
+        for (int i = 0; i < parents.size(); i++)
+            if (parents[i] == currentInd || i == parents[currentInd])
+                joints.push_back(meshBounds(scene->mMeshes[node_indexes[i]]));
+        
+        ObjectHierarchical::optimizeMesh(prepared, joints);
+        
+    }
+
+    void ObjectHierarchical::optimizeMesh(PreparedMesh &prepared, const std::vector<BoundingBox> &joints) {
         
-        // Check there are the same indexes and parents.
-        assert(node_indexes.size() == parents.size());
+        std::vector<Vertex> &vertices = prepared.vertices;
+        std::vector<GLuint> &indices = prepared.indices;
         
-        // Init the children.
-        std::vector<Node> children = {};
+        // Joints that only group others have nothing to draw.
+        if (vertices.empty())
+            return;
         
-        // Load the children by iterating through all meshes and checking who are children of this.
-        for (int i = 0; i < parents.size(); i++) {
-                        
-            if (parents[i] == currentInd) {
-                                
-                children.push_back(loadNode(scene, i, node_indexes, parents));
+        // Weld, reorder for the vertex cache and for fetch locality.
+        prepared.stats = MeshOptimizer::optimize(vertices, indices);
+        
+        // Lock the vertices in those regions so the segments still meet at every level of detail.
+        std::vector<bool> locked(vertices.size(), false);
+        for (size_t i = 0; i < joints.size(); i++) {
+            
+            glm::vec3 margin = (joints[i].max - joints[i].min) * 0.02f;
+            
+            for (size_t v = 0; v < vertices.size(); v++) {
+                
+                glm::vec3 p = vertices[v].position;
+                if (p.x >= joints[i].min.x - margin.x && p.y >= joints[i].min.y - margin.y && p.z >= joints[i].min.z - margin.z &&
+                    p.x <= joints[i].max.x + margin.x && p.y <= joints[i].max.y + margin.y && p.z <= joints[i].max.z + margin.z)
+                    locked[v] = true;
                 
             }
             
         }
         
-        // Get this mesh from assimp.
-        const aiMesh* mesh = scene->mMeshes[node_indexes[currentInd]];
+        // Build the simplified levels.
+        prepared.lods = MeshOptimizer::buildLODs(vertices, indices, locked);
 
-        // Init the ds.
-        std::vector<bgq_opengl::Vertex> vertices(0);
-        std::vector<GLuint> indices(0);
-        
-        // If has materials, pass them.
-        aiMaterial *mat = scene->mMaterials[mesh->mMaterialIndex];
-        aiColor3D color;
-        mat->Get(AI_MATKEY_COLOR_DIFFUSE, color);
-        
-        // Iterate through the vertices in the mesh.
-        for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-            
-            // Build an empty vertex.
-            bgq_opengl::Vertex vertex{
-                glm::vec3(0.0f, 0.0f, 0.0f),    // Position.
-                glm::vec3(1.0f, 1.0f, 1.0f),    // Normal.
-                glm::vec3(0.0f, 0.0f, 1.0f),    // Color.
-                glm::vec2(0.0f, 0.0f),          // UV coords.
-                glm::vec3(0.0f, 1.0f, 0.0f),    // Tangente.
-                glm::vec3(1.0f, 0.0f, 0.0f)     // Bitangente.
-            };
+        // Choose the most compact layout this mesh can use.
+        prepared.layout = VertexLayout::choose(vertices, false);
+        
+    }
+
+    void ObjectHierarchical::buildRig(const GltfFile &file, std::vector<int> &parents, std::vector<PreparedMesh> &meshes) {
+        
+        // The joints are the ones of the skins, or every node when there are none.
+        std::vector<bool> is_joint(file.nodes.size(), file.skins.empty());
+        for (size_t i = 0; i < file.skins.size(); i++)
+            for (size_t j = 0; j < file.skins[i].joints.size(); j++)
+                is_joint[file.skins[i].joints[j]] = true;
+        
+        // One pass over the tree, parents first, numbering the joints and finding the one each node moves with.
+        std::vector<int> nodes;
+        std::vector<int> owner(file.nodes.size(), -1);
+        std::vector<bool> visited(file.nodes.size(), false);
+        std::vector<glm::mat4> world(file.nodes.size(), glm::mat4(1.0f));
+        std::vector<TreeStep> stack;
+        for (size_t i = file.roots.size(); i > 0; i--)
+            stack.push_back(TreeStep{file.roots[i - 1], -1, -1});
+        
+        while (!stack.empty()) {
             
-            // If it has a position, subtitute it in the vertex.
-            if (mesh->HasPositions()) {
-                
-                const aiVector3D* vp = &(mesh->mVertices[i]);
-                vertex.position = glm::vec3(vp->x, vp->y, vp->z);
-                
+            TreeStep step = stack.back();
+            stack.pop_back();
+            
+            // A scene may list a node twice.
+            if (visited[step.node])
+                continue;
+            
+            const GltfFile::Node &node = file.nodes[step.node];
+            world[step.node] = step.parent_node >= 0 ? world[step.parent_node] * node.matrix : node.matrix;
+            
+            int joint = step.parent_joint;
+            if (is_joint[step.node]) {
+                joint = (int) nodes.size();
+                nodes.push_back(step.node);
+                parents.push_back(step.parent_joint);
             }
+            owner[step.node] = joint;
+            visited[step.node] = true;
             
-            vertex.color = glm::vec3(color.r, color.g, color.b);
+            for (size_t i = node.children.size(); i > 0; i--)
+                stack.push_back(TreeStep{node.children[i - 1], step.node, joint});
             
-            // If it has a normal, subtitute it in the vertex.
-            if (mesh->HasNormals()) {
-                
-                const aiVector3D* vn = &(mesh->mNormals[i]);
-                vertex.normal = glm::vec3(vn->x, vn->y, vn->z);
-                
+        }
+        
+        // A rig has a single root, so several are hung from an empty one.
+        int num_roots = (int) std::count(parents.begin(), parents.end(), -1);
+        if (num_roots != 1) {
+            
+            for (size_t i = 0; i < parents.size(); i++)
+                parents[i]++;
+            for (size_t i = 0; i < owner.size(); i++)
+                if (owner[i] >= 0)
+                    owner[i]++;
+            
+            nodes.insert(nodes.begin(), -1);
+            parents.insert(parents.begin(), -1);
+            
+        }
+        
+        meshes.assign(nodes.size(), PreparedMesh());
+        for (size_t i = 0; i < nodes.size(); i++)
+            meshes[i].name = nodes[i] >= 0 ? file.nodes[nodes[i]].name : "root";
+        
+        // Every primitive of every node of the scene with a mesh is converted on its own.
+        std::vector<RigPart> parts;
+        for (size_t i = 0; i < file.nodes.size(); i++) {
+            if (file.nodes[i].mesh >= 0 && visited[i]) {
+                for (size_t j = 0; j < file.meshes[file.nodes[i].mesh].primitives.size(); j++) {
+                    RigPart part;
+                    part.node = (int) i;
+                    part.primitive = (int) j;
+                    parts.push_back(part);
+                }
             }
+        }
+        
+        MeshConverter::parallelFor(parts.size(), [&](size_t p) {
+            
+            RigPart &part = parts[p];
+            const GltfFile::Node &node = file.nodes[part.node];
+            const GltfFile::Primitive &primitive = file.meshes[node.mesh].primitives[part.primitive];
+            MeshConverter::convert(file, primitive, part.vertices, part.indices);
             
-            // If it has UV textures, subtitute it in the vertex.
-            if (mesh->HasTextureCoords(0)) {
-                                
-                const aiVector3D* vt = &(mesh->mTextureCoords[0][i]);
-                vertex.uv = glm::vec2(-vt->y, vt->x);
+            int joints = primitive.getAttribute("JOINTS_0");
+            int weights = primitive.getAttribute("WEIGHTS_0");
+            std::vector<float> joint_values, weight_values;
+            bool skinned = node.skin >= 0 && joints >= 0 && weights >= 0 &&
+                file.readFloats(joints, 4, joint_values) && file.readFloats(weights, 4, weight_values) &&
+                joint_values.size() == part.vertices.size() * 4 && weight_values.size() == part.vertices.size() * 4;
+            
+            // Rigid meshes move with the joint they hang from, or with the root.
+            if (!skinned) {
+                transformVertices(part.vertices, 0, part.vertices.size(), world[part.node]);
+                if (glm::determinant(glm::mat3(world[part.node])) < 0.0f)
+                    flipTriangles(part.indices);
+                part.joints.assign(part.indices.size() / 3, owner[part.node] >= 0 ? owner[part.node] : 0);
+                return;
+            }
+            
+            // Skinned meshes are posed as in the file, each joint moving its vertices by its bind matrix.
+            const GltfFile::Skin &skin = file.skins[node.skin];
+            std::vector<float> inverse_binds;
+            if (skin.inverse_bind_matrices >= 0)
+                file.readFloats(skin.inverse_bind_matrices, 16, inverse_binds);
+            
+            std::vector<glm::mat4> skinning(skin.joints.size());
+            for (size_t j = 0; j < skin.joints.size(); j++) {
+                glm::mat4 inverse_bind(1.0f);
+                if (inverse_binds.size() >= (j + 1) * 16)
+                    inverse_bind = glm::make_mat4(&inverse_binds[j * 16]);
+                skinning[j] = world[skin.joints[j]] * inverse_bind;
+            }
+            
+            for (size_t v = 0; v < part.vertices.size(); v++) {
+                glm::mat4 blend(0.0f);
+                for (int k = 0; k < 4; k++) {
+                    size_t j = (size_t) joint_values[v * 4 + k];
+                    if (j < skinning.size())
+                        blend += skinning[j] * weight_values[v * 4 + k];
+                }
+                transformVertices(part.vertices, v, v + 1, blend);
+            }
+            
+            // Each triangle goes to the joint that weighs the most on its three vertices.
+            part.joints.resize(part.indices.size() / 3);
+            for (size_t t = 0; t < part.joints.size(); t++) {
+                
+                int best = -1;
+                float best_weight = -1.0f;
+                for (int c = 0; c < 12; c++) {
+                    
+                    float candidate = joint_values[part.indices[t * 3 + c / 4] * 4 + c % 4];
+                    if ((size_t) candidate >= skin.joints.size())
+                        continue;
+                    
+                    float weight = 0.0f;
+                    for (int d = 0; d < 12; d++)
+                        if (joint_values[part.indices[t * 3 + d / 4] * 4 + d % 4] == candidate)
+                            weight += weight_values[part.indices[t * 3 + d / 4] * 4 + d % 4];
+                    
+                    if (weight > best_weight) {
+                        best_weight = weight;
+                        best = owner[skin.joints[(size_t) candidate]];
+                    }
+                    
+                }
+                part.joints[t] = best >= 0 ? best : 0;
                 
             }
             
-            // Check if it has tangents.
-            if (mesh->HasTangentsAndBitangents()) {
+        });
+        
+        // Hand the triangles of every part to their joints, copying the vertices they use once per joint.
+        std::vector<GLuint> remap;
+        std::vector<int> stamp;
+        for (size_t p = 0; p < parts.size(); p++) {
+            
+            RigPart &part = parts[p];
+            std::vector<size_t> order(part.joints.size());
+            for (size_t t = 0; t < order.size(); t++)
+                order[t] = t;
+            std::stable_sort(order.begin(), order.end(), [&part](size_t a, size_t b) { return part.joints[a] < part.joints[b]; });
+            
+            remap.assign(part.vertices.size(), 0);
+            stamp.assign(part.vertices.size(), -1);
+            for (size_t o = 0; o < order.size(); o++) {
                 
-                const aiVector3D* tangent = &(mesh->mTangents[i]);
-                vertex.tangent = glm::vec3(tangent->x, tangent->y, tangent->z);
+                size_t t = order[o];
+                PreparedMesh &mesh = meshes[part.joints[t]];
+                for (int c = 0; c < 3; c++) {
+                    GLuint v = part.indices[t * 3 + c];
+                    if (stamp[v] != part.joints[t]) {
+                        stamp[v] = part.joints[t];
+                        remap[v] = (GLuint) mesh.vertices.size();
+                        mesh.vertices.push_back(part.vertices[v]);
+                    }
+                    mesh.indices.push_back(remap[v]);
+                }
                 
-                const aiVector3D* bitangent = &(mesh->mBitangents[i]);
-                vertex.bitangent = glm::vec3(bitangent->x, bitangent->y, bitangent->z);
-                                
             }
             
-            // Add that to vertices.
-            vertices.push_back(vertex);
+            part = RigPart();
+            
+        }
+        
+        // Joints are placed where the skins put them, the rest once the meshes are known.
+        for (size_t i = 0; i < nodes.size(); i++) {
+            
+            if (nodes[i] < 0 || file.skins.empty())
+                continue;
+            
+            meshes[i].anchor = glm::vec3(world[nodes[i]][3]);
+            meshes[i].placed = true;
+            
+        }
+        
+        // Get the box of every joint, children first, so that empty ones take the box of their children.
+        std::vector<bool> known(meshes.size(), false);
+        for (size_t i = meshes.size(); i > 0; i--) {
+            
+            PreparedMesh &mesh = meshes[i - 1];
+            if (!mesh.vertices.empty()) {
+                mesh.bounds = BoundingBox{mesh.vertices[0].position, mesh.vertices[0].position};
+                for (size_t v = 1; v < mesh.vertices.size(); v++)
+                    mesh.bounds.merge(BoundingBox{mesh.vertices[v].position, mesh.vertices[v].position});
+                known[i - 1] = true;
+            } else if (mesh.placed) {
+                if (known[i - 1])
+                    mesh.bounds.merge(BoundingBox{mesh.anchor, mesh.anchor});
+                else
+                    mesh.bounds = BoundingBox{mesh.anchor, mesh.anchor};
+                known[i - 1] = true;
+            }
+            
+            int parent = parents[i - 1];
+            if (!known[i - 1] || parent < 0 || !meshes[parent].vertices.empty())
+                continue;
+            
+            if (known[parent])
+                meshes[parent].bounds.merge(mesh.bounds);
+            else
+                meshes[parent].bounds = mesh.bounds;
+            known[parent] = true;
+            
+        }
+        
+    }
 
+    void ObjectHierarchical::placeJoints(const std::vector<int> &parents, const std::vector<std::vector<int>> &children, std::vector<PreparedMesh> &meshes) {
+        
+        // The other joints sit in the middle of the overlap of their box with the one of their parent.
+        for (size_t i = 0; i < meshes.size(); i++) {
+            
+            if (meshes[i].placed || parents[i] < 0)
+                continue;
+            
+            const BoundingBox &bb_1 = meshes[i].bounds;
+            const BoundingBox &bb_2 = meshes[parents[i]].bounds;
+            
+            BoundingBox intersection {
+                glm::vec3(fmax(bb_1.min.x, bb_2.min.x), fmax(bb_1.min.y, bb_2.min.y), fmax(bb_1.min.z, bb_2.min.z)),
+                glm::vec3(fmin(bb_1.max.x, bb_2.max.x), fmin(bb_1.max.y, bb_2.max.y), fmin(bb_1.max.z, bb_2.max.z))
+            };
+            
+            meshes[i].anchor = (intersection.min + intersection.max) / 2.0f;
+            meshes[i].placed = true;
+            
         }
         
-        // Lets store all the indices or faces.
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
+        // The root sits at the far end of a chain, or in its centre if it has several branches.
+        for (size_t i = 0; i < meshes.size(); i++) {
+            
+            if (meshes[i].placed)
+                continue;
+            
+            const BoundingBox &bb = meshes[i].bounds;
+            meshes[i].anchor = children[i].size() == 1 ? exitPoint(bb, meshes[children[i][0]].anchor) : (bb.min + bb.max) / 2.0f;
+            meshes[i].placed = true;
             
-            indices.push_back(mesh->mFaces[j].mIndices[0]);
-            indices.push_back(mesh->mFaces[j].mIndices[1]);
-            indices.push_back(mesh->mFaces[j].mIndices[2]);
+        }
         
+        // The control points are the anchors of the children, or the far end of the leaves.
+        for (size_t i = 0; i < meshes.size(); i++) {
+            
+            PreparedMesh &mesh = meshes[i];
+            mesh.control.clear();
+            
+            for (size_t j = 0; j < children[i].size(); j++)
+                mesh.control.push_back(meshes[children[i][j]].anchor);
+            
+            if (!children[i].empty())
+                continue;
+            
+            glm::vec3 tip = exitPoint(mesh.bounds, mesh.anchor);
+            
+            // Leaves without a length of their own carry on the direction of their parent.
+            if (glm::length(tip - mesh.anchor) < 1e-5f && parents[i] >= 0)
+                tip = mesh.anchor + (mesh.anchor - meshes[parents[i]].anchor) * 0.5f;
+            
+            mesh.control.push_back(tip);
+            
         }
+        
+    }
+
+    std::vector<std::vector<int>> ObjectHierarchical::getChildren(const std::vector<int> &parents) {
+        
+        std::vector<std::vector<int>> children(parents.size());
+        for (size_t i = 0; i < parents.size(); i++)
+            if (parents[i] >= 0 && parents[i] < (int) parents.size() && parents[i] != (int) i)
+                children[parents[i]].push_back((int) i);
+        
+        return children;
+        
+    }
+    
+    Node ObjectHierarchical::loadNode(const int currentInd, const std::vector<int> &parents, const std::vector<std::vector<int>> &children, std::vector<PreparedMesh> &meshes, std::vector<RigCache::Record> &records, std::vector<unsigned char> &data) {
+        
+        // Load the children first.
+        std::vector<Node> child_nodes = {};
+        for (size_t i = 0; i < children[currentInd].size(); i++)
+            child_nodes.push_back(loadNode(children[currentInd][i], parents, children, meshes, records, data));
+        
+        // Get the mesh prepared for this node.
+        PreparedMesh &prepared = meshes[currentInd];
+        
+        std::cerr << "  mesh " << prepared.name << ": " << prepared.stats.vertices_before << " -> " << prepared.stats.vertices_after << " vertices, ACMR " << prepared.stats.acmr_before << " -> " << prepared.stats.acmr_after << std::endl;
+        std::cerr << "  mesh " << prepared.name << ": " << prepared.lods.size() + 1 << " levels of detail" << std::endl;
 
         // Obtain the textures.
         std::vector<bgq_opengl::Texture> textures = {};
+
+        // Keep the buffers as they go to the GPU, after the ones of the children.
+        records.push_back(RigCache::pack(currentInd, parents[currentInd], prepared.layout, prepared.vertices, prepared.indices, prepared.lods, data));
                 
-        return Node(currentInd, vertices, indices, textures, children);
+        Node node(currentInd, prepared.vertices, prepared.indices, textures, std::move(child_nodes), prepared.layout, prepared.lods);
+        
+        // Rigs placed from the file already know their points.
+        if (prepared.placed) {
+            node.setControlPoints(prepared.anchor, prepared.control);
+            RigCache::packControlPoints(records.back(), prepared.anchor, prepared.control, data);
+        }
+        
+        // The node keeps its own copy.
+        prepared = PreparedMesh();
+        
+        return node;
 
     }
 
+    Node ObjectHierarchical::loadNode(const RigCache &cache, const uint32_t index, const std::vector<std::vector<uint32_t>> &children) {
+        
+        // The children come before their parent in the file, in the same order they were loaded.
+        std::vector<Node> child_nodes = {};
+        for (size_t i = 0; i < children[index].size(); i++)
+            child_nodes.push_back(loadNode(cache, children[index][i], children));
+        
+        const RigCache::Record &record = cache.getRecords()[index];
+        
+        // Hand the mapped buffers to OpenGL as they are.
+        Geometry geometry(
+            cache.getData(record.vertex_offset), (GLsizeiptr) record.vertex_size,
+            cache.getData(record.index_offset), (GLsizeiptr) record.index_size, record.index_type,
+            std::vector<GLsizei>(record.lod_offsets, record.lod_offsets + record.num_lods),
+            std::vector<GLsizei>(record.lod_counts, record.lod_counts + record.num_lods),
+            BoundingBox{RigCache::getVector(record.bounds_min), RigCache::getVector(record.bounds_max)}, {}, 1.0, RigCache::getLayout(record)
+        );
+        
+        // The points were already calculated when the rig was cached.
+        const float *points = (const float *) cache.getData(record.control_offset);
+        std::vector<glm::vec3> control(record.num_control);
+        for (uint32_t i = 0; i < record.num_control; i++)
+            control[i] = RigCache::getVector(&points[i * 3]);
+        
+        Node node(record.id, std::move(geometry), std::move(child_nodes));
+        node.setControlPoints(RigCache::getVector(record.anchor), control);
+        
+        return node;
+        
+    }
+
+
     void ObjectHierarchical::transform(glm::mat4 matrix) {
         
         this->root.transform(glm::vec3(0.0f), matrix);
@@ -16,6 +16,8 @@
 #ifndef BGQ_OPENGL_CLASSES_OBJECT_HIERARCHICAL_H_
 #define BGQ_OPENGL_CLASSES_OBJECT_HIERARCHICAL_H_
 
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -23,9 +25,18 @@
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include "classes/matrix_stream/matrix_stream.h"
+#include "classes/mesh_optimizer/mesh_optimizer.h"
 #include "classes/node/node.h"
+#include "classes/rig_cache/rig_cache.h"
 #include "structs/bounding_box/bounding_box.h"
 #include "structs/control_point/control_point.h"
+#include "structs/frustum/frustum.h"
+#include "structs/gltf_file/gltf_file.h"
+#include "structs/joint_pose/joint_pose.h"
+#include "structs/pose/pose.h"
+#include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
 
 namespace bgq_opengl {
 
@@ -41,6 +52,27 @@ namespace bgq_opengl {
 			 * @param filename The name of the model file.
 			 */
             ObjectHierarchical(const char* filename, const std::vector<int> &indexes, const std::vector<int> &parents, const char* first, const char* middle, const char* end);
+
+            /**
+             * @brief Loads a rig from the node tree of a GLB file.
+             *
+             * Builds the hierarchy from the glTF nodes, or from the joints of its skins
+             * when it has any, whose meshes are split by the joint that weighs the most
+             * on each triangle. Joints are placed where the skins put them, or where
+             * each segment overlaps its parent when there are no skins.
+             *
+             * @param filename The name of the GLB file.
+             *
+             * @throws 121-1011 Could not read the GLB file.
+             */
+            ObjectHierarchical(const char* filename);
+
+            /**
+             * @brief Deletes the object.
+             *
+             * Deletes the stream of matrices along with the geometries of the nodes.
+             */
+            ~ObjectHierarchical();
         
             /**
              * @brief Gets the bounding box.
@@ -50,6 +82,87 @@ namespace bgq_opengl {
              * @returns The bounding box struct.
              */
             BoundingBox getBoundingBox();
+
+            /**
+             * @brief Gets the world bounding box.
+             *
+             * Gets the bounding box of all the geometries after their transforms.
+             *
+             * @returns The bounding box struct.
+             */
+            BoundingBox getWorldBoundingBox();
+
+            /**
+             * @brief Gets the world bounding box in a pose.
+             *
+             * Gets the bounding box of the whole rig placed as in a pose.
+             *
+             * @param pose The pose.
+             *
+             * @returns The bounding box struct.
+             */
+            BoundingBox getWorldBoundingBox(const Pose &pose);
+
+            /**
+             * @brief Captures the pose.
+             *
+             * Copies the current transforms of every node into a pose, so that it can be
+             * drawn by another thread while this object keeps moving.
+             *
+             * @param pose The pose, which is resized if needed.
+             */
+            void capturePose(Pose &pose);
+
+            /**
+             * @brief Gets the number of joints.
+             *
+             * Gets the number of nodes, which are the joints of a JointPose indexed by
+             * their matrix slots.
+             *
+             * @returns The number of joints.
+             */
+            unsigned int getNumJoints();
+
+            /**
+             * @brief Places the rig in a joint pose.
+             *
+             * Sets every node from its local joint transform, starting over from the
+             * rest pose instead of adding to the current transforms.
+             *
+             * @param pose The joint pose, with a transform per joint.
+             */
+            void applyJointPose(const JointPose &pose);
+
+            /**
+             * @brief Captures the joint pose.
+             *
+             * Recovers the local joint transforms that place the rig as it is now, so
+             * that motion made with FK, IK or scripts can be baked into a clip.
+             *
+             * @param pose The joint pose, which is resized if needed.
+             */
+            void captureJointPose(JointPose &pose);
+
+            /**
+             * @brief Gets the rest joints.
+             *
+             * Gets the parent, anchor and control points of every joint in the rest
+             * pose, indexed by matrix slot. Parents always come before their children.
+             *
+             * @param parents Outputs the parent of each joint, -1 for the root.
+             * @param anchors Outputs the anchor of each joint.
+             * @param controls Outputs the control points of each joint.
+             */
+            void getRestJoints(std::vector<int> &parents, std::vector<glm::vec3> &anchors, std::vector<std::vector<glm::vec3>> &controls);
+
+            /**
+             * @brief Gets the number of segments.
+             *
+             * Gets the number of drawable geometries of the whole rig.
+             *
+             * @returns The number of segments.
+             */
+            unsigned int getNumSegments();
         
             /**
              * @brief Get the control points for this object.
@@ -79,6 +192,37 @@ namespace bgq_opengl {
 			 */
 			void draw(Shader &shader, Camera &camera);
 
+			/**
+			 * @brief Draws the visible parts of this object.
+			 *
+			 * Skips the whole rig if it is outside the frustum, and each segment that is.
+			 *
+			 * @param frustum The camera frustum.
+			 */
+			void draw(Shader &shader, Camera &camera, const Frustum &frustum);
+
+			/**
+			 * @brief Draws the visible parts of this object in a pose.
+			 *
+			 * Draws this object placed as in a pose instead of its current transforms,
+			 * which are not read at all.
+			 *
+			 * @param frustum The camera frustum.
+			 * @param pose The pose.
+			 */
+			void draw(Shader &shader, Camera &camera, const Frustum &frustum, const Pose &pose);
+
+			/**
+			 * @brief Draws the visible segments of this object in a pose.
+			 *
+			 * Like draw, but for a rig already known to be in the frustum, such as one
+			 * reported by a BVH, so only its segments are tested.
+			 *
+			 * @param frustum The camera frustum.
+			 * @param pose The pose.
+			 */
+			void drawVisible(Shader &shader, Camera &camera, const Frustum &frustum, const Pose &pose);
+
 			/**
 			 * @brief Reset 
 			 *
@@ -201,11 +345,127 @@ namespace bgq_opengl {
             void transform(std::vector<unsigned int> inds, glm::vec3 anchor, glm::mat4 matrix);
 
 		private:
-        
-            Node loadNode(const aiScene* scene, const int currentInd, const std::vector<int> &indexes, const std::vector<int> &parents);
+
+            /**
+             * @brief A mesh converted on the CPU, waiting for its GL objects.
+             */
+            struct PreparedMesh {
+
+                std::string name;                           /// The name of the mesh.
+                std::vector<Vertex> vertices;               /// The optimized vertices.
+                std::vector<GLuint> indices;                /// The optimized indices.
+                std::vector<std::vector<GLuint>> lods;      /// The simplified levels.
+                VertexLayout layout = VertexLayout::full(); /// The layout chosen for it.
+                MeshOptimizer::Stats stats;                 /// What the optimizer did.
+                BoundingBox bounds{glm::vec3(0.0f), glm::vec3(0.0f)};  /// The box of the vertices, or of the children if there are none.
+                bool placed = false;                        /// Whether the anchor and control points are known.
+                glm::vec3 anchor = glm::vec3(0.0f);         /// The anchor point, if placed.
+                std::vector<glm::vec3> control;             /// The control points, if placed.
+
+            };
+
+            /**
+             * @brief Prepares the mesh of a node.
+             *
+             * Converts, optimizes and simplifies the mesh of a node without touching
+             * OpenGL, so that several can be prepared at once.
+             *
+             * @param scene The scene.
+             * @param currentInd The node.
+             * @param indexes The mesh of each node.
+             * @param parents The parent of each node.
+             * @param prepared Outputs the prepared mesh.
+             */
+            static void prepareMesh(const aiScene* scene, const int currentInd, const std::vector<int> &indexes, const std::vector<int> &parents, PreparedMesh &prepared);
+
+            /**
+             * @brief Optimizes a converted mesh.
+             *
+             * Optimizes a mesh, builds its levels of detail keeping the regions where
+             * it meets other segments, and chooses its layout.
+             *
+             * @param prepared The mesh.
+             * @param joints The boxes of the segments it meets.
+             */
+            static void optimizeMesh(PreparedMesh &prepared, const std::vector<BoundingBox> &joints);
+
+            /**
+             * @brief Builds the rig of a GLB file.
+             *
+             * Numbers the joints of the rig in one pass over the node tree, parents
+             * first, and converts the meshes of every node into the joints they move
+             * with, in world space.
+             *
+             * @param file The GLB file.
+             * @param parents Outputs the parent of each joint.
+             * @param meshes Outputs the mesh of each joint.
+             */
+            static void buildRig(const GltfFile &file, std::vector<int> &parents, std::vector<PreparedMesh> &meshes);
+
+            /**
+             * @brief Places the anchors and control points of a rig.
+             *
+             * Places every anchor where the joint meets its parent, unless it already
+             * is, and the control points on the anchors of the children or, for the
+             * leaves, at the far end of their segment.
+             *
+             * @param parents The parent of each joint.
+             * @param children The children of each joint.
+             * @param meshes The mesh of each joint.
+             */
+            static void placeJoints(const std::vector<int> &parents, const std::vector<std::vector<int>> &children, std::vector<PreparedMesh> &meshes);
+
+            /**
+             * @brief Get the children of every joint.
+             *
+             * @param parents The parent of each joint.
+             *
+             * @returns The children of each joint, in order.
+             */
+            static std::vector<std::vector<int>> getChildren(const std::vector<int> &parents);
+
+            /**
+             * @brief Loads a prepared node.
+             *
+             * Creates the GL objects of a node and its children and packs them for the
+             * rig cache.
+             *
+             * @param currentInd The node.
+             * @param parents The parent of each node.
+             * @param children The children of each node.
+             * @param meshes The prepared meshes, which are released once loaded.
+             * @param records Outputs the records of the cached rig.
+             * @param data Outputs the buffers of the cached rig.
+             */
+            Node loadNode(const int currentInd, const std::vector<int> &parents, const std::vector<std::vector<int>> &children, std::vector<PreparedMesh> &meshes, std::vector<RigCache::Record> &records, std::vector<unsigned char> &data);
+
+            /**
+             * @brief Loads a node from a cached rig.
+             *
+             * Builds a node and its children straight from the buffers of a cached rig.
+             *
+             * @param cache The cached rig.
+             * @param index The record of the node.
+             * @param children The records of the children of each record.
+             */
+            Node loadNode(const RigCache &cache, const uint32_t index, const std::vector<std::vector<uint32_t>> &children);
+
+            /**
+             * @brief Loads the rig from its cache or builds it.
+             *
+             * Loads the rig cached under a key, or builds it and caches it.
+             *
+             * @param filename The name of the model file.
+             * @param key The key of the cached rig.
+             * @param build Builds the rig, returning whether its points still have to be calculated.
+             */
+            void load(const char *filename, unsigned long long key, const std::function<bool(std::vector<int> &, std::vector<PreparedMesh> &)> &build);
 
 			// All the geometries and transformations
             Node root;
+            MatrixStream *matrices = 0;     /// The stream of the node matrices.
+            GLsizei num_slots = 0;          /// The number of matrix slots.
+            Pose current_pose;              /// The current transforms, when they are drawn directly.
             char* first;
             char* middle;
             char* end;
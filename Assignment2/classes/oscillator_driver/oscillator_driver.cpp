@@ -0,0 +1,185 @@
+/**
+ * @file oscillator_driver.cpp
+ * @brief Oscillator driver class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "oscillator_driver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "classes/object_hierarchical/object_hierarchical.h"
+#include "structs/joint_pose/joint_pose.h"
+
+namespace bgq_opengl {
+
+	OscillatorDriver::OscillatorDriver() {}
+
+	void OscillatorDriver::build(ObjectHierarchical &rig) {
+
+		std::vector<std::vector<glm::vec3>> rest_controls;
+		rig.getRestJoints(this->parents, this->anchors, rest_controls);
+
+		size_t num_joints = this->parents.size();
+
+		// Parents come first, so depths and arms are known by the time a joint is reached.
+		std::vector<unsigned int> depths(num_joints, 0);
+		std::vector<int> arms(num_joints, -1);
+		this->num_arms = 0;
+		this->num_levels = 0;
+		for (size_t i = 0; i < num_joints; i++) {
+
+			int parent = this->parents[i];
+			if (parent < 0)
+				continue;
+
+			depths[i] = depths[parent] + 1;
+			arms[i] = depths[i] == 1 ? (int) this->num_arms++ : arms[parent];
+
+			if (!rest_controls[i].empty())
+				this->num_levels = std::max(this->num_levels, depths[i]);
+
+		}
+
+		// Every joint below the root with a control point is driven by its level.
+		this->oscillators.assign(num_joints, -1);
+		this->controls.assign(num_joints, glm::vec3(0.0f));
+		this->levers.assign(num_joints, glm::vec3(0.0f));
+		this->directions.assign(num_joints, glm::vec3(0.0f));
+		for (size_t i = 0; i < num_joints; i++) {
+
+			if (depths[i] == 0 || rest_controls[i].empty())
+				continue;
+
+			glm::vec3 control = rest_controls[i][0];
+			glm::vec3 lever = control - this->anchors[i];
+			glm::vec3 outwards = glm::vec3(control.x, 0.0f, control.z);
+
+			if (glm::length(lever) <= 0.0f)
+				continue;
+
+			this->oscillators[i] = arms[i] * (int) this->num_levels + (int) depths[i] - 1;
+			this->controls[i] = control;
+			this->levers[i] = glm::normalize(lever);
+			this->directions[i] = glm::length(outwards) > 0.0f ? glm::normalize(outwards) : glm::vec3(0.0f);
+
+		}
+
+		size_t num_oscillators = (size_t) this->num_arms * this->num_levels;
+		this->amplitudes.assign(num_oscillators, 0.0f);
+		this->frequencies.assign(num_oscillators, 0.0f);
+		this->phases.assign(num_oscillators, 0.0f);
+		this->offsets.assign(num_oscillators, 0.0f);
+		this->displacements.assign(num_oscillators, 0.0f);
+
+		this->world_rotations.assign(num_joints, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+		this->world_translations.assign(num_joints, glm::vec3(0.0f));
+
+	}
+
+	unsigned int OscillatorDriver::getNumArms() const {
+
+		return this->num_arms;
+
+	}
+
+	unsigned int OscillatorDriver::getNumLevels() const {
+
+		return this->num_levels;
+
+	}
+
+	void OscillatorDriver::setOscillator(unsigned int arm, unsigned int level, float amplitude, float frequency, float phase, float offset) {
+
+		size_t i = (size_t) arm * this->num_levels + level;
+		this->amplitudes[i] = amplitude;
+		this->frequencies[i] = frequency;
+		this->phases[i] = phase;
+		this->offsets[i] = offset;
+
+	}
+
+	void OscillatorDriver::evaluate(float time, JointPose &pose) {
+
+		// Every sinusoid at once.
+		size_t num_oscillators = this->amplitudes.size();
+		for (size_t i = 0; i < num_oscillators; i++)
+			this->displacements[i] = this->amplitudes[i] * std::sin(this->frequencies[i] * time + this->phases[i]) + this->offsets[i];
+
+		// Each level is carried by the ones above it.
+		for (size_t arm = 0; arm < this->num_arms; arm++)
+			for (size_t level = 1; level < this->num_levels; level++)
+				this->displacements[arm * this->num_levels + level] += this->displacements[arm * this->num_levels + level - 1];
+
+		// Then every joint, parents first, tracking where each one ends up.
+		for (size_t i = 0; i < this->parents.size(); i++) {
+
+			int parent = this->parents[i];
+			glm::quat parent_rotation = parent >= 0 ? this->world_rotations[parent] : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+			glm::vec3 parent_translation = parent >= 0 ? this->world_translations[parent] : glm::vec3(0.0f);
+			glm::vec3 anchor = parent_rotation * this->anchors[i] + parent_translation;
+
+			glm::quat rotation;
+			glm::vec3 translation(0.0f);
+
+			if (this->oscillators[i] >= 0) {
+
+				// Aim the control point at its displaced rest position, seen from the parent.
+				glm::vec3 goal = this->controls[i] + this->directions[i] * this->displacements[this->oscillators[i]];
+				glm::vec3 aim = glm::conjugate(parent_rotation) * (goal - anchor);
+				float length = glm::length(aim);
+
+				if (length <= 0.0f) {
+
+					rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+				} else {
+
+					// The shortest arc, half way around when they are opposite.
+					aim /= length;
+					glm::vec3 lever = this->levers[i];
+					float w = 1.0f + glm::dot(lever, aim);
+					if (w < 1e-6f) {
+						glm::vec3 axis = glm::cross(lever, std::fabs(lever.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+						axis = glm::normalize(axis);
+						rotation = glm::quat(0.0f, axis.x, axis.y, axis.z);
+					} else {
+						glm::vec3 axis = glm::cross(lever, aim);
+						rotation = glm::normalize(glm::quat(w, axis.x, axis.y, axis.z));
+					}
+
+				}
+
+				pose.set(i, rotation, translation);
+
+			} else {
+
+				rotation = pose.getRotation(i);
+				translation = pose.getTranslation(i);
+
+			}
+
+			// The world transform of the joint, like the rig builds it.
+			glm::quat world_rotation = parent_rotation * rotation;
+			this->world_rotations[i] = world_rotation;
+			this->world_translations[i] = anchor + world_rotation * (translation - this->anchors[i]);
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,125 @@
+/**
+ * @file oscillator_driver.h
+ * @brief Oscillator driver class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_OSCILLATOR_DRIVER_H_
+#define BGQ_OPENGL_CLASSES_OSCILLATOR_DRIVER_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "classes/object_hierarchical/object_hierarchical.h"
+#include "structs/joint_pose/joint_pose.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a procedural driver of sinusoids.
+	 *
+	 * Implements a scripted motion for rigs made of arms. Every arm, a child of
+	 * the root with its descendants, has a sinusoid per level of depth. Each
+	 * joint is pushed away from the vertical axis by the sum of the sinusoids of
+	 * its level and the ones above, and is rotated so that its control point
+	 * aims at where that leaves it. All the sinusoids are evaluated in one pass
+	 * and the joints in another, from the rest pose and straight into a joint
+	 * pose, so the rig is never read nor changed.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class OscillatorDriver {
+
+		public:
+
+			/**
+			 * @brief Build a driver without a rig.
+			 *
+			 * Build a driver without a rig, which leaves poses untouched.
+			 */
+			OscillatorDriver();
+
+			/**
+			 * @brief Build the driver for a rig.
+			 *
+			 * Read the rest joints of a rig and find its arms and levels. Every
+			 * sinusoid starts flat.
+			 *
+			 * @param rig The rig.
+			 */
+			void build(ObjectHierarchical &rig);
+
+			/**
+			 * @brief Get the number of arms.
+			 *
+			 * @returns The number of arms.
+			 */
+			unsigned int getNumArms() const;
+
+			/**
+			 * @brief Get the number of levels.
+			 *
+			 * @returns The depth of the deepest driven joint.
+			 */
+			unsigned int getNumLevels() const;
+
+			/**
+			 * @brief Set a sinusoid.
+			 *
+			 * Set the sinusoid of a level of an arm, which displaces it by
+			 * amplitude * sin(frequency * time + phase) + offset.
+			 *
+			 * @param arm The arm.
+			 * @param level The level, 0 for the joints just below the root.
+			 * @param amplitude The amplitude.
+			 * @param frequency The angular frequency, in radians per second.
+			 * @param phase The phase, in radians.
+			 * @param offset The offset.
+			 */
+			void setOscillator(unsigned int arm, unsigned int level, float amplitude, float frequency, float phase, float offset);
+
+			/**
+			 * @brief Evaluate the motion.
+			 *
+			 * Write the rotation of every driven joint at a time. Their translations
+			 * are cleared and the rest of the joints keep what the pose held.
+			 *
+			 * @param time The time in seconds.
+			 * @param pose The pose, with a transform per joint of the rig.
+			 */
+			void evaluate(float time, JointPose &pose);
+
+		private:
+
+			unsigned int num_arms = 0;						/// The number of arms.
+			unsigned int num_levels = 0;					/// The number of levels of every arm.
+			std::vector<float> amplitudes;					/// The amplitude of each sinusoid, by arm and then level.
+			std::vector<float> frequencies;					/// The frequency of each sinusoid.
+			std::vector<float> phases;						/// The phase of each sinusoid.
+			std::vector<float> offsets;						/// The offset of each sinusoid.
+			std::vector<float> displacements;				/// The displacement of each level, including the ones above.
+			std::vector<int> parents;						/// The parent of each joint, -1 for the root.
+			std::vector<int> oscillators;					/// The displacement that drives each joint, or -1.
+			std::vector<glm::vec3> anchors;					/// The rest anchor of each joint.
+			std::vector<glm::vec3> controls;				/// The rest control point of each joint.
+			std::vector<glm::vec3> levers;					/// The rest direction from anchor to control point.
+			std::vector<glm::vec3> directions;				/// The direction each joint is pushed in.
+			std::vector<glm::quat> world_rotations;			/// The world rotation of each joint.
+			std::vector<glm::vec3> world_translations;		/// The world translation of each joint.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_OSCILLATOR_DRIVER_H_
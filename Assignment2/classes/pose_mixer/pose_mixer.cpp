@@ -0,0 +1,110 @@
+/**
+ * @file pose_mixer.cpp
+ * @brief Pose mixer class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "pose_mixer.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "structs/joint_pose/joint_pose.h"
+
+namespace bgq_opengl {
+
+	PoseMixer::PoseMixer() {}
+
+	PoseMixer::PoseMixer(size_t num_joints) {
+
+		this->num_joints = num_joints;
+		this->weights.resize(num_joints);
+
+	}
+
+	int PoseMixer::addLayer(Mode mode) {
+
+		Layer layer;
+		layer.mode = mode;
+		layer.weight = 1.0f;
+		layer.pose.resize(this->num_joints);
+		layer.mask.assign(this->num_joints, 1.0f);
+
+		this->layers.push_back(layer);
+
+		return (int) this->layers.size() - 1;
+
+	}
+
+	int PoseMixer::getNumLayers() const {
+
+		return (int) this->layers.size();
+
+	}
+
+	JointPose &PoseMixer::getPose(int layer) {
+
+		return this->layers[layer].pose;
+
+	}
+
+	void PoseMixer::setWeight(int layer, float weight) {
+
+		this->layers[layer].weight = weight;
+
+	}
+
+	float PoseMixer::getWeight(int layer) const {
+
+		return this->layers[layer].weight;
+
+	}
+
+	void PoseMixer::setMask(int layer, size_t joint, float weight) {
+
+		this->layers[layer].mask[joint] = weight;
+
+	}
+
+	void PoseMixer::clearMask(int layer, float weight) {
+
+		std::vector<float> &mask = this->layers[layer].mask;
+		for (size_t i = 0; i < mask.size(); i++)
+			mask[i] = weight;
+
+	}
+
+	void PoseMixer::mix(JointPose &result) {
+
+		result.resize(this->num_joints);
+		result.setIdentity();
+
+		for (size_t l = 0; l < this->layers.size(); l++) {
+
+			const Layer &layer = this->layers[l];
+			if (layer.weight <= 0.0f)
+				continue;
+
+			// The weight of the layer on each joint.
+			for (size_t i = 0; i < this->num_joints; i++)
+				this->weights[i] = layer.weight * layer.mask[i];
+
+			if (layer.mode == OVERRIDE)
+				JointPose::blend(result, layer.pose, this->weights.data(), result);
+			else
+				JointPose::add(result, layer.pose, this->weights.data(), result);
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,162 @@
+/**
+ * @file pose_mixer.h
+ * @brief Pose mixer class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_POSE_MIXER_H_
+#define BGQ_OPENGL_CLASSES_POSE_MIXER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "structs/joint_pose/joint_pose.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a mixer of pose layers.
+	 *
+	 * Implements a stack of layers that combine joint poses of the same rig. The
+	 * layers are applied in order on top of the rest pose: override layers blend
+	 * towards their pose and additive layers add theirs, each scaled by its
+	 * weight and by a mask with a weight per joint. Every pose and mask is sized
+	 * when the layer is added, so mixing does not allocate.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class PoseMixer {
+
+		public:
+
+			/**
+			 * @brief How a layer is combined with the ones below.
+			 */
+			enum Mode {
+				OVERRIDE,	/// Blend towards the pose of the layer.
+				ADDITIVE	/// Add the pose of the layer, a difference between two poses.
+			};
+
+			/**
+			 * @brief Build an empty mixer.
+			 *
+			 * Build a mixer without joints nor layers.
+			 */
+			PoseMixer();
+
+			/**
+			 * @brief Build a mixer without layers.
+			 *
+			 * Build a mixer without layers for a number of joints.
+			 *
+			 * @param num_joints The number of joints.
+			 */
+			PoseMixer(size_t num_joints);
+
+			/**
+			 * @brief Add a layer.
+			 *
+			 * Add a layer on top of the others, with full weight, no mask and the
+			 * identity pose.
+			 *
+			 * @param mode How it is combined.
+			 *
+			 * @returns Its index.
+			 */
+			int addLayer(Mode mode);
+
+			/**
+			 * @brief Get the number of layers.
+			 *
+			 * @returns The number of layers.
+			 */
+			int getNumLayers() const;
+
+			/**
+			 * @brief Get the pose of a layer.
+			 *
+			 * Get the pose of a layer, to be written by a sampler, a driver or a solver.
+			 *
+			 * @param layer The layer.
+			 *
+			 * @returns Its pose.
+			 */
+			JointPose &getPose(int layer);
+
+			/**
+			 * @brief Set the weight of a layer.
+			 *
+			 * @param layer The layer.
+			 * @param weight Its weight, 0 to skip it.
+			 */
+			void setWeight(int layer, float weight);
+
+			/**
+			 * @brief Get the weight of a layer.
+			 *
+			 * @param layer The layer.
+			 *
+			 * @returns Its weight.
+			 */
+			float getWeight(int layer) const;
+
+			/**
+			 * @brief Mask a joint of a layer.
+			 *
+			 * @param layer The layer.
+			 * @param joint The joint.
+			 * @param weight The weight of the layer on that joint, from 0 to 1.
+			 */
+			void setMask(int layer, size_t joint, float weight);
+
+			/**
+			 * @brief Clear the mask of a layer.
+			 *
+			 * Give every joint of a layer the same weight.
+			 *
+			 * @param layer The layer.
+			 * @param weight The weight of the layer on every joint.
+			 */
+			void clearMask(int layer, float weight);
+
+			/**
+			 * @brief Mix the layers.
+			 *
+			 * Apply every layer with some weight in order, starting from the rest pose.
+			 *
+			 * @param result Where the mixed pose is stored.
+			 */
+			void mix(JointPose &result);
+
+		private:
+
+			/**
+			 * @brief A layer of the mixer.
+			 */
+			struct Layer {
+
+				Mode mode;					/// How it is combined.
+				float weight;				/// Its weight.
+				JointPose pose;				/// Its pose.
+				std::vector<float> mask;	/// Its weight on each joint.
+
+			};
+
+			size_t num_joints = 0;			/// The number of joints.
+			std::vector<Layer> layers;		/// The layers, from the bottom.
+			std::vector<float> weights;		/// The weight of the current layer on each joint.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_POSE_MIXER_H_
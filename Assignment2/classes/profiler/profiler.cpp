@@ -0,0 +1,266 @@
+/**
+ * @file profiler.cpp
+ * @brief Profiler class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "profiler.h"
+
+#include <cassert>
+#include <chrono>
+#include <string>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	std::string Profiler::names[PROFILER_MAX_STAGES];
+	int Profiler::depths[PROFILER_MAX_STAGES] = {};
+	int Profiler::num_stages = 0;
+
+	int Profiler::stack[PROFILER_MAX_STAGES] = {};
+	Profiler::Clock::time_point Profiler::starts[PROFILER_MAX_STAGES];
+	bool Profiler::stack_gpu[PROFILER_MAX_STAGES] = {};
+	int Profiler::stack_size = 0;
+
+	float Profiler::cpu_current[PROFILER_MAX_STAGES] = {};
+	float Profiler::cpu_history[PROFILER_MAX_STAGES][PROFILER_HISTORY] = {};
+	float Profiler::gpu_history[PROFILER_MAX_STAGES][PROFILER_HISTORY] = {};
+	bool Profiler::gpu_collected[PROFILER_MAX_STAGES][PROFILER_HISTORY] = {};
+	float Profiler::frame_history[PROFILER_HISTORY] = {};
+
+	GLuint Profiler::queries[PROFILER_LATENCY][PROFILER_MAX_STAGES][2] = {};
+	bool Profiler::issued[PROFILER_LATENCY][PROFILER_MAX_STAGES] = {};
+	long Profiler::slot_frame[PROFILER_LATENCY] = {};
+	bool Profiler::gpu_ready = false;
+
+	Profiler::Clock::time_point Profiler::frame_start;
+	long Profiler::frame = 0;
+
+	void Profiler::beginFrame() {
+
+		// The queries need a context, so create them on the first frame.
+		if (!gpu_ready) {
+
+			glGenQueries(PROFILER_LATENCY * PROFILER_MAX_STAGES * 2, &queries[0][0][0]);
+
+			for (int i = 0; i < PROFILER_LATENCY; i++)
+				slot_frame[i] = -1;
+
+			gpu_ready = true;
+
+		}
+
+		// Store the time since the previous frame started.
+		Clock::time_point now = Clock::now();
+		if (frame > 0)
+			frame_history[(frame - 1) % PROFILER_HISTORY] = std::chrono::duration<float, std::milli>(now - frame_start).count();
+		frame_start = now;
+
+		// Collect the results of the frame that used this slot before, then reuse it.
+		int slot = frame % PROFILER_LATENCY;
+		collect(slot, false);
+		slot_frame[slot] = frame;
+
+	}
+
+	void Profiler::endFrame() {
+
+		// Every stage should have been closed.
+		assert(stack_size == 0);
+
+		// Move the CPU times to the history. GPU times arrive later.
+		for (int i = 0; i < num_stages; i++) {
+
+			cpu_history[i][frame % PROFILER_HISTORY] = cpu_current[i];
+			gpu_history[i][frame % PROFILER_HISTORY] = 0.0f;
+			gpu_collected[i][frame % PROFILER_HISTORY] = false;
+			cpu_current[i] = 0.0f;
+
+		}
+
+		frame++;
+
+	}
+
+	void Profiler::flush() {
+
+		if (!gpu_ready)
+			return;
+
+		for (int slot = 0; slot < PROFILER_LATENCY; slot++)
+			collect(slot, true);
+
+	}
+
+	void Profiler::collect(int slot, bool wait) {
+
+		if (slot_frame[slot] >= 0) {
+
+			for (int i = 0; i < num_stages; i++) {
+
+				if (!issued[slot][i])
+					continue;
+
+				// Drop it rather than wait for it, unless asked to.
+				GLint available = 0;
+				if (!wait)
+					glGetQueryObjectiv(queries[slot][i][1], GL_QUERY_RESULT_AVAILABLE, &available);
+				if (!wait && !available)
+					continue;
+
+				GLuint64 start = 0, end = 0;
+				glGetQueryObjectui64v(queries[slot][i][0], GL_QUERY_RESULT, &start);
+				glGetQueryObjectui64v(queries[slot][i][1], GL_QUERY_RESULT, &end);
+
+				gpu_history[i][slot_frame[slot] % PROFILER_HISTORY] = (end - start) / 1000000.0f;
+				gpu_collected[i][slot_frame[slot] % PROFILER_HISTORY] = true;
+
+			}
+
+		}
+
+		for (int i = 0; i < PROFILER_MAX_STAGES; i++)
+			issued[slot][i] = false;
+		slot_frame[slot] = -1;
+
+	}
+
+	void Profiler::begin(const char *name) {
+
+		assert(stack_size < PROFILER_MAX_STAGES);
+
+		int stage = getStage(name);
+		int slot = frame % PROFILER_LATENCY;
+
+		// Time it on the GPU the first time it is entered this frame.
+		bool gpu = gpu_ready && stage >= 0 && !issued[slot][stage];
+		if (gpu)
+			glQueryCounter(queries[slot][stage][0], GL_TIMESTAMP);
+
+		stack[stack_size] = stage;
+		stack_gpu[stack_size] = gpu;
+		starts[stack_size] = Clock::now();
+		stack_size++;
+
+	}
+
+	void Profiler::end() {
+
+		assert(stack_size > 0);
+
+		stack_size--;
+		int stage = stack[stack_size];
+
+		// Too many stages, it was not timed.
+		if (stage < 0)
+			return;
+
+		cpu_current[stage] += std::chrono::duration<float, std::milli>(Clock::now() - starts[stack_size]).count();
+
+		if (stack_gpu[stack_size]) {
+
+			int slot = frame % PROFILER_LATENCY;
+			glQueryCounter(queries[slot][stage][1], GL_TIMESTAMP);
+			issued[slot][stage] = true;
+
+		}
+
+	}
+
+	int Profiler::getNumStages() {
+
+		return num_stages;
+
+	}
+
+	const char *Profiler::getStageName(int stage) {
+
+		return names[stage].c_str();
+
+	}
+
+	int Profiler::getStageDepth(int stage) {
+
+		return depths[stage];
+
+	}
+
+	float Profiler::getCpuTime(int stage) {
+
+		return average(cpu_history[stage], 0);
+
+	}
+
+	float Profiler::getGpuTime(int stage) {
+
+		return average(gpu_history[stage], gpu_collected[stage]);
+
+	}
+
+	float Profiler::getFrameTime() {
+
+		return average(frame_history, 0);
+
+	}
+
+	const float *Profiler::getFrameTimes() {
+
+		return frame_history;
+
+	}
+
+	int Profiler::getHistoryOffset() {
+
+		return frame % PROFILER_HISTORY;
+
+	}
+
+	int Profiler::getStage(const char *name) {
+
+		for (int i = 0; i < num_stages; i++)
+			if (names[i] == name)
+				return i;
+
+		if (num_stages == PROFILER_MAX_STAGES)
+			return -1;
+
+		// Create it.
+		names[num_stages] = name;
+		depths[num_stages] = stack_size;
+
+		return num_stages++;
+
+	}
+
+	float Profiler::average(const float *history, const bool *valid) {
+
+		// Only the frames that were stored.
+		long stored = frame < PROFILER_HISTORY ? frame : PROFILER_HISTORY;
+
+		float sum = 0.0f;
+		long count = 0;
+		for (long i = 0; i < stored; i++) {
+			if (valid && !valid[i])
+				continue;
+			sum += history[i];
+			count++;
+		}
+
+		if (count == 0)
+			return 0.0f;
+
+		return sum / count;
+
+	}
+
+}  // namespace bgq_opengl
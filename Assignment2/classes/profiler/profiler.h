@@ -0,0 +1,231 @@
+/**
+ * @file profiler.h
+ * @brief Profiler class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_PROFILER_H_
+#define BGQ_OPENGL_CLASSES_PROFILER_H_
+
+#include <chrono>
+#include <string>
+
+#include "GL/glew.h"
+
+#define PROFILER_MAX_STAGES 16      // Maximum number of stages that can be timed.
+#define PROFILER_HISTORY 120        // Number of frames kept in the ring buffers.
+#define PROFILER_LATENCY 4          // Frames to wait before reading the GPU queries back.
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a CPU and GPU frame profiler.
+	 *
+	 * Times named stages of every frame on the CPU with a steady clock and on the
+	 * GPU with timestamp queries. Stages may be nested. GPU results are read back
+	 * PROFILER_LATENCY frames later, and only if they are ready, so the profiler
+	 * never stalls the pipeline. Frames whose GPU results were dropped are left
+	 * out of the GPU averages. Everything is kept in ring buffers of the last
+	 * PROFILER_HISTORY frames.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Profiler {
+
+		public:
+
+			/**
+			 * @brief Start a frame.
+			 *
+			 * Start a frame and collect the GPU results that are already available.
+			 */
+			static void beginFrame();
+
+			/**
+			 * @brief End a frame.
+			 *
+			 * End a frame and store its CPU times in the history.
+			 */
+			static void endFrame();
+
+			/**
+			 * @brief Collect every GPU result.
+			 *
+			 * Wait for the queries still in flight and store their results, so the
+			 * last frames count too. It stalls, so it is meant for the end of a run.
+			 */
+			static void flush();
+
+			/**
+			 * @brief Start timing a stage.
+			 *
+			 * Start timing a stage. Stages are created the first time they are used.
+			 * If a stage is entered several times in a frame the CPU times are added,
+			 * and only the first one is timed on the GPU.
+			 *
+			 * @param name The name of the stage.
+			 */
+			static void begin(const char *name);
+
+			/**
+			 * @brief Stop timing a stage.
+			 *
+			 * Stop timing the last stage that was started.
+			 */
+			static void end();
+
+			/**
+			 * @brief Get the number of stages.
+			 *
+			 * Get the number of stages seen so far.
+			 *
+			 * @returns The number of stages.
+			 */
+			static int getNumStages();
+
+			/**
+			 * @brief Get the name of a stage.
+			 *
+			 * Get the name of a stage.
+			 *
+			 * @param stage The stage.
+			 *
+			 * @returns The name.
+			 */
+			static const char *getStageName(int stage);
+
+			/**
+			 * @brief Get the nesting depth of a stage.
+			 *
+			 * Get how many stages were open when a stage was first started.
+			 *
+			 * @param stage The stage.
+			 *
+			 * @returns The depth, 0 for top level stages.
+			 */
+			static int getStageDepth(int stage);
+
+			/**
+			 * @brief Get the CPU time of a stage.
+			 *
+			 * Get the average CPU time of a stage over the history.
+			 *
+			 * @param stage The stage.
+			 *
+			 * @returns The time in milliseconds.
+			 */
+			static float getCpuTime(int stage);
+
+			/**
+			 * @brief Get the GPU time of a stage.
+			 *
+			 * Get the average GPU time of a stage over the frames of the history whose
+			 * results were collected.
+			 *
+			 * @param stage The stage.
+			 *
+			 * @returns The time in milliseconds.
+			 */
+			static float getGpuTime(int stage);
+
+			/**
+			 * @brief Get the frame time.
+			 *
+			 * Get the average CPU time between two frame starts over the history.
+			 *
+			 * @returns The time in milliseconds.
+			 */
+			static float getFrameTime();
+
+			/**
+			 * @brief Get the frame time history.
+			 *
+			 * Get the ring buffer of frame times, to be read from getHistoryOffset().
+			 *
+			 * @returns The PROFILER_HISTORY frame times in milliseconds.
+			 */
+			static const float *getFrameTimes();
+
+			/**
+			 * @brief Get the oldest entry of the history.
+			 *
+			 * Get the position of the oldest frame in the ring buffers.
+			 *
+			 * @returns The position.
+			 */
+			static int getHistoryOffset();
+
+		private:
+
+			/**
+			 * @brief Get a stage.
+			 *
+			 * Get the index of a stage, creating it if it does not exist yet.
+			 *
+			 * @param name The name of the stage.
+			 *
+			 * @returns The index, or -1 if there are too many stages.
+			 */
+			static int getStage(const char *name);
+
+			/**
+			 * @brief Collect the GPU results of a query slot.
+			 *
+			 * Store the GPU times of the frame that used a query slot and free it.
+			 *
+			 * @param slot The query slot.
+			 * @param wait Whether to wait for the results that are not ready, or drop them.
+			 */
+			static void collect(int slot, bool wait);
+
+			/**
+			 * @brief Get the average of a ring buffer.
+			 *
+			 * Get the average of the frames stored in a ring buffer.
+			 *
+			 * @param history The ring buffer.
+			 * @param valid Which frames to count, or 0 to count all of them.
+			 *
+			 * @returns The average.
+			 */
+			static float average(const float *history, const bool *valid);
+
+			typedef std::chrono::steady_clock Clock;
+
+			static std::string names[PROFILER_MAX_STAGES];					/// The names of the stages.
+			static int depths[PROFILER_MAX_STAGES];							/// The nesting depth of the stages.
+			static int num_stages;											/// The number of stages.
+
+			static int stack[PROFILER_MAX_STAGES];							/// The stages currently open.
+			static Clock::time_point starts[PROFILER_MAX_STAGES];			/// When the open stages started.
+			static bool stack_gpu[PROFILER_MAX_STAGES];						/// Whether the open stages are timed on the GPU.
+			static int stack_size;											/// The number of stages currently open.
+
+			static float cpu_current[PROFILER_MAX_STAGES];					/// CPU time of the stages in this frame.
+			static float cpu_history[PROFILER_MAX_STAGES][PROFILER_HISTORY];	/// CPU time of the stages.
+			static float gpu_history[PROFILER_MAX_STAGES][PROFILER_HISTORY];	/// GPU time of the stages.
+			static bool gpu_collected[PROFILER_MAX_STAGES][PROFILER_HISTORY];	/// Whether the GPU time of the stages arrived.
+			static float frame_history[PROFILER_HISTORY];					/// Time between frame starts.
+
+			static GLuint queries[PROFILER_LATENCY][PROFILER_MAX_STAGES][2];	/// Start and end timestamp queries.
+			static bool issued[PROFILER_LATENCY][PROFILER_MAX_STAGES];		/// Whether the queries were issued.
+			static long slot_frame[PROFILER_LATENCY];						/// The frame each query slot belongs to.
+			static bool gpu_ready;											/// Whether the queries were created.
+
+			static Clock::time_point frame_start;							/// When the current frame started.
+			static long frame;												/// The current frame.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_PROFILER_H_
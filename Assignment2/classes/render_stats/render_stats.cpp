@@ -0,0 +1,82 @@
+/**
+ * @file render_stats.cpp
+ * @brief RenderStats class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "render_stats.h"
+
+namespace bgq_opengl {
+
+	unsigned int RenderStats::drawn = 0;
+	unsigned int RenderStats::culled = 0;
+	unsigned int RenderStats::triangles = 0;
+	unsigned int RenderStats::matrices = 0;
+
+	void RenderStats::addDrawn(unsigned int count) {
+
+		drawn += count;
+
+	}
+
+	void RenderStats::addCulled(unsigned int count) {
+
+		culled += count;
+
+	}
+
+	void RenderStats::addTriangles(unsigned int count) {
+
+		triangles += count;
+
+	}
+
+	void RenderStats::addMatrices(unsigned int count) {
+
+		matrices += count;
+
+	}
+
+	unsigned int RenderStats::getDrawn() {
+
+		return drawn;
+
+	}
+
+	unsigned int RenderStats::getCulled() {
+
+		return culled;
+
+	}
+
+	unsigned int RenderStats::getTriangles() {
+
+		return triangles;
+
+	}
+
+	unsigned int RenderStats::getMatrices() {
+
+		return matrices;
+
+	}
+
+	void RenderStats::reset() {
+
+		drawn = 0;
+		culled = 0;
+		triangles = 0;
+		matrices = 0;
+
+	}
+
+}  // namespace bgq_opengl
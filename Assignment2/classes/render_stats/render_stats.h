@@ -0,0 +1,123 @@
+/**
+ * @file render_stats.h
+ * @brief RenderStats class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RENDER_STATS_H_
+#define BGQ_OPENGL_CLASSES_RENDER_STATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of the per frame render counters.
+	 *
+	 * Counts the segments that were drawn and the ones that visibility culling
+	 * skipped during the current frame, and the node matrices that were uploaded.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class RenderStats {
+
+		public:
+
+			/**
+			 * @brief Count drawn segments.
+			 *
+			 * Count segments that were submitted to OpenGL.
+			 *
+			 * @param count The number of segments.
+			 */
+			static void addDrawn(unsigned int count);
+
+			/**
+			 * @brief Count culled segments.
+			 *
+			 * Count segments that were skipped because they were not visible.
+			 *
+			 * @param count The number of segments.
+			 */
+			static void addCulled(unsigned int count);
+
+			/**
+			 * @brief Count drawn triangles.
+			 *
+			 * Count triangles that were submitted to OpenGL.
+			 *
+			 * @param count The number of triangles.
+			 */
+			static void addTriangles(unsigned int count);
+
+			/**
+			 * @brief Count uploaded matrices.
+			 *
+			 * Count node matrices that were written to the matrix stream.
+			 *
+			 * @param count The number of matrices.
+			 */
+			static void addMatrices(unsigned int count);
+
+			/**
+			 * @brief Get the drawn segments.
+			 *
+			 * Get the number of segments drawn since the last reset.
+			 *
+			 * @returns The number of segments.
+			 */
+			static unsigned int getDrawn();
+
+			/**
+			 * @brief Get the culled segments.
+			 *
+			 * Get the number of segments culled since the last reset.
+			 *
+			 * @returns The number of segments.
+			 */
+			static unsigned int getCulled();
+
+			/**
+			 * @brief Get the drawn triangles.
+			 *
+			 * Get the number of triangles drawn since the last reset.
+			 *
+			 * @returns The number of triangles.
+			 */
+			static unsigned int getTriangles();
+
+			/**
+			 * @brief Get the uploaded matrices.
+			 *
+			 * Get the number of node matrices uploaded since the last reset.
+			 *
+			 * @returns The number of matrices.
+			 */
+			static unsigned int getMatrices();
+
+			/**
+			 * @brief Reset the counters.
+			 *
+			 * Reset the counters, to be called at the start of every frame.
+			 */
+			static void reset();
+
+		private:
+
+			static unsigned int drawn;		/// Segments drawn this frame.
+			static unsigned int culled;		/// Segments culled this frame.
+			static unsigned int triangles;	/// Triangles drawn this frame.
+			static unsigned int matrices;	/// Node matrices uploaded this frame.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_RENDER_STATS_H_
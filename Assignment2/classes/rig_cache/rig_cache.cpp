@@ -0,0 +1,303 @@
+/**
+ * @file rig_cache.cpp
+ * @brief RigCache class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "rig_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/helpful/helpful.h"
+#include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
+
+namespace bgq_opengl {
+
+	static_assert(std::is_trivially_copyable<RigCache::Record>::value, "Rig records are written as they are in memory.");
+
+	namespace {
+
+		// Append some bytes to the buffers, aligned to 4 bytes, and get where they start.
+		unsigned long long append(std::vector<unsigned char> &data, const void *bytes, size_t size) {
+
+			data.resize((data.size() + 3) & ~(size_t) 3);
+			unsigned long long offset = data.size();
+
+			data.resize(data.size() + size);
+			if (size > 0)
+				memcpy(data.data() + offset, bytes, size);
+
+			return offset;
+
+		}
+
+	}
+
+	bool RigCache::rebuild = false;
+
+	RigCache::RigCache() {}
+
+	RigCache::~RigCache() {
+
+		this->close();
+
+	}
+
+	bool RigCache::open(const std::string &path, unsigned long long key) {
+
+		if (!this->file.open(path) || this->file.getSize() < sizeof(Header))
+			return false;
+
+		this->mapping = this->file.getData();
+		this->size = this->file.getSize();
+
+		// Check the header and that every record fits before anything reads them.
+		const Header *header = (const Header *) this->mapping;
+		bool valid = header->magic == RIG_CACHE_MAGIC && header->version == RIG_CACHE_VERSION && header->key == key && header->record_size == sizeof(Record) &&
+			header->data_offset == sizeof(Header) + (unsigned long long) header->num_records * sizeof(Record) &&
+			header->data_offset + header->data_size == this->size;
+
+		for (uint32_t i = 0; valid && i < header->num_records; i++) {
+
+			const Record &record = this->getRecords()[i];
+			valid = record.num_attributes <= RIG_CACHE_MAX_ATTRIBUTES && record.num_lods >= 1 && record.num_lods <= RIG_CACHE_MAX_LODS &&
+				(record.index_type == GL_UNSIGNED_SHORT || record.index_type == GL_UNSIGNED_INT) &&
+				record.vertex_offset + record.vertex_size <= header->data_size &&
+				record.index_offset + record.index_size <= header->data_size &&
+				record.control_offset + record.num_control * 3 * sizeof(float) <= header->data_size;
+
+		}
+
+		if (!valid) {
+			this->close();
+			return false;
+		}
+
+		return true;
+
+	}
+
+	void RigCache::close() {
+
+		this->file.close();
+		this->mapping = 0;
+		this->size = 0;
+
+	}
+
+	uint32_t RigCache::getNumRecords() const {
+
+		return this->mapping ? ((const Header *) this->mapping)->num_records : 0;
+
+	}
+
+	const RigCache::Record *RigCache::getRecords() const {
+
+		return (const Record *) (this->mapping + sizeof(Header));
+
+	}
+
+	const RigCache::Record *RigCache::find(const int id) const {
+
+		for (uint32_t i = 0; i < this->getNumRecords(); i++)
+			if (this->getRecords()[i].id == id)
+				return &this->getRecords()[i];
+
+		return 0;
+
+	}
+
+	const void *RigCache::getData(unsigned long long offset) const {
+
+		return this->mapping + ((const Header *) this->mapping)->data_offset + offset;
+
+	}
+
+	VertexLayout RigCache::getLayout(const Record &record) {
+
+		VertexLayout layout;
+		layout.format = (VertexLayout::Format) record.format;
+		layout.stride = record.stride;
+		layout.attributes.assign(record.attributes, record.attributes + record.num_attributes);
+		layout.position_scale = RigCache::getVector(record.position_scale);
+		layout.position_offset = RigCache::getVector(record.position_offset);
+		layout.oct_normals = record.oct_normals != 0;
+
+		return layout;
+
+	}
+
+	RigCache::Record RigCache::pack(const int id, const int parent, const VertexLayout &layout, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<std::vector<GLuint>> &lods, std::vector<unsigned char> &data) {
+
+		// Clear the padding too, so the same rig always gives the same file.
+		Record record;
+		memset((void *) &record, 0, sizeof(record));
+
+		record.id = id;
+		record.parent = parent;
+		record.format = layout.format;
+		record.stride = layout.stride;
+		RigCache::setVector(record.position_scale, layout.position_scale);
+		RigCache::setVector(record.position_offset, layout.position_offset);
+		record.oct_normals = layout.oct_normals;
+		record.num_attributes = (uint32_t) std::min(layout.attributes.size(), (size_t) RIG_CACHE_MAX_ATTRIBUTES);
+		for (uint32_t i = 0; i < record.num_attributes; i++)
+			record.attributes[i] = layout.attributes[i];
+
+		// Get the bounding box of the positions.
+		if (!vertices.empty()) {
+			BoundingBox bb{vertices[0].position, vertices[0].position};
+			for (size_t i = 1; i < vertices.size(); i++) {
+				bb.min = glm::min(bb.min, vertices[i].position);
+				bb.max = glm::max(bb.max, vertices[i].position);
+			}
+			RigCache::setVector(record.bounds_min, bb.min);
+			RigCache::setVector(record.bounds_max, bb.max);
+		}
+
+		// Put every level of detail one after the other, as the Geometry does.
+		std::vector<GLuint> all_indices = indices;
+		record.num_lods = 1;
+		record.lod_offsets[0] = 0;
+		record.lod_counts[0] = (int32_t) indices.size();
+		for (size_t i = 0; i < lods.size() && record.num_lods < RIG_CACHE_MAX_LODS; i++) {
+			record.lod_offsets[record.num_lods] = (int32_t) all_indices.size();
+			record.lod_counts[record.num_lods] = (int32_t) lods[i].size();
+			all_indices.insert(all_indices.end(), lods[i].begin(), lods[i].end());
+			record.num_lods++;
+		}
+
+		// Pack the vertices in the layout.
+		std::vector<unsigned char> packed = layout.pack(vertices);
+		record.vertex_size = packed.size();
+		record.vertex_offset = append(data, packed.data(), packed.size());
+
+		// Use 16 bits indices whenever every vertex can be addressed with them.
+		record.index_type = vertices.size() <= 0x10000 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		if (record.index_type == GL_UNSIGNED_SHORT) {
+			std::vector<GLushort> short_indices(all_indices.begin(), all_indices.end());
+			record.index_size = short_indices.size() * sizeof(GLushort);
+			record.index_offset = append(data, short_indices.data(), record.index_size);
+		} else {
+			record.index_size = all_indices.size() * sizeof(GLuint);
+			record.index_offset = append(data, all_indices.data(), record.index_size);
+		}
+
+		return record;
+
+	}
+
+	void RigCache::packControlPoints(Record &record, const glm::vec3 &anchor, const std::vector<glm::vec3> &control, std::vector<unsigned char> &data) {
+
+		RigCache::setVector(record.anchor, anchor);
+
+		std::vector<float> points(control.size() * 3);
+		for (size_t i = 0; i < control.size(); i++)
+			RigCache::setVector(&points[i * 3], control[i]);
+
+		record.num_control = (uint32_t) control.size();
+		record.control_offset = append(data, points.data(), points.size() * sizeof(float));
+
+	}
+
+	bool RigCache::write(const std::string &path, unsigned long long key, const std::vector<Record> &records, const std::vector<unsigned char> &data) {
+
+		Header header;
+		memset(&header, 0, sizeof(header));
+		header.magic = RIG_CACHE_MAGIC;
+		header.version = RIG_CACHE_VERSION;
+		header.key = key;
+		header.num_records = (uint32_t) records.size();
+		header.record_size = sizeof(Record);
+		header.data_offset = sizeof(Header) + records.size() * sizeof(Record);
+		header.data_size = data.size();
+
+		// Failing here only means the model is loaded from the file next time too.
+		return Helpful::writeFileAtomically(path, [&](std::ofstream &out) {
+			out.write((const char *) &header, sizeof(header));
+			out.write((const char *) records.data(), records.size() * sizeof(Record));
+			out.write((const char *) data.data(), data.size());
+		});
+
+	}
+
+	unsigned long long RigCache::getKey(const char *filename, const std::vector<int> &indexes, const std::vector<int> &parents, const char *first, const char *middle, const char *end) {
+
+		// A model that changed on disk gets a new key.
+		std::error_code error;
+		unsigned long long file_size = std::filesystem::file_size(filename, error);
+		long long file_time = std::filesystem::last_write_time(filename, error).time_since_epoch().count();
+
+		// Hash the model file and everything the loading depends on.
+		unsigned int processing = RIG_CACHE_PROCESSING;
+		unsigned long long hash = HELPFUL_HASH_SEED;
+		hash = Helpful::hashBytes(hash, &processing, sizeof(processing));
+		hash = Helpful::hashBytes(hash, &file_size, sizeof(file_size));
+		hash = Helpful::hashBytes(hash, &file_time, sizeof(file_time));
+		hash = Helpful::hashBytes(hash, filename, strlen(filename));
+		hash = Helpful::hashBytes(hash, indexes.data(), indexes.size() * sizeof(int));
+		hash = Helpful::hashBytes(hash, parents.data(), parents.size() * sizeof(int));
+		hash = Helpful::hashBytes(hash, first, strlen(first));
+		hash = Helpful::hashBytes(hash, middle, strlen(middle));
+		hash = Helpful::hashBytes(hash, end, strlen(end));
+
+		return hash;
+
+	}
+
+	std::string RigCache::getPath(const char *filename) {
+
+		return std::string(RIG_CACHE_DIRECTORY) + "/" + std::filesystem::path(filename).filename().string() + ".rig";
+
+	}
+
+	glm::vec3 RigCache::getVector(const float *values) {
+
+		return glm::vec3(values[0], values[1], values[2]);
+
+	}
+
+	void RigCache::setVector(float *values, const glm::vec3 &vector) {
+
+		values[0] = vector.x;
+		values[1] = vector.y;
+		values[2] = vector.z;
+
+	}
+
+	void RigCache::setRebuild(bool rebuild) {
+
+		RigCache::rebuild = rebuild;
+
+	}
+
+	bool RigCache::getRebuild() {
+
+		return RigCache::rebuild;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,303 @@
+/**
+ * @file rig_cache.h
+ * @brief RigCache class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RIG_CACHE_H_
+#define BGQ_OPENGL_CLASSES_RIG_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/mapped_file/mapped_file.h"
+#include "classes/mesh_optimizer/mesh_optimizer.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/vertex/vertex.h"
+#include "structs/vertex_layout/vertex_layout.h"
+
+#define RIG_CACHE_DIRECTORY "rig_cache"             // Where preprocessed rigs are kept between runs.
+#define RIG_CACHE_MAGIC 0x52514742                  // "BGQR", the first bytes of every cached rig.
+#define RIG_CACHE_VERSION 2                         // Changes every time the layout of the file does, not its contents.
+#define RIG_CACHE_PROCESSING 4                      // Changes every time the optimizer or the vertex packing change the cached bytes.
+#define RIG_CACHE_MAX_ATTRIBUTES 6                  // Maximum number of vertex attributes of a node.
+#define RIG_CACHE_MAX_LODS MESH_OPTIMIZER_LOD_LEVELS // Maximum number of levels of detail of a node.
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a preprocessed rig cache.
+	 *
+	 * Keeps a hierarchical model as it is once loaded: the packed vertices and
+	 * indices of every node exactly as they go to the GPU, the hierarchy and the
+	 * anchor and control points. The file is a header and a table of fixed size
+	 * records followed by the raw buffers, and is mapped in memory so that the
+	 * buffers are handed to OpenGL straight from the file without parsing.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class RigCache {
+
+		public:
+
+			/**
+			 * @brief The header of a cached rig.
+			 */
+			struct Header {
+
+				uint32_t magic;					/// Always RIG_CACHE_MAGIC.
+				uint32_t version;				/// Always RIG_CACHE_VERSION.
+				unsigned long long key;			/// The key of the model and parameters it was built from.
+				uint32_t num_records;			/// Number of nodes.
+				uint32_t record_size;			/// Size of a record, to reject files from other builds.
+				unsigned long long data_offset;	/// Where the buffers start.
+				unsigned long long data_size;	/// Size of the buffers.
+
+			};
+
+			/**
+			 * @brief A node of a cached rig.
+			 *
+			 * Offsets are relative to the start of the buffers, and control points are
+			 * stored as three floats each.
+			 */
+			struct Record {
+
+				int32_t id;											/// The id of the node.
+				int32_t parent;										/// The id of its parent.
+				int32_t format;										/// The VertexLayout format.
+				int32_t stride;										/// Size in bytes of a vertex.
+				float position_scale[3];							/// Scale that decodes positions.
+				float position_offset[3];							/// Offset that decodes positions.
+				float bounds_min[3];								/// Minimum of the bounding box.
+				float bounds_max[3];								/// Maximum of the bounding box.
+				float anchor[3];									/// The anchor point.
+				int32_t oct_normals;								/// Whether normals are octahedral encoded.
+				uint32_t num_attributes;							/// Number of vertex attributes.
+				VertexAttribute attributes[RIG_CACHE_MAX_ATTRIBUTES];	/// The vertex attributes.
+				uint32_t index_type;								/// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+				uint32_t num_lods;									/// Number of levels of detail, the full mesh included.
+				int32_t lod_offsets[RIG_CACHE_MAX_LODS];			/// First index of each level of detail.
+				int32_t lod_counts[RIG_CACHE_MAX_LODS];				/// Number of indices of each level of detail.
+				uint32_t num_control;								/// Number of control points.
+				unsigned long long vertex_offset;					/// Where the packed vertices are.
+				unsigned long long vertex_size;						/// Size of the packed vertices.
+				unsigned long long index_offset;					/// Where the packed indices are.
+				unsigned long long index_size;						/// Size of the packed indices.
+				unsigned long long control_offset;					/// Where the control points are.
+
+			};
+
+			/**
+			 * @brief Initializes an empty cache.
+			 *
+			 * Initializes a cache with no file open.
+			 */
+			RigCache();
+
+			/**
+			 * @brief Closes the cache.
+			 *
+			 * Unmaps the file if there is one.
+			 */
+			~RigCache();
+
+			RigCache(const RigCache &) = delete;
+			RigCache &operator=(const RigCache &) = delete;
+
+			/**
+			 * @brief Open a cached rig.
+			 *
+			 * Map a cached rig in memory and check that it is complete and was built
+			 * from the same model and parameters.
+			 *
+			 * @param path The path of the file.
+			 * @param key The key it has to have been built with.
+			 *
+			 * @returns Whether it could be used.
+			 */
+			bool open(const std::string &path, unsigned long long key);
+
+			/**
+			 * @brief Close the cached rig.
+			 *
+			 * Unmap the file. The buffers of its records cannot be read afterwards.
+			 */
+			void close();
+
+			/**
+			 * @brief Get the number of records.
+			 *
+			 * @returns The number of nodes in the file.
+			 */
+			uint32_t getNumRecords() const;
+
+			/**
+			 * @brief Get the records.
+			 *
+			 * @returns The nodes in the file, children before their parents.
+			 */
+			const Record *getRecords() const;
+
+			/**
+			 * @brief Find a record.
+			 *
+			 * @param id The id of the node.
+			 *
+			 * @returns The record, or 0 if there is none.
+			 */
+			const Record *find(const int id) const;
+
+			/**
+			 * @brief Get a buffer.
+			 *
+			 * @param offset The offset of the buffer.
+			 *
+			 * @returns A pointer to the mapped buffer.
+			 */
+			const void *getData(unsigned long long offset) const;
+
+			/**
+			 * @brief Get the vertex layout of a record.
+			 *
+			 * @param record The record.
+			 *
+			 * @returns The layout its vertices are packed in.
+			 */
+			static VertexLayout getLayout(const Record &record);
+
+			/**
+			 * @brief Pack a node.
+			 *
+			 * Pack the vertices and indices of a node as the Geometry would, appending
+			 * them to the buffers, and describe them in a record. Its anchor and control
+			 * points are left empty.
+			 *
+			 * @param id The id of the node.
+			 * @param parent The id of its parent.
+			 * @param layout The layout to pack the vertices in.
+			 * @param vertices The vertices.
+			 * @param indices The indices of the full mesh.
+			 * @param lods The indices of the simplified levels.
+			 * @param data The buffers to append to.
+			 *
+			 * @returns The record.
+			 */
+			static Record pack(const int id, const int parent, const VertexLayout &layout, const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<std::vector<GLuint>> &lods, std::vector<unsigned char> &data);
+
+			/**
+			 * @brief Pack the points of a node.
+			 *
+			 * Store the anchor and control points of a node, appending the latter to
+			 * the buffers.
+			 *
+			 * @param record The record of the node.
+			 * @param anchor The anchor point.
+			 * @param control The control points.
+			 * @param data The buffers to append to.
+			 */
+			static void packControlPoints(Record &record, const glm::vec3 &anchor, const std::vector<glm::vec3> &control, std::vector<unsigned char> &data);
+
+			/**
+			 * @brief Write a cached rig.
+			 *
+			 * Write the records and buffers of a rig. It is written aside and moved in
+			 * place, so that a half written file is never read.
+			 *
+			 * @param path The path of the file.
+			 * @param key The key of the model and parameters.
+			 * @param records The nodes, children before their parents.
+			 * @param data The buffers.
+			 *
+			 * @returns Whether it could be written.
+			 */
+			static bool write(const std::string &path, unsigned long long key, const std::vector<Record> &records, const std::vector<unsigned char> &data);
+
+			/**
+			 * @brief Get the key of a model.
+			 *
+			 * Hash the size and modification time of a model together with the
+			 * parameters it is loaded with and RIG_CACHE_PROCESSING, so rigs processed
+			 * differently are built again.
+			 *
+			 * @param filename The path of the model.
+			 * @param indexes The mesh of each node.
+			 * @param parents The parent of each node.
+			 * @param first How the anchor of the root is placed.
+			 * @param middle How the anchors of the other nodes are placed.
+			 * @param end How the control points of the leaves are placed.
+			 *
+			 * @returns The key.
+			 */
+			static unsigned long long getKey(const char *filename, const std::vector<int> &indexes, const std::vector<int> &parents, const char *first, const char *middle, const char *end);
+
+			/**
+			 * @brief Get the path of the cached rig of a model.
+			 *
+			 * @param filename The path of the model.
+			 *
+			 * @returns The path of its cached rig.
+			 */
+			static std::string getPath(const char *filename);
+
+			/**
+			 * @brief Read a vector.
+			 *
+			 * @param values The three floats of the vector, as stored in the file.
+			 *
+			 * @returns The vector.
+			 */
+			static glm::vec3 getVector(const float *values);
+
+			/**
+			 * @brief Write a vector.
+			 *
+			 * @param values Where to store the three floats of the vector.
+			 * @param vector The vector.
+			 */
+			static void setVector(float *values, const glm::vec3 &vector);
+
+			/**
+			 * @brief Rebuild every rig.
+			 *
+			 * Ignore the cached rigs so that every model is loaded again and its cache
+			 * rewritten, used to bake them offline.
+			 *
+			 * @param rebuild Whether to ignore them.
+			 */
+			static void setRebuild(bool rebuild);
+
+			/**
+			 * @brief Whether every rig is rebuilt.
+			 *
+			 * @returns Whether the cached rigs are ignored.
+			 */
+			static bool getRebuild();
+
+		private:
+
+			MappedFile file;						/// The mapped file.
+			const unsigned char *mapping = 0;		/// The contents of the file while it is valid.
+			size_t size = 0;						/// Size of the file.
+
+			static bool rebuild;					/// Whether the cached rigs are ignored.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_RIG_CACHE_H_
@@ -16,10 +16,13 @@
 #include "shader.h"
 
 #include <string>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <exception>
+#include <vector>
 
 #include "GL/glew.h"
 #define GLM_ENABLE_EXPERIMENTAL
@@ -27,8 +30,10 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "classes/camera/camera.h"
+#include "classes/gl_state/gl_state.h"
 #include "classes/light/light.h"
 #include "classes/texture/texture.h"
+#include "structs/helpful/helpful.h"
 
 namespace bgq_opengl {
 
@@ -70,6 +75,15 @@ namespace bgq_opengl {
 
         }
 
+        // Try the binary linked by a previous run before compiling anything.
+        unsigned long long key = Shader::getCacheKey(vertex_source_code, fragment_source_code);
+        char key_hex[17];
+        snprintf(key_hex, sizeof(key_hex), "%016llx", key);
+        std::string cache_path = std::string(SHADER_CACHE_DIRECTORY) + "/" + key_hex + ".bin";
+
+        if (this->loadBinary(cache_path, key))
+            return;
+
         // Convert it to char.
         const char* vertex_code_char = vertex_source_code.c_str();
         const char* fragment_code_char = fragment_source_code.c_str();
@@ -107,6 +121,10 @@ namespace bgq_opengl {
         glAttachShader(this->programID, vertex);
         glAttachShader(this->programID, fragment);
 
+        // Ask the driver to keep the binary around so it can be cached.
+        if (Shader::binariesSupported())
+            glProgramParameteri(this->programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
         // Link this program and check for program errors.
         glLinkProgram(this->programID);
         error_msg = "";
@@ -122,6 +140,9 @@ namespace bgq_opengl {
         glDeleteShader(vertex);
         glDeleteShader(fragment);
 
+        // Keep the linked program for the next run.
+        this->saveBinary(cache_path, key);
+
         /*
         // Validate the program.
         glValidateProgram(this->programID);
@@ -147,7 +168,7 @@ namespace bgq_opengl {
         if (this->programID == -1)
             throw std::runtime_error("Shader was not initialized.");
 
-        glUseProgram(this->programID);
+        GLState::useProgram(this->programID);
 
     }
 
@@ -157,7 +178,7 @@ namespace bgq_opengl {
 
     }
 
-    void Shader::passCamera(Camera camera) {
+    void Shader::passCamera(Camera &camera) {
 
         // Pass the View matrix to the shader.
         glm::mat4 view_matrix = camera.getView();
@@ -200,7 +221,7 @@ namespace bgq_opengl {
         int slot = cubemap.getSlot();
         
         // Activate this texture.
-        glActiveTexture(GL_TEXTURE0 + slot);
+        GLState::activeTexture(slot);
 
         // Sets the value of the texture uniform.
         glUniform1i(location, slot);
@@ -241,7 +262,7 @@ namespace bgq_opengl {
         int slot = texture.getSlot();
         
         // Activate this texture.
-        glActiveTexture(GL_TEXTURE0 + slot);
+        GLState::activeTexture(slot);
 
         // Sets the value of the texture uniform.
         glUniform1i(location, slot);
@@ -308,6 +329,7 @@ namespace bgq_opengl {
     void Shader::remove() {
 
         glDeleteProgram(this->programID);
+        GLState::forgetProgram(this->programID);
 
     }
 
@@ -381,4 +403,106 @@ namespace bgq_opengl {
 
     }
 
+    bool Shader::binariesSupported() {
+
+        // Program binaries are core since OpenGL 4.1, but drivers may offer no format at all.
+        static int supported = -1;
+        if (supported == -1) {
+            GLint formats = 0;
+            if (GLEW_ARB_get_program_binary)
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            supported = formats > 0;
+        }
+
+        return supported == 1;
+
+    }
+
+    unsigned long long Shader::getCacheKey(const std::string &vertex_source, const std::string &fragment_source) {
+
+        // Hash the sources and the strings that identify the driver.
+        unsigned long long hash = HELPFUL_HASH_SEED;
+        hash = Helpful::hashBytes(hash, vertex_source.data(), vertex_source.size());
+        hash = Helpful::hashBytes(hash, fragment_source.data(), fragment_source.size());
+
+        const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+        for (GLenum name : names) {
+            const char *value = (const char *) glGetString(name);
+            if (value)
+                hash = Helpful::hashBytes(hash, value, std::char_traits<char>::length(value));
+        }
+
+        return hash;
+
+    }
+
+    bool Shader::loadBinary(const std::string &path, unsigned long long key) {
+
+        if (!Shader::binariesSupported())
+            return false;
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+
+        // Check the header before handing anything to the driver.
+        uint32_t magic = 0;
+        unsigned long long stored_key = 0;
+        GLenum format = 0;
+        uint32_t length = 0;
+        in.read((char *) &magic, sizeof(magic));
+        in.read((char *) &stored_key, sizeof(stored_key));
+        in.read((char *) &format, sizeof(format));
+        in.read((char *) &length, sizeof(length));
+
+        if (!in || magic != SHADER_CACHE_MAGIC || stored_key != key || length == 0)
+            return false;
+
+        std::vector<char> binary(length);
+        if (!in.read(binary.data(), length))
+            return false;
+
+        // The driver may still reject it, for instance after an update.
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, format, binary.data(), length);
+
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            glDeleteProgram(program);
+            return false;
+        }
+
+        this->programID = program;
+        return true;
+
+    }
+
+    void Shader::saveBinary(const std::string &path, unsigned long long key) {
+
+        if (!Shader::binariesSupported())
+            return;
+
+        GLint length = 0;
+        glGetProgramiv(this->programID, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        GLenum format = 0;
+        std::vector<char> binary(length);
+        glGetProgramBinary(this->programID, length, &length, &format, binary.data());
+
+        // Failing here only means the program is compiled next time too.
+        Helpful::writeFileAtomically(path, [&](std::ofstream &out) {
+            uint32_t magic = SHADER_CACHE_MAGIC;
+            uint32_t size = (uint32_t) length;
+            out.write((const char *) &magic, sizeof(magic));
+            out.write((const char *) &key, sizeof(key));
+            out.write((const char *) &format, sizeof(format));
+            out.write((const char *) &size, sizeof(size));
+            out.write(binary.data(), length);
+        });
+
+    }
+
 }  // namespace bgq_opengl
@@ -25,6 +25,9 @@
 #include "classes/light/light.h"
 #include "classes/texture/texture.h"
 
+#define SHADER_CACHE_DIRECTORY "shader_cache"    // Where linked program binaries are kept between runs.
+#define SHADER_CACHE_MAGIC 0x50514742           // "BGQP", the first bytes of every cached binary.
+
 namespace bgq_opengl {
     
     /**
@@ -49,7 +52,10 @@ namespace bgq_opengl {
         /**
          * @brief Construct the shader instance.
          *
-         * Construct the shader instance by passing the shaders' files.
+         * Construct the shader instance by passing the shaders' files. The linked
+         * program is cached in SHADER_CACHE_DIRECTORY, keyed by the sources and the
+         * driver, and loaded from there on later runs. A stale or rejected binary is
+         * compiled again and replaced.
          *
          * @param vertex_filename Vertex shader filename.
          * @param fragment_filename Fragment shader filename.
@@ -89,7 +95,7 @@ namespace bgq_opengl {
          *
          * @param camera The camera.
          */
-        void passCamera(Camera camera);
+        void passCamera(Camera &camera);
         
         /**
          * @brief Pass a cubemap to the shader.
@@ -232,6 +238,52 @@ namespace bgq_opengl {
          */
         static void readFileContents(const char* filename, std::string *file_contents);
 
+        /**
+         * @brief Check whether program binaries can be used.
+         *
+         * Check whether the driver can retrieve program binaries and offers at least
+         * one format for them.
+         *
+         * @returns True if program binaries can be cached.
+         */
+        static bool binariesSupported();
+
+        /**
+         * @brief Get the cache key of a program.
+         *
+         * Hash the sources of a program together with the vendor, renderer and
+         * version of the driver, so binaries from another driver are never used.
+         *
+         * @param vertex_source The vertex shader source.
+         * @param fragment_source The fragment shader source.
+         *
+         * @returns The key.
+         */
+        static unsigned long long getCacheKey(const std::string &vertex_source, const std::string &fragment_source);
+
+        /**
+         * @brief Load the program from the cache.
+         *
+         * Create the program from a cached binary if it belongs to the key and the
+         * driver accepts it.
+         *
+         * @param path The path of the cached binary.
+         * @param key The cache key of the program.
+         *
+         * @returns True if the program was loaded.
+         */
+        bool loadBinary(const std::string &path, unsigned long long key);
+
+        /**
+         * @brief Store the program in the cache.
+         *
+         * Write the binary of the linked program to the cache, if the driver gives it.
+         *
+         * @param path The path of the cached binary.
+         * @param key The cache key of the program.
+         */
+        void saveBinary(const std::string &path, unsigned long long key);
+
         Light* light; /// The light that will be used in the shader.
         unsigned int programID = -1; /// OpenGL ID for this shader program.
 
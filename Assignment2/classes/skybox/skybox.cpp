@@ -26,6 +26,9 @@
 #include "classes/camera/camera.h"
 #include "classes/shader/shader.h"
 #include "classes/cubemap/cubemap.h"
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
 
 namespace bgq_opengl {
 
@@ -61,29 +64,31 @@ namespace bgq_opengl {
         };
         
         // Create VAO, VBO, and EBO for the skybox.
-        glGenVertexArrays(1, &this->vao);
-        glGenBuffers(1, &this->vbo);
-        glGenBuffers(1, &this->ebo);
+        this->vao = GLHandle(GLHandle::VERTEX_ARRAY);
+        this->vbo = GLHandle(GLHandle::BUFFER);
+        this->ebo = GLHandle(GLHandle::BUFFER);
         
         // Bind them.
-        glBindVertexArray(this->vao);
+        GLState::bindVertexArray(this->vao.get());
         
         // Fill the VBo with the vertices.
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, this->vbo.get());
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
+        this->vbo.account(GPUMemory::VERTICES, sizeof(vertices));
         
         // Fill the indices into the EBO.
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ebo.get());
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), &indices, GL_STATIC_DRAW);
+        this->ebo.account(GPUMemory::INDICES, sizeof(indices));
         
         // Pass the data to the layout.
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
         
         // Unbind everything.
         glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::bindVertexArray(0);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     }
 
@@ -102,7 +107,7 @@ namespace bgq_opengl {
     void Skybox::draw(Shader &shader, Camera &camera) {
         
         // We do this so that OpenGL does not discard the object.
-        glDepthFunc(GL_LEQUAL);
+        GLState::depthFunc(GL_LEQUAL);
 
         // Activate the shader.
         shader.activate();
@@ -117,14 +122,13 @@ namespace bgq_opengl {
 
         // Draws the cubemap as the last object so we can save a bit of performance by discarding all fragments
         // where an object is present (a depth of 1.0f will always fail against any object's depth value)
-        glBindVertexArray(this->vao);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.getID());
+        GLState::bindVertexArray(this->vao.get());
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, 0, cubemap.getID());
         glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        GLState::bindVertexArray(0);
 
         // Switch back to the normal depth function
-        glDepthFunc(GL_LESS);
+        GLState::depthFunc(GL_LESS);
 
 	}
 
@@ -25,6 +25,7 @@
 #include "classes/shader/shader.h"
 #include "classes/cubemap/cubemap.h"
 #include "classes/ebo/ebo.h"
+#include "classes/gl_handle/gl_handle.h"
 #include "classes/vbo/vbo.h"
 #include "classes/vao/vao.h"
 #include "structs/vertex/vertex.h"
@@ -81,7 +82,7 @@ namespace bgq_opengl {
 		private:
 
             Cubemap cubemap = Cubemap(0, "", 0);    /// The cubemap texture that will color this skybox.
-            unsigned int vao, vbo, ebo;             /// The IDs of the buffers of OpenGL.
+            GLHandle vao, vbo, ebo;                 /// The buffers of OpenGL, deleted along with the skybox.
 
 	};
 
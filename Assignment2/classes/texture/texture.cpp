@@ -18,65 +18,25 @@
 #include "texture.h"
 
 #include <assert.h>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "GL/glew.h"
 #include "stb/stb_image.h"
 
-namespace bgq_opengl {
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
+#include "classes/texture_cache/texture_cache.h"
+#include "structs/texture_file/texture_file.h"
 
-	Texture::Texture(const char* image, const char* name, GLuint slot) {
-        
-        // The slot has to be a positive number because OpenGL does weird stuff on macOS else.
-        if (slot < 1) assert(false);
+namespace bgq_opengl {
 
-		// Generate a texture in OpenGL and store the parameters in the attributes.
-		glGenTextures(1, &this->ID);
-		this->name = std::string(name);
-		this->slot = slot;
-
-		// This function has to be used because OpenGL loads texture the opposite way
-		// than this library, so images appear upside down.
-		stbi_set_flip_vertically_on_load(true);
-
-		// Read the texture image and its information.
-		unsigned char* image_bytes = stbi_load(image, &this->texture_width,
-				&this->texture_height, &this->texture_channels, 0);
-
-		// Set the slot for the texture.
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, this->ID);
-
-		// Configure the magnifying algorithm, minifying algorithm and repetition.
-		// This tells OpenGL how to apply intrpolation.
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-		// Get the color model for the image.
-		GLenum color_model = GL_RGBA;
-
-		if (this->texture_channels == 4)
-			color_model = GL_RGBA;
-		else if (this->texture_channels == 3)
-			color_model = GL_RGB;
-		else if (this->texture_channels == 1)
-			color_model = GL_RED;
-		else
-			assert(false);
-
-		// Load the image to OpenGL.
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, this->texture_width, this->texture_height,
-				0, color_model, GL_UNSIGNED_BYTE, image_bytes);
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// Clean the memory.
-		stbi_image_free(image_bytes);
-
-		// Unbinds the OpenGL Texture.
-		glBindTexture(GL_TEXTURE_2D, 0);
-
-	}
+	Texture::Texture(const char* image, const char* name, GLuint slot) : Texture(image, name, slot, GL_NEAREST_MIPMAP_LINEAR, GL_NEAREST) {}
 
     Texture::Texture(const char* image, const char* name, GLuint slot, GLint param1, GLint param2) {
         
@@ -84,21 +44,56 @@ namespace bgq_opengl {
         if (slot < 1) assert(false);
 
         // Generate a texture in OpenGL and store the parameters in the attributes.
-        glGenTextures(1, &this->ID);
+        // The image is not shared, but copies of this texture will share it.
+        this->image = std::make_shared<TextureImage>();
+        this->image->path = std::string(image);
+        this->image->texture = GLHandle(GLHandle::TEXTURE);
+        this->image->ready = true;
         this->name = std::string(name);
         this->slot = slot;
 
-        // This function has to be used because OpenGL loads texture the opposite way
-        // than this library, so images appear upside down.
-        stbi_set_flip_vertically_on_load(true);
+        // Compressed files bring their own mip chain.
+        TextureFile file;
+        if (TextureFile::isTextureFile(image)) {
+            
+            bool usable = TextureFile::read(image, file);
+            if (!usable) {
+                std::cerr << "Error 121-1009 - The texture " << image << " could not be loaded." << std::endl;
+            } else if (!isFormatSupported(file.internal_format)) {
+                std::cerr << "Error 121-1010 - The texture " << image << " uses a compressed format this GPU does not support." << std::endl;
+                usable = false;
+            }
+            
+            GLState::bindTexture(GL_TEXTURE_2D, slot, this->getID());
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, param1);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, param2);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            
+            if (usable) {
+                uploadFile(file, GL_TEXTURE_2D, 0, file.data.data());
+                this->image->texture.account(GPUMemory::TEXTURES, file.data.size());
+                this->image->width = file.width;
+                this->image->height = file.height;
+                this->image->channels = file.channels;
+            }
+            
+            GLState::bindTexture(GL_TEXTURE_2D, slot, 0);
+            return;
+            
+        }
 
         // Read the texture image and its information.
-        unsigned char* image_bytes = stbi_load(image, &this->texture_width,
-                &this->texture_height, &this->texture_channels, 0);
+        unsigned char* image_bytes = stbi_load(image, &this->image->width,
+                &this->image->height, &this->image->channels, 0);
+
+        // OpenGL loads textures the opposite way than this library, so images
+        // would appear upside down.
+        if (image_bytes)
+            Texture::flipRows(image_bytes, this->image->width, this->image->height, this->image->channels);
 
         // Set the slot for the texture.
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, this->ID);
+        GLState::bindTexture(GL_TEXTURE_2D, slot, this->getID());
 
         // Configure the magnifying algorithm, minifying algorithm and repetition.
         // This tells OpenGL how to apply intrpolation.
@@ -110,31 +105,47 @@ namespace bgq_opengl {
         // Get the color model for the image.
         GLenum color_model = GL_RGBA;
 
-        if (this->texture_channels == 4)
+        if (this->image->channels == 4)
             color_model = GL_RGBA;
-        else if (this->texture_channels == 3)
+        else if (this->image->channels == 3)
             color_model = GL_RGB;
-        else if (this->texture_channels == 1)
+        else if (this->image->channels == 1)
             color_model = GL_RED;
         else
             assert(false);
 
         // Load the image to OpenGL.
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, this->texture_width, this->texture_height,
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, this->image->width, this->image->height,
                 0, color_model, GL_UNSIGNED_BYTE, image_bytes);
         glGenerateMipmap(GL_TEXTURE_2D);
+        this->image->texture.account(GPUMemory::TEXTURES, GPUMemory::getTextureSize(this->image->width, this->image->height, 1, true));
 
         // Clean the memory.
         stbi_image_free(image_bytes);
 
         // Unbinds the OpenGL Texture.
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::bindTexture(GL_TEXTURE_2D, slot, 0);
 
+    }
+
+    Texture::Texture(std::shared_ptr<TextureImage> image, const char* name, GLuint slot) {
+        
+        // The slot has to be a positive number because OpenGL does weird stuff on macOS else.
+        if (slot < 1) assert(false);
+        
+        this->image = image;
+        this->name = std::string(name);
+        this->slot = slot;
+        
     }
 
 	GLuint Texture::getID() {
 
-		return this->ID;
+		// Shared images are uploaded later, so ask them every time.
+		if (this->image)
+			return this->image->texture.get();
+
+		return 0;
 
 	}
 
@@ -146,19 +157,28 @@ namespace bgq_opengl {
 
 	int Texture::getWidth() {
 
-		return this->texture_width;
+		if (this->image)
+			return this->image->width;
+
+		return 0;
 
 	}
 
 	int Texture::getHeight() {
 
-		return this->texture_height;
+		if (this->image)
+			return this->image->height;
+
+		return 0;
 
 	}
 
 	int Texture::getChannels() {
 
-		return this->texture_channels;
+		if (this->image)
+			return this->image->channels;
+
+		return 0;
 
 	}
 
@@ -171,20 +191,84 @@ namespace bgq_opengl {
 	void Texture::bind() {
 
 		// Activate the texture and bind it.
-		glActiveTexture(GL_TEXTURE0 + this->slot);
-		glBindTexture(GL_TEXTURE_2D, this->ID);
+		GLState::bindTexture(GL_TEXTURE_2D, this->slot, this->getID());
 
 	}
 
 	void Texture::remove() {
 
-		glDeleteTextures(1, &this->ID);
+		// The texture is deleted once no copy holds the image, the cache waits until its next update.
+		this->image.reset();
 
 	}
 
 	void Texture::unbind() {
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		GLState::bindTexture(GL_TEXTURE_2D, this->slot, 0);
+
+	}
+
+	bool Texture::isFormatSupported(GLenum internal_format) {
+
+		// Whole families come with an extension, the list below does not have to name them all.
+		if ((internal_format >= GL_COMPRESSED_RGB_S3TC_DXT1_EXT && internal_format <= GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) ||
+				(internal_format >= GL_COMPRESSED_SRGB_S3TC_DXT1_EXT && internal_format <= GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT))
+			return GLEW_EXT_texture_compression_s3tc;
+
+		if (internal_format >= GL_COMPRESSED_RED_RGTC1 && internal_format <= GL_COMPRESSED_SIGNED_RG_RGTC2)
+			return true;
+
+		if (internal_format >= GL_COMPRESSED_RGBA_BPTC_UNORM && internal_format <= GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT)
+			return GLEW_ARB_texture_compression_bptc;
+
+		if (internal_format >= GL_COMPRESSED_R11_EAC && internal_format <= GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC)
+			return GLEW_ARB_ES3_compatibility;
+
+		// The list does not change, so ask for it once.
+		static std::vector<GLint> formats;
+		if (formats.empty()) {
+			GLint count = 0;
+			glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+			formats.resize(count + 1, 0);
+			glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+		}
+
+		for (GLint format : formats)
+			if ((GLenum) format == internal_format)
+				return true;
+
+		return false;
+
+	}
+
+	void Texture::uploadFile(const TextureFile &file, GLenum target, int face, const unsigned char *source) {
+
+		for (int level = 0; level < file.levels; level++) {
+
+			const TextureFile::Image &image = file.getImage(level, face);
+			glCompressedTexImage2D(target, level, file.internal_format, image.width, image.height, 0, (GLsizei) image.size, (const void *) ((uintptr_t) source + image.offset));
+
+		}
+
+		// Only the stored levels exist, so the texture is complete without the rest.
+		GLenum texture_target = target == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+		glTexParameteri(texture_target, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(texture_target, GL_TEXTURE_MAX_LEVEL, file.levels - 1);
+
+	}
+
+	void Texture::flipRows(unsigned char *pixels, int width, int height, int channels) {
+
+		size_t row = (size_t) width * channels;
+		std::vector<unsigned char> temp(row);
+
+		for (int y = 0; y < height / 2; y++) {
+			unsigned char *top = pixels + y * row;
+			unsigned char *bottom = pixels + (height - 1 - y) * row;
+			std::memcpy(temp.data(), top, row);
+			std::memcpy(top, bottom, row);
+			std::memcpy(bottom, temp.data(), row);
+		}
 
 	}
 
@@ -16,17 +16,22 @@
 #ifndef BGQ_OPENGL_CLASS_TEXTURE_H_
 #define BGQ_OPENGL_CLASS_TEXTURE_H_
 
+#include <memory>
 #include <string>
 
 #include "GL/glew.h"
 
+#include "classes/texture_cache/texture_cache.h"
+#include "structs/texture_file/texture_file.h"
+
 namespace bgq_opengl {
 
 	/**
 	 * @brief Implements a texture class to handle object textures.
 	 * 
 	 * Implements a texture object to handle textures and their content to use
-	 * with the objects.
+	 * with the objects. Copies share the same image, whose GL texture is deleted
+	 * once none of them holds it anymore.
 	 * 
 	 * @author Borja García Quiroga <garcaqub@tcd.ie>
 	 */
@@ -37,7 +42,8 @@ namespace bgq_opengl {
 			/**
 			 * @brief Creates a texture from an image.
 			 * 
-			 * Creates a textures and passes it to OpenGL.
+			 * Creates a textures and passes it to OpenGL. KTX and DDS files are
+			 * uploaded compressed with their own mip chain.
 			 * 
 			 * @param image Image containing the texture.
 			 * @param name Texture name in the shader.
@@ -58,6 +64,18 @@ namespace bgq_opengl {
              */
             Texture(const char* image, const char* name, GLuint slot, GLint param1, GLint param2);
 
+            /**
+             * @brief Creates a texture from a shared image.
+             *
+             * Creates a texture that uses an image of the TextureCache. Nothing is
+             * bound until the image has been uploaded.
+             *
+             * @param image The shared image.
+             * @param name Texture name in the shader.
+             * @param slot Texture slot.
+             */
+            Texture(std::shared_ptr<TextureImage> image, const char* name, GLuint slot);
+
 			/**
 			 * @brief Get the ID of the texture.
 			 * 
@@ -122,7 +140,8 @@ namespace bgq_opengl {
 			/**
 			 * @brief Removes the texture from OpenGL.
 			 *
-			 *  Removes the texture from OpenGL.
+			 * Lets go of the image, whose texture is removed from OpenGL once no other
+			 * copy holds it.
 			 */
 			void remove();
 
@@ -133,14 +152,50 @@ namespace bgq_opengl {
 			 */
 			void unbind();
 
+			/**
+			 * @brief Checks whether a compressed format can be used.
+			 *
+			 * Checks whether the GPU lists a compressed format among the ones it
+			 * accepts.
+			 *
+			 * @param internal_format The GL internal format.
+			 *
+			 * @returns Whether the format is supported.
+			 */
+			static bool isFormatSupported(GLenum internal_format);
+
+			/**
+			 * @brief Uploads a compressed file.
+			 *
+			 * Uploads every level of one face of a compressed file to the bound
+			 * texture and limits its mip chain to them.
+			 *
+			 * @param file The file.
+			 * @param target GL_TEXTURE_2D or a face of GL_TEXTURE_CUBE_MAP.
+			 * @param face The face of the file.
+			 * @param source The data of the file, or 0 if it is in the bound pixel unpack buffer.
+			 */
+			static void uploadFile(const TextureFile &file, GLenum target, int face, const unsigned char *source);
+
+			/**
+			 * @brief Flips an image vertically.
+			 *
+			 * Swaps the rows of a decoded image, since OpenGL reads them bottom up.
+			 * The flag of stb_image is global to every thread, so images are flipped
+			 * with this instead.
+			 *
+			 * @param pixels The pixels of the image.
+			 * @param width The width of the image.
+			 * @param height The height of the image.
+			 * @param channels The number of channels of the image.
+			 */
+			static void flipRows(unsigned char *pixels, int width, int height, int channels);
+
 		private:
 
-			GLuint ID;					/// Texture OpenGL ID.
 			GLuint slot;				/// Stores the texture slot number.
-			int texture_width = 0;		/// Width of the texture in pixels.
-			int texture_height = 0;		/// Height of the texture in pixels.
-			int texture_channels = 0;	/// Number of channels of the texture.
 			std::string name;			/// Texture name.
+			std::shared_ptr<TextureImage> image;	/// The image, shared with the cache if it comes from it.
 
 	};
 
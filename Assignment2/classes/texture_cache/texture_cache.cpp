@@ -0,0 +1,330 @@
+/**
+ * @file texture_cache.cpp
+ * @brief TextureCache class implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "texture_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "stb/stb_image.h"
+
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
+#include "classes/texture/texture.h"
+#include "structs/texture_file/texture_file.h"
+
+namespace bgq_opengl {
+
+	std::mutex TextureCache::mutex;
+	std::condition_variable TextureCache::condition;
+	std::map<std::string, std::weak_ptr<TextureImage>> TextureCache::images;
+	std::deque<TextureCache::Job> TextureCache::queued;
+	std::deque<TextureCache::Job> TextureCache::decoded;
+	std::vector<GLHandle> TextureCache::released;
+	std::vector<std::thread> TextureCache::workers;
+	size_t TextureCache::pending = 0;
+	bool TextureCache::stopping = false;
+	unsigned long TextureCache::shared = 0;
+	GLHandle TextureCache::pbo;
+
+	std::shared_ptr<TextureImage> TextureCache::load(const std::string &path) {
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// Share the image if somebody still holds it.
+		std::shared_ptr<TextureImage> image = images[path].lock();
+		if (image) {
+			shared++;
+			return image;
+		}
+
+		image = std::shared_ptr<TextureImage>(new TextureImage(), release);
+		image->path = path;
+		images[path] = image;
+
+		// Start the workers the first time they are needed.
+		if (workers.empty()) {
+			stopping = false;
+			unsigned int num_workers = std::max(1u, std::min((unsigned int) TEXTURE_CACHE_MAX_WORKERS, std::thread::hardware_concurrency() - 1));
+			for (unsigned int i = 0; i < num_workers; i++)
+				workers.push_back(std::thread(work));
+		}
+
+		Job job;
+		job.image = image;
+		queued.push_back(job);
+		pending++;
+		condition.notify_all();
+
+		return image;
+
+	}
+
+	void TextureCache::update(size_t budget) {
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		// Delete the textures nobody uses anymore.
+		released.clear();
+
+		// Upload until the budget runs out, but always at least one image.
+		size_t uploaded = 0;
+		while (!decoded.empty() && (uploaded == 0 || uploaded < budget)) {
+
+			Job job = std::move(decoded.front());
+			decoded.pop_front();
+
+			// Let go of the image before locking again, it may be the last reference.
+			lock.unlock();
+			upload(job);
+			uploaded += (job.file.levels > 0 ? job.file.data.size() : (size_t) job.width * job.height * job.channels) + 1;
+			job.image.reset();
+			lock.lock();
+
+		}
+
+	}
+
+	void TextureCache::finish() {
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (pending > 0 || !decoded.empty()) {
+
+			condition.wait(lock, [] { return pending == 0 || !decoded.empty(); });
+
+			lock.unlock();
+			update((size_t) -1);
+			lock.lock();
+
+		}
+
+	}
+
+	void TextureCache::terminate() {
+
+		// Stop the workers.
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+			condition.notify_all();
+		}
+
+		for (std::thread &worker : workers)
+			worker.join();
+
+		workers.clear();
+
+		// Drop what was never uploaded.
+		for (Job &job : queued)
+			stbi_image_free(job.pixels);
+
+		for (Job &job : decoded)
+			stbi_image_free(job.pixels);
+
+		queued.clear();
+		decoded.clear();
+		pending = 0;
+
+		update(0);
+
+		pbo.reset();
+
+	}
+
+	size_t TextureCache::getNumImages() {
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		size_t count = 0;
+		for (const auto &entry : images)
+			if (!entry.second.expired())
+				count++;
+
+		return count;
+
+	}
+
+	unsigned long TextureCache::getNumShared() {
+
+		std::lock_guard<std::mutex> lock(mutex);
+		return shared;
+
+	}
+
+	void TextureCache::work() {
+
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (true) {
+
+			condition.wait(lock, [] { return stopping || !queued.empty(); });
+			if (stopping)
+				return;
+
+			Job job = std::move(queued.front());
+			queued.pop_front();
+
+			// Decode without holding the lock.
+			lock.unlock();
+
+			// Compressed files are uploaded as they are.
+			if (TextureFile::isTextureFile(job.image->path)) {
+
+				if (TextureFile::read(job.image->path, job.file)) {
+					job.width = job.file.width;
+					job.height = job.file.height;
+					job.channels = job.file.channels;
+				} else {
+					job.file = TextureFile();
+				}
+
+			} else {
+
+				job.pixels = stbi_load(job.image->path.c_str(), &job.width, &job.height, &job.channels, 0);
+
+			}
+
+			// OpenGL reads images bottom up.
+			if (job.pixels)
+				Texture::flipRows(job.pixels, job.width, job.height, job.channels);
+
+			lock.lock();
+
+			decoded.push_back(std::move(job));
+			pending--;
+			condition.notify_all();
+
+		}
+
+	}
+
+	void TextureCache::upload(Job &job) {
+
+		TextureImage &image = *job.image;
+		bool compressed = job.file.levels > 0;
+
+		if (compressed && !Texture::isFormatSupported(job.file.internal_format)) {
+			std::cerr << "Error 121-1010 - The texture " << image.path << " uses a compressed format this GPU does not support." << std::endl;
+			return;
+		}
+
+		// Get the color model for the image.
+		GLenum color_model = GL_RGBA;
+
+		if (job.channels == 4)
+			color_model = GL_RGBA;
+		else if (job.channels == 3)
+			color_model = GL_RGB;
+		else if (job.channels == 1)
+			color_model = GL_RED;
+		else {
+			stbi_image_free(job.pixels);
+			job.pixels = 0;
+		}
+
+		if (!compressed && !job.pixels) {
+			std::cerr << "Error 121-1009 - The texture " << image.path << " could not be loaded." << std::endl;
+			return;
+		}
+
+		// Copy the pixels into the pixel buffer, orphaning what the last upload left.
+		const unsigned char *bytes = compressed ? job.file.data.data() : job.pixels;
+		size_t size = compressed ? job.file.data.size() : (size_t) job.width * job.height * job.channels;
+
+		if (pbo.get() == 0)
+			pbo = GLHandle(GLHandle::BUFFER);
+
+		GLState::bindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo.get());
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+		pbo.account(GPUMemory::STREAMS, size);
+
+		const unsigned char *source = 0;
+		void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		if (mapped) {
+			std::memcpy(mapped, bytes, size);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		} else {
+			GLState::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			source = bytes;
+		}
+
+		// Create the texture with the same settings as Texture.
+		image.texture = GLHandle(GLHandle::TEXTURE);
+		GLState::bindTexture(GL_TEXTURE_2D, TEXTURE_CACHE_UPLOAD_UNIT, image.texture.get());
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		if (compressed) {
+
+			// The mip chain comes with the file.
+			Texture::uploadFile(job.file, GL_TEXTURE_2D, 0, source);
+			image.texture.account(GPUMemory::TEXTURES, job.file.data.size());
+
+		} else {
+
+			// Rows of RGB and single channel images are not aligned to four bytes.
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, job.width, job.height, 0, color_model, GL_UNSIGNED_BYTE, source);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+			glGenerateMipmap(GL_TEXTURE_2D);
+			image.texture.account(GPUMemory::TEXTURES, GPUMemory::getTextureSize(job.width, job.height, 1, true));
+
+		}
+
+		GLState::bindTexture(GL_TEXTURE_2D, TEXTURE_CACHE_UPLOAD_UNIT, 0);
+		GLState::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		// Clean the memory.
+		stbi_image_free(job.pixels);
+		job.pixels = 0;
+		job.file.data.clear();
+
+		image.width = job.width;
+		image.height = job.height;
+		image.channels = job.channels;
+		image.ready = true;
+
+	}
+
+	void TextureCache::release(TextureImage *image) {
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// Forget the path unless it has already been loaded again.
+		auto entry = images.find(image->path);
+		if (entry != images.end() && entry->second.expired())
+			images.erase(entry);
+
+		if (image->texture.get() != 0)
+			released.push_back(std::move(image->texture));
+
+		delete image;
+
+	}
+
+}  // namespace bgq_opengl
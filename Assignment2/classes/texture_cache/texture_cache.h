@@ -0,0 +1,187 @@
+/**
+ * @file texture_cache.h
+ * @brief TextureCache class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TEXTURE_CACHE_H_
+#define BGQ_OPENGL_CLASSES_TEXTURE_CACHE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/gl_handle/gl_handle.h"
+#include "structs/texture_file/texture_file.h"
+
+#define TEXTURE_CACHE_MAX_WORKERS 4                     // Maximum number of decoding threads.
+#define TEXTURE_CACHE_UPLOAD_BYTES (16 * 1024 * 1024)   // Bytes uploaded per frame, at least one image is.
+#define TEXTURE_CACHE_UPLOAD_UNIT 1                     // Texture unit used while uploading.
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A shared texture image.
+	 *
+	 * This Struct holds the GL texture of an image file, shared by every texture
+	 * that uses that file. It is only touched by the GL thread once it is ready,
+	 * and owns the texture, so it cannot be copied.
+	 */
+	struct TextureImage {
+
+		std::string path;			/// The file it was loaded from.
+		GLHandle texture;			/// The GL texture, empty until it is uploaded.
+		int width = 0;				/// Width of the image in pixels.
+		int height = 0;				/// Height of the image in pixels.
+		int channels = 0;			/// Number of channels of the image.
+		bool ready = false;			/// Whether the texture has been uploaded.
+
+	};
+
+	/**
+	 * @brief Implementation of a shared texture cache.
+	 *
+	 * Hands out one TextureImage per file no matter how many times it is asked for.
+	 * Files are decoded by a pool of worker threads and uploaded later on the GL
+	 * thread through a pixel buffer, within a budget of bytes per frame. KTX and
+	 * DDS files are read as they are and keep their compressed mip chain. Textures
+	 * are deleted once nobody holds their image.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TextureCache {
+
+		public:
+
+			/**
+			 * @brief Load an image.
+			 *
+			 * Get the shared image of a file, queueing it to be decoded the first time
+			 * it is asked for. It can be called from any thread.
+			 *
+			 * @param path The path of the file.
+			 *
+			 * @returns The shared image.
+			 */
+			static std::shared_ptr<TextureImage> load(const std::string &path);
+
+			/**
+			 * @brief Upload the decoded images.
+			 *
+			 * Upload the images decoded so far, within a budget, and delete the
+			 * textures that are no longer used. Only to be called from the GL thread.
+			 *
+			 * @param budget The maximum number of bytes to upload.
+			 */
+			static void update(size_t budget);
+
+			/**
+			 * @brief Upload every pending image.
+			 *
+			 * Wait for the workers to decode every queued image and upload them all.
+			 * Only to be called from the GL thread.
+			 */
+			static void finish();
+
+			/**
+			 * @brief Stop the cache.
+			 *
+			 * Stop the workers and delete the textures that are no longer used. Only to
+			 * be called from the GL thread.
+			 */
+			static void terminate();
+
+			/**
+			 * @brief Get the number of images.
+			 *
+			 * Get the number of images alive in the cache.
+			 *
+			 * @returns The number of images.
+			 */
+			static size_t getNumImages();
+
+			/**
+			 * @brief Get the number of shared loads.
+			 *
+			 * Get the number of loads that were served with an image already in the cache.
+			 *
+			 * @returns The number of loads.
+			 */
+			static unsigned long getNumShared();
+
+		private:
+
+			/**
+			 * @brief An image waiting to be decoded or uploaded.
+			 */
+			struct Job {
+
+				std::shared_ptr<TextureImage> image;	/// The image it belongs to.
+				unsigned char *pixels = 0;				/// The decoded pixels, or 0 if decoding failed.
+				int width = 0;							/// Width of the image in pixels.
+				int height = 0;							/// Height of the image in pixels.
+				int channels = 0;						/// Number of channels of the image.
+				TextureFile file;						/// The compressed file, if the image is one.
+
+			};
+
+			/**
+			 * @brief The worker threads.
+			 *
+			 * Decode queued images until the cache is stopped.
+			 */
+			static void work();
+
+			/**
+			 * @brief Upload a decoded image.
+			 *
+			 * Create the texture of an image and fill it through the pixel buffer.
+			 *
+			 * @param job The decoded image.
+			 */
+			static void upload(Job &job);
+
+			/**
+			 * @brief Release an image.
+			 *
+			 * Deleter of the shared images, that hands their texture to the GL thread
+			 * to be deleted.
+			 *
+			 * @param image The image.
+			 */
+			static void release(TextureImage *image);
+
+			static std::mutex mutex;										/// Guards everything below.
+			static std::condition_variable condition;						/// Signaled when the queues change.
+			static std::map<std::string, std::weak_ptr<TextureImage>> images;	/// The images by path.
+			static std::deque<Job> queued;									/// Images waiting to be decoded.
+			static std::deque<Job> decoded;									/// Images waiting to be uploaded.
+			static std::vector<GLHandle> released;							/// Textures waiting to be deleted.
+			static std::vector<std::thread> workers;						/// The decoding threads.
+			static size_t pending;											/// Images queued or being decoded.
+			static bool stopping;											/// Whether the workers have to stop.
+			static unsigned long shared;									/// Loads served from the cache.
+			static GLHandle pbo;											/// The pixel buffer used for uploads.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_TEXTURE_CACHE_H_
@@ -0,0 +1,112 @@
+/**
+ * @file triple_buffer.h
+ * @brief TripleBuffer class header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TRIPLE_BUFFER_H_
+#define BGQ_OPENGL_CLASSES_TRIPLE_BUFFER_H_
+
+#include <atomic>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a lock-free triple buffer.
+	 *
+	 * Hands values from one writer thread to one reader thread without locks. The
+	 * writer fills its own buffer and publishes it by swapping it with the middle
+	 * one, the reader takes the middle one by swapping it with its own. Neither of
+	 * them ever waits, and the reader always gets the latest published value.
+	 * The buffers are reused, so values that own memory stop allocating once they
+	 * have grown.
+	 *
+	 * The implementation lives in this header because it is a template.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	template <typename T>
+	class TripleBuffer {
+
+		public:
+
+			/**
+			 * @brief Get the writer buffer.
+			 *
+			 * Get the buffer the writer fills, only to be used by the writer thread.
+			 *
+			 * @returns The buffer.
+			 */
+			T &getWriteBuffer() {
+
+				return this->buffers[this->back];
+
+			}
+
+			/**
+			 * @brief Publish the writer buffer.
+			 *
+			 * Make the writer buffer the latest value and take the middle one to write
+			 * the next.
+			 */
+			void publish() {
+
+				this->back = this->middle.exchange(this->back | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+
+			}
+
+			/**
+			 * @brief Take the latest value.
+			 *
+			 * Swap the reader buffer with the middle one if something new was published,
+			 * only to be used by the reader thread.
+			 *
+			 * @returns Whether the reader buffer changed.
+			 */
+			bool update() {
+
+				if ((this->middle.load(std::memory_order_acquire) & NEW_BIT) == 0)
+					return false;
+
+				this->front = this->middle.exchange(this->front, std::memory_order_acq_rel) & INDEX_MASK;
+				return true;
+
+			}
+
+			/**
+			 * @brief Get the reader buffer.
+			 *
+			 * Get the last value taken by update, only to be used by the reader thread.
+			 *
+			 * @returns The buffer.
+			 */
+			const T &getReadBuffer() const {
+
+				return this->buffers[this->front];
+
+			}
+
+		private:
+
+			static const unsigned int INDEX_MASK = 3;	/// Bits of the middle index.
+			static const unsigned int NEW_BIT = 4;		/// Set while the middle buffer has not been read.
+
+			T buffers[3];								/// The three buffers.
+			std::atomic<unsigned int> middle{0};		/// Index of the middle buffer and the new bit.
+			unsigned int back = 1;						/// Index of the writer buffer.
+			unsigned int front = 2;						/// Index of the reader buffer.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_CLASSES_TRIPLE_BUFFER_H_
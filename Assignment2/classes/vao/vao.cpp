@@ -17,6 +17,8 @@
 
 #include "GL/glew.h"
 
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
 #include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
@@ -24,26 +26,33 @@ namespace bgq_opengl {
 	VAO::VAO() {
 
 		// Generate the buffer.
-		glGenVertexArrays(1, &this->ID);
-		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+		this->array = GLHandle(GLHandle::VERTEX_ARRAY);
+		glBindBuffer(GL_ARRAY_BUFFER, this->array.get());
 
 	}
 
 	void VAO::bind() {
 
 		// Bind the VAO.
-		glBindVertexArray(this->ID);
+		GLState::bindVertexArray(this->array.get());
 
 	}
 
 	void VAO::link_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
 		GLsizeiptr step, void* offset) {
 
+		this->link_attribute(vbo, layout, num_components, type, GL_FALSE, step, offset);
+
+	}
+
+	void VAO::link_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+		GLboolean normalized, GLsizeiptr step, void* offset) {
+
 		// Bind the VBO.
 		vbo.bind();
 
 		// Tell OpenGL where the data in the VBO is located and activate the layout.
-		glVertexAttribPointer(layout, num_components, type, GL_FALSE, (GLsizei) step, offset);
+		glVertexAttribPointer(layout, num_components, type, normalized, (GLsizei) step, offset);
 		glEnableVertexAttribArray(layout);
 
 		// Unbind the vbo again.
@@ -51,17 +60,37 @@ namespace bgq_opengl {
 
 	}
 
+	void VAO::link_instance_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+		GLsizeiptr step, void* offset) {
+
+		this->link_attribute(vbo, layout, num_components, type, GL_FALSE, step, offset);
+
+		// Advance the attribute once per instance.
+		glVertexAttribDivisor(layout, 1);
+
+	}
+
+	void VAO::link_constant_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+		void* offset) {
+
+		this->link_attribute(vbo, layout, num_components, type, GL_FALSE, 0, offset);
+
+		// Never advance it, not even between instances.
+		glVertexAttribDivisor(layout, 0xFFFFFFFF);
+
+	}
+
 	void VAO::remove() {
 
-		// Deletes the VAO from the GL pipe.
-		glDeleteVertexArrays(1, &this->ID);
+		// Deletes the VAO from the GL pipe now instead of when it goes out of scope.
+		this->array.reset();
 
 	}
 
 	void VAO::unbind() {
 
 		// Unbind the VAO by binding no VAO.
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 
 	}
 
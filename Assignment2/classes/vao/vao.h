@@ -18,6 +18,7 @@
 
 #include "GL/glew.h"
 
+#include "classes/gl_handle/gl_handle.h"
 #include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
@@ -26,7 +27,8 @@ namespace bgq_opengl {
 	 * @brief Implementation of a VAO class.
 	 *
 	 * Implementation of a VAO class that will allow us to bind it to the
-	 * OpenGL pipe, destroy it or deactivate it.
+	 * OpenGL pipe, destroy it or deactivate it. It owns the vertex array, which
+	 * is deleted when it goes out of scope, so it can be moved but not copied.
 	 *
 	 * @author Borja García Quiroga <garcaqub@tcd.ie>
 	 */
@@ -63,10 +65,56 @@ namespace bgq_opengl {
 		void link_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
 			GLsizeiptr step, void* offset);
 
+		/**
+		 * @brief Links a VBO attribute to the VAO.
+		 *
+		 * Links a VBO attribute such as color, UV, or others, stored as integers
+		 * that may be normalized.
+		 *
+		 * @param vbo The VBO to link the attribute to.
+		 * @param layout The layout identifier that will be used in the shader.
+		 * @param num_components The number of components that are in the list.
+		 * @param type The type of data that we will be passing.
+		 * @param normalized Whether integers are mapped to [0, 1] or [-1, 1].
+		 * @param step The amount of bytes we have to skip to find the next item.
+		 * @param offset The amount of data we have to skip to find the first item.
+		 */
+		void link_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+			GLboolean normalized, GLsizeiptr step, void* offset);
+
+		/**
+		 * @brief Links a per instance VBO attribute to the VAO.
+		 *
+		 * Links a VBO attribute that advances once per instance instead of once per vertex.
+		 *
+		 * @param vbo The VBO to link the attribute to.
+		 * @param layout The layout identifier that will be used in the shader.
+		 * @param num_components The number of components that are in the list.
+		 * @param type The type of data that we will be passing.
+		 * @param step The amount of bytes we have to skip to find the next item.
+		 * @param offset The amount of data we have to skip to find the first item.
+		 */
+		void link_instance_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+			GLsizeiptr step, void* offset);
+
+		/**
+		 * @brief Links a constant VBO attribute to the VAO.
+		 *
+		 * Links a VBO attribute whose single value is used by every vertex and instance.
+		 *
+		 * @param vbo The VBO to link the attribute to.
+		 * @param layout The layout identifier that will be used in the shader.
+		 * @param num_components The number of components that are in the list.
+		 * @param type The type of data that we will be passing.
+		 * @param offset The amount of data we have to skip to find the value.
+		 */
+		void link_constant_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+			void* offset);
+
 		/**
 		 * @brief Remove the VAO.
 		 *
-		 * Removes the VAO in GL.
+		 * Removes the VAO in GL before it goes out of scope.
 		 */
 		void remove();
 
@@ -79,7 +127,7 @@ namespace bgq_opengl {
 
 	private:
 
-		GLuint ID; /// OpenGL VAO ID.
+		GLHandle array; /// The OpenGL vertex array.
 	};
 
 }  // namespace bgq_opengl
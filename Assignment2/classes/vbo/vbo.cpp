@@ -19,6 +19,9 @@
 
 #include "GL/glew.h"
 
+#include "classes/gl_handle/gl_handle.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
 #include "structs/vertex/vertex.h"
 
 namespace bgq_opengl {
@@ -26,25 +29,69 @@ namespace bgq_opengl {
 	VBO::VBO(const std::vector<Vertex> &vertices) {
 
 		// Generate the buffer.
-		glGenBuffers(1, &this->ID);
-		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+		this->buffer = GLHandle(GLHandle::BUFFER);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, this->buffer.get());
 
 		// Link the vertices.
 		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+		this->capacity = vertices.size() * sizeof(Vertex);
+		this->buffer.account(GPUMemory::VERTICES, (size_t) this->capacity);
+
+	}
+
+	VBO::VBO(const void *data, GLsizeiptr size) {
+
+		// Generate the buffer.
+		this->buffer = GLHandle(GLHandle::BUFFER);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, this->buffer.get());
+
+		// Link the data.
+		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+		this->capacity = size;
+		this->buffer.account(GPUMemory::VERTICES, (size_t) size);
+
+	}
+
+	VBO::VBO(GLsizeiptr size) {
+
+		// Generate the buffer.
+		this->buffer = GLHandle(GLHandle::BUFFER);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, this->buffer.get());
+
+		// Reserve the storage without data.
+		glBufferData(GL_ARRAY_BUFFER, size, 0, GL_STREAM_DRAW);
+		this->capacity = size;
+		this->buffer.account(GPUMemory::STREAMS, (size_t) size);
 
 	}
 
 	void VBO::bind() {
 
 		// Bind the VBO.
-		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, this->buffer.get());
 
 	}
 
 	void VBO::remove() {
 
-		// Delete the buffer in OpenGL.
-		glDeleteBuffers(1, &this->ID);
+		// Delete the buffer in OpenGL now instead of when it goes out of scope.
+		this->buffer.reset();
+
+	}
+
+	void VBO::update(const void *data, GLsizeiptr size) {
+
+		GLState::bindBuffer(GL_ARRAY_BUFFER, this->buffer.get());
+
+		// Grow the storage if the data does not fit.
+		if (size > this->capacity) {
+			this->capacity = size * 2;
+			this->buffer.account(GPUMemory::STREAMS, (size_t) this->capacity);
+		}
+
+		// Orphan the old storage so the driver does not wait for draws still using it.
+		glBufferData(GL_ARRAY_BUFFER, this->capacity, 0, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 
 	}
 
@@ -52,7 +99,7 @@ namespace bgq_opengl {
 
 		// Unbind it.
 		// To do so, just bind nothing.
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
 
 	}
 
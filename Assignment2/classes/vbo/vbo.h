@@ -20,6 +20,7 @@
 
 #include "GL/glew.h"
 
+#include "classes/gl_handle/gl_handle.h"
 #include "structs/vertex/vertex.h"
 
 namespace bgq_opengl {
@@ -28,7 +29,8 @@ namespace bgq_opengl {
 	 * @brief Implementation of a VBO class.
 	 *
 	 * Implementation of a VBO class that will allow us to bind it to the
-	 * OpenGL pipe, destroy it or deactivate it.
+	 * OpenGL pipe, destroy it or deactivate it. It owns the buffer, which is
+	 * deleted when it goes out of scope, so it can be moved but not copied.
 	 *
 	 * @author Borja García Quiroga <garcaqub@tcd.ie>
 	 */
@@ -45,6 +47,25 @@ namespace bgq_opengl {
 		 */
 		VBO(const std::vector<Vertex> &vertices);
 
+		/**
+		 * @brief Constructs a Vertex Buffer Object.
+		 *
+		 * Constructs a Vertex Buffer Object from already packed vertex data.
+		 *
+		 * @param data The packed vertex data.
+		 * @param size The size of the data in bytes.
+		 */
+		VBO(const void *data, GLsizeiptr size);
+
+		/**
+		 * @brief Constructs a streaming Vertex Buffer Object.
+		 *
+		 * Constructs an empty Vertex Buffer Object meant to be rewritten every frame.
+		 *
+		 * @param size The initial size of the buffer in bytes.
+		 */
+		VBO(GLsizeiptr size);
+
 		/**
 		 * @brief Binds the VBO.
 		 *
@@ -55,7 +76,7 @@ namespace bgq_opengl {
 		/**
 		 * @brief Removes the VBO.
 		 *
-		 * Removes the VBO from OpenGL.
+		 * Removes the VBO from OpenGL before it goes out of scope.
 		 */
 		void remove();
 
@@ -66,9 +87,20 @@ namespace bgq_opengl {
 		 */
 		void unbind();
 
+		/**
+		 * @brief Rewrites the VBO.
+		 *
+		 * Orphans the storage of the VBO and uploads new data to it, growing it if needed.
+		 *
+		 * @param data The new data.
+		 * @param size The size of the data in bytes.
+		 */
+		void update(const void *data, GLsizeiptr size);
+
 	private:
 
-		GLuint ID; // GL ID of the VBO.
+		GLHandle buffer; // The GL buffer of the VBO.
+		GLsizeiptr capacity = 0; // Size of the storage in bytes.
 
 	};
 
@@ -16,9 +16,13 @@
 #include "main.h"
 
 #include <algorithm>
+#include <cassert>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <random>
+#include <thread>
 #include <vector>
 #include <cmath>
 
@@ -35,16 +39,45 @@
 #include "glm/gtx/euler_angles.hpp"
 
 #include "classes/camera/camera.h"
+#include "classes/clip_sampler/clip_sampler.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gpu_memory/gpu_memory.h"
+#include "classes/headless/headless.h"
 #include "classes/light/light.h"
 #include "classes/object_hierarchical/object_hierarchical.h"
+#include "classes/oscillator_driver/oscillator_driver.h"
+#include "classes/pose_mixer/pose_mixer.h"
+#include "classes/profiler/profiler.h"
+#include "classes/render_stats/render_stats.h"
+#include "classes/rig_cache/rig_cache.h"
 #include "classes/shader/shader.h"
+#include "classes/texture_cache/texture_cache.h"
+#include "structs/animation_clip/animation_clip.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/frustum/frustum.h"
 #include "structs/helpful/helpful.h"
+#include "structs/joint_pose/joint_pose.h"
 
 void clean() {
 
 	// Delete all the shaders.
 	shader->remove();
+    shaderPnt->remove();
+    
+    // Delete the scene while there is still a context, the GL objects go with it.
+    delete onyx;
+    delete jelly;
+    delete dis_pnt;
+    delete pnt_instances;
+    
+    // Stop decoding and delete the unused textures.
+    bgq_opengl::TextureCache::terminate();
+    
+    // Destroy the offscreen context.
+    if (headless) {
+        bgq_opengl::Headless::terminate();
+        return;
+    }
     
     // Terminate ImGUI.
     ImGui_ImplGlfwGL3_Shutdown();
@@ -70,25 +103,106 @@ void displayElements() {
     shader->activate();
     shader->passLight(scene_light);
     
+    // Take the latest pose, the simulation keeps working on the next one meanwhile.
+    bool updated = sim_states.update();
+    if (updated) {
+        std::swap(render_previous, render_current);
+        render_current = sim_states.getReadBuffer();
+    }
+    
+    const bgq_opengl::SimulationState &state = render_current;
+    if (state.scene == -1)
+        return;
+    
+    // Draw one step behind, blending the last two poses so the motion does not depend on the step rate.
+    float alpha = 1.0f;
+    if (render_previous.scene == state.scene && state.time > render_previous.time)
+        alpha = glm::clamp((float) ((internal_time - SIMULATION_STEP - render_previous.time) / (state.time - render_previous.time)), 0.0f, 1.0f);
+    
+    bgq_opengl::Pose::interpolate(render_previous.pose, state.pose, alpha, render_pose);
+    
+    bgq_opengl::ObjectHierarchical *selected = state.scene == 0 ? onyx : jelly;
+    
+    // Draw everything.
+    bgq_opengl::Profiler::begin("draw");
+    
+    // Refit the hierarchy when the drawn pose moved, the other creatures keep their boxes.
+    if (updated || alpha != render_alpha) {
+        scene_bbs[state.scene] = selected->getWorldBoundingBox(render_pose);
+        scene_bvh.refit(scene_bbs);
+        render_alpha = alpha;
+    }
+    
+    // Cull the creatures in groups through the hierarchy before testing their segments.
+    bgq_opengl::Frustum frustum = bgq_opengl::Frustum::fromMatrix(camera->getCameraMatrix());
+    scene_bvh.query(frustum, scene_visible);
+    
+    // Only the creature of the current scene is drawn, whole if the hierarchy saw it.
+    if (std::find(scene_visible.begin(), scene_visible.end(), state.scene) != scene_visible.end())
+        selected->drawVisible(*shader, *camera, frustum, render_pose);
+    else
+        bgq_opengl::RenderStats::addCulled(selected->getNumSegments());
+    
+    // Update the control points, blended like the pose when they match.
+    ctrl_pnts = state.control_points;
+    if (alpha < 1.0f && render_previous.control_points.size() == ctrl_pnts.size())
+        for (size_t i = 0; i < ctrl_pnts.size(); i++)
+            ctrl_pnts[i].coords = glm::mix(render_previous.control_points[i].coords, ctrl_pnts[i].coords, alpha);
+    
+    // Draw the control points.
+    if (show_ctrl == 1)
+        displayControlPoints(ctrl_pnts, 0.2);
+    
+    bgq_opengl::Profiler::end();
+    
+}
+
+void simulate(const bgq_opengl::SimulationInput &input, bgq_opengl::SimulationState &state, double time) {
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    
     // Get the selected object.
     bgq_opengl::ObjectHierarchical *selected;
-    if (current_scene == 0)
+    if (input.scene == 0)
         selected = onyx;
-    else if (current_scene == 1)
+    else if (input.scene == 1)
         selected = jelly;
     else
         assert(false);
     
+    // Only the jelly is scripted.
+    if (input.kinematic == 2)
+        selected = jelly;
+    
+    // The dragged control point, if it is one of this creature.
+    int joint = input.moving_joint;
+    
+    // The creature changed, so the control points and the dragged one are not its own.
+    if (selected != sim_selected) {
+        sim_ctrl_pnts = selected->getControlPoints();
+        sim_selected = selected;
+        joint = -1;
+    }
+    
+    if (joint < 0 || joint >= (int) sim_ctrl_pnts.size())
+        joint = -1;
+    
+    // Take the new position of the dragged control point.
+    if (joint != -1 && input.target_version != sim_target_version)
+        sim_ctrl_pnts[joint].coords = input.target;
+    
+    sim_target_version = input.target_version;
+    
     // Do this for forward kinematics
-    if (kinematic == 0) {
+    if (input.kinematic == 0) {
         
         // Check that there is actually some control point moving.
-        if (moving_joint != -1 && ctrl_pnts[moving_joint].coords != ctrl_pnts[moving_joint].initial) {
+        if (joint != -1 && sim_ctrl_pnts[joint].coords != sim_ctrl_pnts[joint].initial) {
             
             // Get the two vectors representing this rotation.
             // The first vector is the one defined by the current position and the anchor. The second is the desired position and the anchor.
-            glm::vec3 v1 = glm::normalize(ctrl_pnts[moving_joint].initial - ctrl_pnts[moving_joint].anchor);
-            glm::vec3 v2 = glm::normalize(ctrl_pnts[moving_joint].coords  - ctrl_pnts[moving_joint].anchor);
+            glm::vec3 v1 = glm::normalize(sim_ctrl_pnts[joint].initial - sim_ctrl_pnts[joint].anchor);
+            glm::vec3 v2 = glm::normalize(sim_ctrl_pnts[joint].coords  - sim_ctrl_pnts[joint].anchor);
             
             // Build the quaternion that will give us the desired rotations.
             glm::vec3 a = glm::cross(v1, v2);
@@ -105,186 +219,234 @@ void displayElements() {
             glm::mat4 rotation = glm::toMat4(q);
                         
             // Apply the same transformations to the anchor points and
-            glm::vec3 anchor = ctrl_pnts[moving_joint].anchor;
+            glm::vec3 anchor = sim_ctrl_pnts[joint].anchor;
             glm::mat4 trans_matrix = glm::translate(glm::mat4(1.0), glm::vec3(anchor.x, anchor.y, anchor.z));
             trans_matrix = trans_matrix * rotation;
             trans_matrix = glm::translate(trans_matrix, glm::vec3(-anchor.x, -anchor.y, -anchor.z));
                         
             // We skip rotations in X cause there is no freedom in that direction.
-            selected->transform(ctrl_pnts[moving_joint].indices, ctrl_pnts[moving_joint].anchor, trans_matrix);
+            selected->transform(sim_ctrl_pnts[joint].indices, sim_ctrl_pnts[joint].anchor, trans_matrix);
             
         }
         
-    } else if (kinematic == 1) {
+    } else if (input.kinematic == 1) {
         
-        if (moving_joint != -1 && ctrl_pnts[moving_joint].coords != ctrl_pnts[moving_joint].initial) {
-            
-            // Get the number of IK we're gonna use.
-            int num_ik = std::min((int) ctrl_pnts[moving_joint].indices.size() + 1, ik_level);
-            
-            // Get the target we're trying to reach.
-            glm::vec3 target = ctrl_pnts[moving_joint].coords;
-            
-            // Get the control points ordered.
-            std::vector<bgq_opengl::ControlPoint> current_ctrl = selected->getControlPoints();
-            std::vector<bgq_opengl::ControlPoint> ik_struc = selected->getOrderedControlPoints(num_ik, current_ctrl[moving_joint]);
-            
-            // Keep iterating until nothing moves.
-            bool has_moved = true;
-            int iterations = 0;
-            while (has_moved) {
-                
-                // By now, nothing has moved.
-                has_moved = false;
-                
-                // Iterate through the anchors and control points.
-                for (int i = 0; i < ik_struc.size(); i++) {
-                    
-                    // Get what is being currently reached in the geometry.
-                    glm::vec3 curr_reach = current_ctrl[moving_joint].coords;
-                                        
-                    // Get current anchor and indices to rotate.
-                    glm::vec3 ik_anchor = ik_struc[i].anchor;
-                    std::vector<unsigned int> ik_inds = ik_struc[i].indices;
-                    
-                    // Get the two vectors representing this rotation.
-                    glm::vec3 v1 = glm::normalize(curr_reach - ik_anchor);
-                    glm::vec3 v2 = glm::normalize(target  - ik_anchor);
-                    
-                    // Build the quaternion that will give us the desired rotations.
-                    glm::vec3 a = glm::cross(v1, v2);
-                    glm::quat q;
-                    q.x = a.x;
-                    q.y = a.y;
-                    q.z = a.z;
-                    q.w = std::sqrt(std::pow(glm::length(v1), 2) * std::pow(glm::length(v2), 2)) + glm::dot(v1, v2);
-                    
-                    // Normalize it.
-                    q = glm::normalize(q);
-                    
-                    // Transform it into a matrix so that we can apply it.
-                    glm::mat4 rotation = glm::toMat4(q);
-                                
-                    // Apply the same transformations to the anchor points and
-                    glm::mat4 trans_matrix = glm::translate(glm::mat4(1.0), glm::vec3(ik_anchor.x, ik_anchor.y, ik_anchor.z));
-                    trans_matrix = trans_matrix * rotation;
-                    trans_matrix = glm::translate(trans_matrix, glm::vec3(-ik_anchor.x, -ik_anchor.y, -ik_anchor.z));
-                                
-                    // We skip rotations in X cause there is no freedom in that direction.
-                    selected->transform(ik_inds, ik_anchor, trans_matrix);
-                    
-                    // Update the current control points and ordered control points, as they could have changed.
-                    current_ctrl = selected->getControlPoints();
-                    ik_struc = selected->getOrderedControlPoints(num_ik, current_ctrl[moving_joint]);
-                                                                                
-                    // Check if the arm has mooved during this iteration.
-                    if (glm::distance(curr_reach, current_ctrl[moving_joint].coords) >= 0.01)
-                        has_moved = true;
-                    
-                    // Increment the iterations.
-                    iterations++;
-                    
-                }
-                
-                // If the number of iterations has surpassed the cube of the IK, skip.
-                if (iterations >= pow(num_ik, 3))
-                    break;
-
-            }
-            
-        }
+        if (joint != -1 && sim_ctrl_pnts[joint].coords != sim_ctrl_pnts[joint].initial)
+            solveIK(selected, joint, sim_ctrl_pnts[joint].coords, input.ik_level);
         
-    } else if (kinematic == 2) {
+    } else if (input.kinematic == 2) {
         
         // Only in the jelly is scripted.
         selected = jelly;
         
-        // Get the parameters for the animation.
-        const float amplitude = -script_amplitude;
-        const float amplitude_inner = -amplitude;
-        const float amplitude_inner_inner = 2.0f * amplitude_inner;
-        const float frequency = script_frequency;
-        const float phase = asin(0.0);
-        const float phase_inner = asin(0.0);
-        const float phase_inner_inner = asin(-0.8);
+        // Bake the script again when its parameters change, then play the clip at the bottom.
+        if (input.amplitude != script_clip_amplitude || input.frequency != script_clip_frequency)
+            bakeScript(input);
+        
+        bgq_opengl::JointPose &clip_pose = script_mixer.getPose(SCRIPT_LAYER_CLIP);
+        script_sampler.sample((float) std::fmod(time, (double) script_clip.duration), clip_pose);
+        
+        // While a control point is dragged, IK solves from the clip and its correction is layered on top.
+        bool dragging = joint != -1;
+        if (dragging) {
+            jelly->applyJointPose(clip_pose);
+            solveIK(jelly, joint, input.target, input.ik_level);
+            jelly->captureJointPose(script_ik_pose);
+            bgq_opengl::JointPose::difference(clip_pose, script_ik_pose, script_mixer.getPose(SCRIPT_LAYER_IK));
+        }
+        
+        // The correction fades in and out instead of popping.
+        float fade = (float) (SIMULATION_STEP / SCRIPT_IK_FADE);
+        float weight = script_mixer.getWeight(SCRIPT_LAYER_IK) + (dragging ? fade : -fade);
+        script_mixer.setWeight(SCRIPT_LAYER_IK, glm::clamp(weight, 0.0f, 1.0f));
+        
+        script_mixer.mix(script_pose);
+        jelly->applyJointPose(script_pose);
+
+    }
+
+    // Update the control points.
+    sim_ctrl_pnts = selected->getControlPoints();
+    sim_selected = selected;
+    
+    // Publish a copy of the pose.
+    state.scene = selected == onyx ? 0 : 1;
+    state.time = time;
+    selected->capturePose(state.pose);
+    state.control_points = sim_ctrl_pnts;
+    state.solve_time = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+}
+
+void solveIK(bgq_opengl::ObjectHierarchical *selected, int moving_joint, const glm::vec3 &target, int ik_level) {
+    
+    // Get the control points as they are now.
+    std::vector<bgq_opengl::ControlPoint> current_ctrl = selected->getControlPoints();
+    
+    // Get the number of IK we're gonna use.
+    int num_ik = std::min((int) current_ctrl[moving_joint].indices.size() + 1, ik_level);
+    
+    // Get the control points ordered.
+    std::vector<bgq_opengl::ControlPoint> ik_struc = selected->getOrderedControlPoints(num_ik, current_ctrl[moving_joint]);
+    
+    // Keep iterating until nothing moves.
+    bool has_moved = true;
+    int iterations = 0;
+    while (has_moved) {
         
-        std::vector<float> movements;
-        movements.push_back(amplitude * sin(frequency * internal_time + phase) - (amplitude / 2.0f));
-        movements.push_back(amplitude_inner * cos(frequency * internal_time + phase_inner));
-        movements.push_back(amplitude_inner_inner * cos(frequency * internal_time + phase_inner_inner));
+        // By now, nothing has moved.
+        has_moved = false;
         
-        for (unsigned int j = 1; j < 4; j++) {
+        // Iterate through the anchors and control points.
+        for (int i = 0; i < ik_struc.size(); i++) {
             
-            // Get control points that belong to the first arms.
-            for (unsigned int i = 0; i < ctrl_pnts.size(); i++) {
-                
-                // If this is not one of those first control points, leave.
-                if (ctrl_pnts[i].indices.size() != j)
-                    continue;
-                
-                // Update the control points.
-                ctrl_pnts = selected->getControlPoints();
-                
-                // Desired displacement.
-                float disp_amount = 0;
-                for (int k = 0; k < ctrl_pnts[i].indices.size(); k++)
-                    disp_amount += movements[k];
-                
-                // Get the displacement direction and the goal point.
-                glm::vec3 disp_dir = glm::normalize(ctrl_scrp[i].coords - glm::vec3(0.0f, ctrl_scrp[i].coords.y, 0.0f));
-                glm::vec3 goal = ctrl_scrp[i].coords + (disp_dir * disp_amount);
-                
-                std::cout << glm::to_string(goal) << std::endl;
-                
-                // Get the two vectors representing this rotation.
-                glm::vec3 v1 = glm::normalize(ctrl_pnts[i].initial - ctrl_pnts[i].anchor);
-                glm::vec3 v2 = glm::normalize(goal  - ctrl_pnts[i].anchor);
-                
-                // Build the quaternion that will give us the desired rotations.
-                glm::vec3 a = glm::cross(v1, v2);
-                glm::quat q;
-                q.x = a.x;
-                q.y = a.y;
-                q.z = a.z;
-                q.w = std::sqrt(std::pow(glm::length(v1), 2) * std::pow(glm::length(v2), 2)) + glm::dot(v1, v2);
-                
-                // Normalize it.
-                q = glm::normalize(q);
-                
-                // Transform it into a matrix so that we can apply it.
-                glm::mat4 rotation = glm::toMat4(q);
-                
-                // Apply the same transformations to the anchor points and
-                glm::vec3 anchor = ctrl_pnts[i].anchor;
-                glm::mat4 trans_matrix = glm::translate(glm::mat4(1.0), glm::vec3(anchor.x, anchor.y, anchor.z));
-                trans_matrix = trans_matrix * rotation;
-                trans_matrix = glm::translate(trans_matrix, glm::vec3(-anchor.x, -anchor.y, -anchor.z));
-                
-                // We skip rotations in X cause there is no freedom in that direction.
-                selected->transform(ctrl_pnts[i].indices, ctrl_pnts[i].anchor, trans_matrix);
-                
-            }
+            // Get what is being currently reached in the geometry.
+            glm::vec3 curr_reach = current_ctrl[moving_joint].coords;
+                                
+            // Get current anchor and indices to rotate.
+            glm::vec3 ik_anchor = ik_struc[i].anchor;
+            std::vector<unsigned int> ik_inds = ik_struc[i].indices;
+            
+            // Get the two vectors representing this rotation.
+            glm::vec3 v1 = glm::normalize(curr_reach - ik_anchor);
+            glm::vec3 v2 = glm::normalize(target  - ik_anchor);
+            
+            // Build the quaternion that will give us the desired rotations.
+            glm::vec3 a = glm::cross(v1, v2);
+            glm::quat q;
+            q.x = a.x;
+            q.y = a.y;
+            q.z = a.z;
+            q.w = std::sqrt(std::pow(glm::length(v1), 2) * std::pow(glm::length(v2), 2)) + glm::dot(v1, v2);
+            
+            // Normalize it.
+            q = glm::normalize(q);
+            
+            // Transform it into a matrix so that we can apply it.
+            glm::mat4 rotation = glm::toMat4(q);
+                        
+            // Apply the same transformations to the anchor points and
+            glm::mat4 trans_matrix = glm::translate(glm::mat4(1.0), glm::vec3(ik_anchor.x, ik_anchor.y, ik_anchor.z));
+            trans_matrix = trans_matrix * rotation;
+            trans_matrix = glm::translate(trans_matrix, glm::vec3(-ik_anchor.x, -ik_anchor.y, -ik_anchor.z));
+                        
+            // We skip rotations in X cause there is no freedom in that direction.
+            selected->transform(ik_inds, ik_anchor, trans_matrix);
+            
+            // Update the current control points and ordered control points, as they could have changed.
+            current_ctrl = selected->getControlPoints();
+            ik_struc = selected->getOrderedControlPoints(num_ik, current_ctrl[moving_joint]);
+                                                                        
+            // Check if the arm has mooved during this iteration.
+            if (glm::distance(curr_reach, current_ctrl[moving_joint].coords) >= 0.01)
+                has_moved = true;
+            
+            // Increment the iterations.
+            iterations++;
             
         }
+        
+        // If the number of iterations has surpassed the cube of the IK, skip.
+        if (iterations >= pow(num_ik, 3))
+            break;
 
     }
+    
+}
 
-    // Draw the creature.
-    selected->draw(*shader, *camera);
+void bakeScript(const bgq_opengl::SimulationInput &input) {
     
-    // Update the control points.
-    ctrl_pnts = selected->getControlPoints();
+    // A null or negative frequency would never repeat, so the period is kept finite.
+    float frequency = input.frequency >= SCRIPT_MIN_FREQUENCY ? input.frequency : SCRIPT_MIN_FREQUENCY;
     
-    // Draw the control points.
-    if (show_ctrl == 1 and kinematic != 2) {
+    // The same sinusoids for every arm, each level pushing it further out.
+    const float amplitudes[] = {-input.amplitude, input.amplitude, 2.0f * input.amplitude};
+    const float phases[] = {0.0f, (float) (M_PI / 2.0), (float) (M_PI / 2.0 + asin(-0.8))};
+    const float offsets[] = {input.amplitude / 2.0f, 0.0f, 0.0f};
+    
+    unsigned int num_levels = std::min(3u, script_driver.getNumLevels());
+    for (unsigned int arm = 0; arm < script_driver.getNumArms(); arm++)
+        for (unsigned int level = 0; level < num_levels; level++)
+            script_driver.setOscillator(arm, level, amplitudes[level], frequency, phases[level], offsets[level]);
+    
+    // The motion repeats every period, so one is baked and looped.
+    float period = (float) (2.0 * M_PI / frequency);
+    unsigned int num_joints = jelly->getNumJoints();
+    
+    script_clip = bgq_opengl::AnimationClip::bake(num_joints, period, SCRIPT_CLIP_KEYS / period, [&](float t, bgq_opengl::JointPose &pose) {
+        script_driver.evaluate(t, pose);
+    }, ANIMATION_CLIP_TOLERANCE);
+    
+    script_sampler.setClip(&script_clip);
+    script_clip_amplitude = input.amplitude;
+    script_clip_frequency = input.frequency;
+    
+}
+
+double simulationClock() {
+    
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - sim_epoch).count();
+    
+}
+
+void advanceSimulation(double now) {
+    
+    // Take the latest input, or keep the last one.
+    sim_inputs.update();
+    const bgq_opengl::SimulationInput &input = sim_inputs.getReadBuffer();
+    
+    // Drop the time that cannot be caught up with instead of spiralling.
+    long due = (long) std::floor(now / SIMULATION_STEP + 1e-6);
+    if (due - sim_steps > SIMULATION_MAX_STEPS)
+        sim_steps = due - SIMULATION_MAX_STEPS;
+    
+    // Run every step that is due, always of the same length.
+    while (sim_steps < due) {
+        sim_steps++;
+        simulate(input, sim_states.getWriteBuffer(), sim_steps * SIMULATION_STEP);
+        sim_states.publish();
+    }
+    
+}
+
+void simulationLoop() {
+    
+    while (sim_running.load()) {
         
-        for (int i = 0; i < ctrl_pnts.size(); i++)
-            displayControlPoint(ctrl_pnts[i], 0.2);
+        double now = simulationClock();
+        advanceSimulation(now);
+        
+        // Sleep until the next step is due.
+        double next = (sim_steps + 1) * SIMULATION_STEP;
+        if (next > now)
+            std::this_thread::sleep_for(std::chrono::duration<double>(next - now));
         
     }
     
 }
 
+void publishInput() {
+    
+    // A dragged control point belongs to the creature it was picked on.
+    if (current_scene != input_scene || kinematic != input_kinematic)
+        moving_joint = -1;
+    input_scene = current_scene;
+    input_kinematic = kinematic;
+    
+    bgq_opengl::SimulationInput &input = sim_inputs.getWriteBuffer();
+    input.scene = current_scene;
+    input.kinematic = kinematic;
+    input.ik_level = ik_level;
+    input.moving_joint = moving_joint;
+    input.target = drag_target;
+    input.target_version = drag_version;
+    input.amplitude = script_amplitude;
+    input.frequency = script_frequency;
+    
+    sim_inputs.publish();
+    
+}
+
 void displayGUI() {
     
     // Init ImGUI for rendering.
@@ -304,8 +466,8 @@ void displayGUI() {
     ImGui::RadioButton("IK", &kinematic, 1);
     ImGui::RadioButton("Scripted", &kinematic, 2);
 
-    // This part only makes sense for inverse kinematics.
-    if (kinematic == 1) {
+    // This part only makes sense for inverse kinematics, which also corrects the script.
+    if (kinematic != 0) {
         
         int max_ik = -1;
         for (int i = 0; i < ctrl_pnts.size(); i++) {
@@ -326,45 +488,144 @@ void displayGUI() {
         
     }
     
-    if (kinematic != 2) {
-        
-        // Select whether to display the control points or not.
-        ImGui::Text("Display controls");
-        ImGui::RadioButton("Yes", &show_ctrl, 1);
-        ImGui::RadioButton("No", &show_ctrl, 0);
-        
-    } else {
+    // Select whether to display the control points or not.
+    ImGui::Text("Display controls");
+    ImGui::RadioButton("Yes", &show_ctrl, 1);
+    ImGui::RadioButton("No", &show_ctrl, 0);
+    
+    if (kinematic == 2) {
         
         // The scripted animation parameters.
         ImGui::Text("Script params");
         ImGui::SliderFloat("Amplitude", &script_amplitude, 0.0f, 2.0f);
-        ImGui::SliderFloat("Frequency", &script_frequency, 0.01f, 30.0f);
+        ImGui::SliderFloat("Frequency", &script_frequency, SCRIPT_MIN_FREQUENCY, 30.0f);
 
     }
     
+    // The GL calls saved by the state cache this frame.
+    ImGui::Text("GL state calls: %lu issued, %lu elided", bgq_opengl::GLState::getIssuedCalls(), bgq_opengl::GLState::getElidedCalls());
+    
+    // The segments frustum culling skipped this frame.
+    ImGui::Text("Segments: %u drawn, %u culled", bgq_opengl::RenderStats::getDrawn(), bgq_opengl::RenderStats::getCulled());
+    ImGui::Text("Triangles: %u", bgq_opengl::RenderStats::getTriangles());
+    ImGui::Text("Matrices uploaded: %u", bgq_opengl::RenderStats::getMatrices());
+    ImGui::Text("Textures: %zu loaded, %lu shared", bgq_opengl::TextureCache::getNumImages(), bgq_opengl::TextureCache::getNumShared());
+    ImGui::Text("Simulation: %.3f ms", sim_states.getReadBuffer().solve_time);
+    
+    // What the live GL objects hold on the GPU.
+    ImGui::Separator();
+    ImGui::Text("GPU memory: %.2f MB", bgq_opengl::GPUMemory::getTotalBytes() / (1024.0f * 1024.0f));
+    for (int i = 0; i < bgq_opengl::GPUMemory::NUM_CATEGORIES; i++) {
+        bgq_opengl::GPUMemory::Category category = (bgq_opengl::GPUMemory::Category) i;
+        ImGui::Text("  %s: %.2f MB in %u", bgq_opengl::GPUMemory::getName(category), bgq_opengl::GPUMemory::getBytes(category) / (1024.0f * 1024.0f), bgq_opengl::GPUMemory::getCount(category));
+    }
+    
     ImGui::End();
     
+    // Where the frame time goes.
+    displayProfiler();
+    
     // Render ImGUI.
     ImGui::Render();
     
+    // ImGUI binds its own program, VAO and textures behind the state cache.
+    bgq_opengl::GLState::invalidate();
+    
 }
 
-void displayControlPoint(const bgq_opengl::ControlPoint ctrl_pnt, const float size) {
+void displayProfiler() {
     
-    glDepthFunc(GL_ALWAYS);
+    ImGui::Begin("Profiler");
     
-    // Reset it.
-    dis_pnt->resetTransforms();
+    // Frame time graph, scaled up to two 60 Hz frames.
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "%.2f ms (%.0f fps)", bgq_opengl::Profiler::getFrameTime(), 1000.0f / std::max(bgq_opengl::Profiler::getFrameTime(), 0.001f));
+    ImGui::PlotLines("Frame", bgq_opengl::Profiler::getFrameTimes(), PROFILER_HISTORY, bgq_opengl::Profiler::getHistoryOffset(), overlay, 0.0f, 33.3f, ImVec2(0, 80));
     
-    // Resize it to the desired size.
-    dis_pnt->scale(size, size, size);
+    // Breakdown per stage, nested stages indented.
+    ImGui::Columns(3);
+    ImGui::Text("Stage");
+    ImGui::NextColumn();
+    ImGui::Text("CPU (ms)");
+    ImGui::NextColumn();
+    ImGui::Text("GPU (ms)");
+    ImGui::NextColumn();
+    ImGui::Separator();
     
-    // Center the object and get it in the right position.
-    dis_pnt->translate(ctrl_pnt.coords.x, ctrl_pnt.coords.y, ctrl_pnt.coords.z);
+    for (int i = 0; i < bgq_opengl::Profiler::getNumStages(); i++) {
+        
+        ImGui::Text("%*s%s", 2 * bgq_opengl::Profiler::getStageDepth(i), "", bgq_opengl::Profiler::getStageName(i));
+        ImGui::NextColumn();
+        ImGui::Text("%.3f", bgq_opengl::Profiler::getCpuTime(i));
+        ImGui::NextColumn();
+        ImGui::Text("%.3f", bgq_opengl::Profiler::getGpuTime(i));
+        ImGui::NextColumn();
+        
+    }
     
-    dis_pnt->draw(*shaderPnt, *camera);
+    ImGui::Columns(1);
+    ImGui::End();
     
-    glDepthFunc(GL_LESS);
+}
+
+void printProfiler() {
+    
+    std::cerr << "Frame: " << bgq_opengl::Profiler::getFrameTime() << " ms" << std::endl;
+    
+    for (int i = 0; i < bgq_opengl::Profiler::getNumStages(); i++) {
+        
+        std::cerr << "  " << std::string(2 * bgq_opengl::Profiler::getStageDepth(i), ' ') << bgq_opengl::Profiler::getStageName(i);
+        std::cerr << ": CPU " << bgq_opengl::Profiler::getCpuTime(i) << " ms, GPU " << bgq_opengl::Profiler::getGpuTime(i) << " ms" << std::endl;
+        
+    }
+    
+    std::cerr << "GPU memory: " << bgq_opengl::GPUMemory::getTotalBytes() / 1024 << " KB" << std::endl;
+    
+}
+
+void benchLoaders() {
+    
+    const char *models[] = {"Onyx.glb", "CubeJelly.glb"};
+    const char *loaders[] = {"Assimp", "GLB"};
+    const int runs = 5;
+    
+    for (int m = 0; m < 2; m++) {
+        for (int l = 0; l < 2; l++) {
+            
+            // Wait for the uploads too, they are part of loading.
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < runs; r++)
+                bgq_opengl::Object model(models[m], loaders[l]);
+            glFinish();
+            
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / runs;
+            std::cerr << "Bench: " << models[m] << " with " << loaders[l] << " in " << ms << " ms" << std::endl;
+            
+        }
+    }
+    
+}
+
+void displayControlPoints(const std::vector<bgq_opengl::ControlPoint> &ctrl_pnts, const float size) {
+    
+    if (ctrl_pnts.empty())
+        return;
+    
+    // Gather the position and size of every point.
+    pnt_data.resize(ctrl_pnts.size());
+    for (size_t i = 0; i < ctrl_pnts.size(); i++)
+        pnt_data[i] = glm::vec4(ctrl_pnts[i].coords, size);
+    
+    // Upload them for this frame.
+    pnt_instances->update(pnt_data.data(), (GLsizeiptr) (pnt_data.size() * sizeof(glm::vec4)));
+    
+    // Draw on top of everything.
+    bgq_opengl::GLState::depthFunc(GL_ALWAYS);
+    
+    dis_pnt->drawInstanced(*shaderPnt, *camera, (GLsizei) pnt_data.size());
+    
+    // Restore the depth test.
+    bgq_opengl::GLState::depthFunc(GL_LESS);
     
 }
 
@@ -455,6 +716,13 @@ void buildCube() {
     
     dis_pnt = new bgq_opengl::Object("Sphere.obj", "Assimp");
     
+    // The instances carry the position and size, so the sphere stays at the origin.
+    dis_pnt->resetTransforms();
+    
+    // Attach the per point buffer to the sphere.
+    pnt_instances = new bgq_opengl::VBO((GLsizeiptr) (64 * sizeof(glm::vec4)));
+    dis_pnt->linkInstanceAttribute(*pnt_instances, 6, sizeof(glm::vec4), 0);
+    
 }
 
 void handleKeyEvents() {
@@ -513,12 +781,14 @@ void handleMouseEvents(GLFWwindow* window, double xpos, double ypos) {
             
             // Build the view port.
             glm::vec4 viewport(0.0f, 0.0f, camera->getWidth(), camera->getHeight());
+            glm::mat4 view = camera->getView();
+            glm::mat4 projection = camera->getProjection();
             
             // Loop through all the control points and store the minimum distance.
             for (int i = 0; i < ctrl_pnts.size(); i++) {
                 
                 // Get the screen coordinates for this point.
-                glm::vec3 img_coord = glm::project(ctrl_pnts[i].coords, camera->getView(), camera->getProjection(), viewport);
+                glm::vec3 img_coord = glm::project(ctrl_pnts[i].coords, view, projection, viewport);
                 
                 // Invert the Y coordinates.
                 img_coord.y = camera->getHeight() - img_coord.y;
@@ -533,17 +803,29 @@ void handleMouseEvents(GLFWwindow* window, double xpos, double ypos) {
                 }
                 
             }
+            
+            // It is held where it is until the mouse moves.
+            if (moving_joint != -1) {
+                drag_target = ctrl_pnts[moving_joint].initial;
+                drag_version++;
+            }
                         
             return;
             
         }
         
+        // The points may have been replaced by another creature's since it was picked.
+        if (moving_joint >= (int) ctrl_pnts.size()) {
+            moving_joint = -1;
+            return;
+        }
+        
         // Here we already have a selected point.
         // Let's build a plane using the 0,0,0 to camera normal and the image screen depth of the point.
         
         // Get the screen coordinates by calculating the z as well.
         glm::vec4 reference(ctrl_pnts[moving_joint].initial, 1.0f);
-        reference = (*camera).getProjection() * (*camera).getView() * reference;
+        reference = camera->getCameraMatrix() * reference;
         
         // Build the screen coordinates.
         glm::vec3 screen(xpos, ypos, reference.z / reference.w);
@@ -551,6 +833,10 @@ void handleMouseEvents(GLFWwindow* window, double xpos, double ypos) {
         
         // Move the current control point to the current position of the mouse.
         ctrl_pnts[moving_joint].coords = click;
+        
+        // Send it to the simulation with the next input.
+        drag_target = click;
+        drag_version++;
                 
         return;
 
@@ -565,29 +851,86 @@ void initElements() {
     
     // Init the shader.
     shader = new bgq_opengl::Shader("blinnPhongColor.vert", "blinnPhongColor.frag");
-    shaderPnt = new bgq_opengl::Shader("blinnPhongColor.vert", "red.frag");
+    shaderPnt = new bgq_opengl::Shader("marker.vert", "red.frag");
 
 	// Creates the first camera object
     camera = new bgq_opengl::Camera(glm::vec3(0.0f, 0.0f, 15.0f), glm::vec3(0.0f, -0.0f, -1.0f), 45.0f, 0.1f, 300.0f, WINDOW_WIDTH, WINDOW_HEIGHT);
     
     // Init the creatures.
-    std::vector<int> indOnyx = {0, 1, 2, 3, 4};
-    std::vector<int> parOnyx = {-1, 0, 1, 2, 3};
-    onyx = new bgq_opengl::ObjectHierarchical("Onyx.glb", indOnyx, parOnyx, "left", "inter", "right");
+    // Their hierarchies and joints come from the files themselves.
+    onyx = new bgq_opengl::ObjectHierarchical("Onyx.glb");
+    jelly = new bgq_opengl::ObjectHierarchical("CubeJelly.glb");
     
-    std::vector<int> indJelly = {12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
-    std::vector<int> parJelly = {-1, 0, 1, 2, 0, 4, 5, 0, 7, 8, 0, 10, 11};
-    
-    jelly = new bgq_opengl::ObjectHierarchical("CubeJelly.glb", indJelly, parJelly, "centre", "inter", "down");
+    // Put them in the hierarchy once, in their rest poses, it is refitted as they move.
+    scene_creatures = {onyx, jelly};
+    scene_bbs.resize(scene_creatures.size());
+    for (size_t i = 0; i < scene_creatures.size(); i++)
+        scene_bbs[i] = scene_creatures[i]->getWorldBoundingBox();
+    scene_bvh.build(scene_bbs);
 
     // Get the control points for the onyx.
     ctrl_pnts = onyx->getControlPoints();
-    ctrl_scrp = jelly->getControlPoints();
+    
+    // The jelly is scripted from its rest pose.
+    script_driver.build(*jelly);
+    
+    // Its clip plays at the bottom, with the corrections of IK added on top.
+    script_mixer = bgq_opengl::PoseMixer(jelly->getNumJoints());
+    script_mixer.addLayer(bgq_opengl::PoseMixer::OVERRIDE);
+    script_mixer.addLayer(bgq_opengl::PoseMixer::ADDITIVE);
+    script_mixer.setWeight(SCRIPT_LAYER_IK, 0.0f);
 
 }
 
 void initEnvironment(int argc, char** argv) {
     
+    // Read the command line.
+    for (int i = 1; i < argc; i++) {
+        
+        if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headless_frames = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            headless_output = argv[++i];
+        } else if (strcmp(argv[i], "--bake-rigs") == 0) {
+            headless = true;
+            bake_rigs = true;
+            bgq_opengl::RigCache::setRebuild(true);
+        } else if (strcmp(argv[i], "--bench-loaders") == 0) {
+            headless = true;
+            bench_loaders = true;
+        } else if (strcmp(argv[i], "--residency") == 0 && i + 1 < argc && strcmp(argv[i + 1], "all") == 0) {
+            bgq_opengl::Geometry::setResidency(bgq_opengl::Geometry::KEEP_ALL);
+            i++;
+        } else if (strcmp(argv[i], "--residency") == 0 && i + 1 < argc && strcmp(argv[i + 1], "bounds") == 0) {
+            bgq_opengl::Geometry::setResidency(bgq_opengl::Geometry::KEEP_BOUNDS);
+            i++;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--headless] [--frames N] [--output file.ppm] [--bake-rigs] [--bench-loaders] [--residency all|bounds]" << std::endl;
+            exit(1);
+        }
+        
+    }
+    
+    // Render offscreen without GLFW, ImGui or input.
+    if (headless) {
+        
+        if (!bgq_opengl::Headless::init(WINDOW_WIDTH, WINDOW_HEIGHT))
+            exit(1);
+        
+        std::cerr << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+        std::cerr << "OpenGL version supported " << glGetString(GL_VERSION) << std::endl;
+        
+        glEnable(GL_DEPTH_TEST);
+        bgq_opengl::GLState::depthFunc(GL_LESS);
+        
+        buildCube();
+        
+        return;
+        
+    }
+    
     // start GL context and O/S window using the GLFW helper library
     if (!glfwInit()) {
         
@@ -637,7 +980,7 @@ void initEnvironment(int argc, char** argv) {
 
     // tell GL to only draw onto a pixel if the shape is closer to the viewer
     glEnable(GL_DEPTH_TEST); // enable depth-testing
-    glDepthFunc(GL_LESS); // depth-testing interprets a smaller value as "closer"
+    bgq_opengl::GLState::depthFunc(GL_LESS); // depth-testing interprets a smaller value as "closer"
     
     // Get the elements that will be used to display control points.
     buildCube();
@@ -649,37 +992,137 @@ int main(int argc, char** argv) {
 	// Initialise the environment.
     initEnvironment(argc, argv);
     
+    // Only compare the loaders, nothing is drawn.
+    if (bench_loaders) {
+        benchLoaders();
+        bgq_opengl::Headless::terminate();
+        return 0;
+    }
+    
 	// Initialise the objects and elements.
 	initElements();
     
+    // Loading the models was enough to write their rigs.
+    if (bake_rigs) {
+        clean();
+        return 0;
+    }
+    
+    // Batch runs need every texture from the first frame, the window can show them as they arrive.
+    if (headless)
+        bgq_opengl::TextureCache::finish();
+    
+    // Pose the creature before the first frame.
+    publishInput();
+    double start_time = headless ? 0.0 : simulationClock();
+    sim_steps = (long) std::floor(start_time / SIMULATION_STEP) - 1;
+    advanceSimulation(start_time);
+    
+    // Solve on its own thread from now on, except in batch runs that must be reproducible.
+    if (!headless) {
+        sim_running = true;
+        sim_thread = std::thread(simulationLoop);
+    }
+    
 	// Main loop.
-    while(!glfwWindowShouldClose(window)) {
+    int frame = 0;
+    while(headless ? frame < headless_frames : !glfwWindowShouldClose(window)) {
+        
+        // Start timing this frame.
+        bgq_opengl::Profiler::beginFrame();
+        
+        // Start counting the GL state calls of this frame.
+        bgq_opengl::GLState::resetCounters();
+        bgq_opengl::RenderStats::reset();
         
         // Clear the scene.
+        bgq_opengl::Profiler::begin("clear");
         clear();
+        bgq_opengl::Profiler::end();
         
-        // Get the window size.
-        int width, height;
-        glfwGetWindowSize(window, &width, &height);
-        camera->setWidth(width);
-        camera->setHeight(height);
+        if (headless) {
+            
+            // Advance at a fixed rate so batch runs are reproducible.
+            internal_time = frame / HEADLESS_FRAME_RATE;
+            
+        } else {
+            
+            // Get the window size.
+            int width, height;
+            glfwGetWindowSize(window, &width, &height);
+            camera->setWidth(width);
+            camera->setHeight(height);
+            
+            // Get the current time.
+            internal_time = simulationClock();
+            
+            // Handle key events.
+            bgq_opengl::Profiler::begin("input");
+            handleKeyEvents();
+            bgq_opengl::Profiler::end();
+            
+        }
         
-        // Get the current time.
-        internal_time = glfwGetTime();
-
-        // Handle key events.
-        handleKeyEvents();
+        // Upload the textures decoded since the last frame.
+        bgq_opengl::Profiler::begin("textures");
+        bgq_opengl::TextureCache::update(TEXTURE_CACHE_UPLOAD_BYTES);
+        bgq_opengl::Profiler::end();
+        
+        // Hand this frame's input to the simulation.
+        publishInput();
+        
+        if (headless) {
+            bgq_opengl::Profiler::begin("solve");
+            advanceSimulation(internal_time);
+            bgq_opengl::Profiler::end();
+        }
         
         // Display the scene.
+        bgq_opengl::Profiler::begin("scene");
         displayElements();
+        bgq_opengl::Profiler::end();
+        
+        if (!headless) {
+            
+            // Make the things to print everything.
+            bgq_opengl::Profiler::begin("gui");
+            displayGUI();
+            bgq_opengl::Profiler::end();
+            
+            // Update other events like input handling.
+            bgq_opengl::Profiler::begin("events");
+            glfwPollEvents();
+            bgq_opengl::Profiler::end();
+            
+            bgq_opengl::Profiler::begin("swap");
+            glfwSwapBuffers(window);
+            bgq_opengl::Profiler::end();
+            
+        }
         
-        // Make the things to print everything.
-        displayGUI();
+        bgq_opengl::Profiler::endFrame();
         
-        // Update other events like input handling.
-        glfwPollEvents();
-        glfwSwapBuffers(window);
+        frame++;
         
+    }
+    
+    // Keep the result of the batch run.
+    if (headless) {
+        
+        glFinish();
+        bgq_opengl::Headless::saveFrame(headless_output);
+        std::cerr << frame << " frames rendered, last one saved to " << headless_output << std::endl;
+        
+        // The last frames are still waiting to be read back.
+        bgq_opengl::Profiler::flush();
+        printProfiler();
+        
+    }
+
+    // Stop the simulation before its objects go away.
+    if (sim_thread.joinable()) {
+        sim_running = false;
+        sim_thread.join();
     }
 
 	// Clean everything and terminate.
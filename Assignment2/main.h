@@ -20,32 +20,74 @@
 #define WINDOW_HEIGHT 800
 #define GAME_NAME "Real-time animation"
 #define NORM_SIZE 1.0
+#define HEADLESS_FRAME_RATE 60.0
+#define SIMULATION_STEP (1.0 / 60.0)
+#define SIMULATION_MAX_STEPS 5
+#define SCRIPT_CLIP_KEYS 48.0f
+#define SCRIPT_MIN_FREQUENCY 0.01f
+#define SCRIPT_IK_FADE 0.25
+#define SCRIPT_LAYER_CLIP 0
+#define SCRIPT_LAYER_IK 1
 
 #include <vector>
 #include <string>
 #include <ctime>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 
+#include "classes/bvh/bvh.h"
 #include "classes/camera/camera.h"
+#include "classes/clip_sampler/clip_sampler.h"
 #include "classes/object_hierarchical/object_hierarchical.h"
 #include "classes/object/object.h"
+#include "classes/oscillator_driver/oscillator_driver.h"
+#include "classes/pose_mixer/pose_mixer.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
+#include "classes/triple_buffer/triple_buffer.h"
+#include "classes/vbo/vbo.h"
 #include "classes/turbulence/turbulence.h"
+#include "structs/animation_clip/animation_clip.h"
 #include "structs/control_point/control_point.h"
+#include "structs/joint_pose/joint_pose.h"
+#include "structs/simulation/simulation.h"
 
 bgq_opengl::Camera *camera;                         /// Holds all the existing cameras.
 bgq_opengl::Shader *shader;                         /// Holds all the initialized shanders.
 bgq_opengl::Shader *shaderPnt;                      /// Holds all the initialized shanders used for the control points.
 bgq_opengl::Object *dis_pnt;                        /// The geometry used to display points.
+bgq_opengl::VBO *pnt_instances;                     /// Per frame positions and sizes of the displayed points.
+std::vector<glm::vec4> pnt_data;                    /// CPU copy of the displayed points.
+bgq_opengl::BVH scene_bvh;                          /// Hierarchy of the creatures in the scene.
+std::vector<bgq_opengl::ObjectHierarchical *> scene_creatures;  /// The creatures in scene_bvh, by scene.
+std::vector<bgq_opengl::BoundingBox> scene_bbs;     /// The world box of each creature, as last drawn.
+std::vector<int> scene_visible;                     /// The creatures in the frustum this frame.
 bgq_opengl::ObjectHierarchical *onyx;               /// Holds the onyx.
 bgq_opengl::ObjectHierarchical *jelly;              /// Holds the jellyfish.
 std::vector<bgq_opengl::ControlPoint> ctrl_pnts;    /// Holds the control points for the joints.
-std::vector<bgq_opengl::ControlPoint> ctrl_scrp;    /// Holds the control points for the joints.
+std::vector<bgq_opengl::ControlPoint> sim_ctrl_pnts;    /// The control points owned by the simulation.
+bgq_opengl::ObjectHierarchical *sim_selected = 0;   /// The creature sim_ctrl_pnts belong to.
+unsigned long sim_target_version = 0;               /// The last drag target the simulation took.
+glm::vec3 drag_target(0.0f);                        /// Where the dragged control point was moved.
+unsigned long drag_version = 0;                     /// Changes every time drag_target does.
+bgq_opengl::TripleBuffer<bgq_opengl::SimulationInput> sim_inputs;   /// Inputs from the render thread.
+bgq_opengl::TripleBuffer<bgq_opengl::SimulationState> sim_states;   /// Poses from the simulation thread.
+std::thread sim_thread;                             /// The simulation thread.
+std::atomic<bool> sim_running(false);               /// Whether the simulation thread keeps going.
+std::chrono::steady_clock::time_point sim_epoch = std::chrono::steady_clock::now();  /// When the simulation clock started.
+long sim_steps = 0;                                 /// Number of the last step simulated.
+bgq_opengl::SimulationState render_previous;        /// The pose before the latest one.
+bgq_opengl::SimulationState render_current;         /// The latest pose taken.
+bgq_opengl::Pose render_pose;                       /// The pose drawn this frame.
+float render_alpha = -1.0f;                         /// The blend between the last two poses drawn last frame.
 int current_scene = 0;                              /// The current scene being loaded.
 int moving_joint = -1;                              /// The moving joint control point.
+int input_scene = -1;                               /// The scene of the last input published.
+int input_kinematic = -1;                           /// The kinematic method of the last input published.
 int kinematic = 0;                                  /// The kinematic method used.
 int show_ctrl = 1;                                  /// Whether to display the control points or not.
 int ik_level = 2;                                   /// The number of bones to take into account in ik.
@@ -54,6 +96,19 @@ double internal_time = 0;					        /// Time that will rule everything in the
 bgq_opengl::Light scene_light;                      /// The light in the scene.
 float script_amplitude = 0.5f;                     /// The amplitude of the jellyfish motion.
 float script_frequency = 0.9f;                      /// The frequency of the jellyfish motion.
+bgq_opengl::OscillatorDriver script_driver;         /// The sinusoids that move the jellyfish.
+bgq_opengl::AnimationClip script_clip;              /// The jellyfish motion baked for the current parameters.
+bgq_opengl::ClipSampler script_sampler;             /// Plays script_clip.
+bgq_opengl::PoseMixer script_mixer;                 /// The layers of the jellyfish motion: the clip and the IK corrections.
+bgq_opengl::JointPose script_ik_pose;               /// The jellyfish pose solved by IK from the clip.
+bgq_opengl::JointPose script_pose;                  /// The jellyfish pose after mixing its layers.
+float script_clip_amplitude = -1.0f;                /// The amplitude script_clip was baked for.
+float script_clip_frequency = -1.0f;                /// The frequency script_clip was baked for.
+bool headless = false;                              /// Whether to render offscreen without a window.
+int headless_frames = 1;                            /// The number of frames to render in headless mode.
+const char *headless_output = "frame.ppm";          /// Where the last headless frame is saved.
+bool bake_rigs = false;                             /// Whether to only rebuild the cached rigs and exit.
+bool bench_loaders = false;                         /// Whether to only time the model loaders and exit.
 
 const glm::vec4 background(82 / 255.0, 103 / 255.0, 125 / 255.0, 1.0);
 
@@ -85,6 +140,76 @@ void buildCube();
  */
 void displayElements();
 
+/**
+ * @brief Run a simulation step.
+ *
+ * Solve IK, FK or the scripted animation for an input and store the resulting pose.
+ * Only the simulation thread touches the creatures and their control points here.
+ *
+ * @param input The input of the step.
+ * @param state Where the pose is stored.
+ * @param time The simulation time of the step.
+ */
+void simulate(const bgq_opengl::SimulationInput &input, bgq_opengl::SimulationState &state, double time);
+
+/**
+ * @brief Solve IK for a dragged control point.
+ *
+ * Rotate the bones above a control point, up to a number of them, until it
+ * reaches a target or the iterations run out. The creature is changed in place.
+ *
+ * @param selected The creature.
+ * @param moving_joint The control point.
+ * @param target Where it has to reach.
+ * @param ik_level The number of bones used.
+ */
+void solveIK(bgq_opengl::ObjectHierarchical *selected, int moving_joint, const glm::vec3 &target, int ik_level);
+
+/**
+ * @brief Bake the jellyfish script.
+ *
+ * Set the sinusoids of script_driver for the script parameters and bake one
+ * period of them at SCRIPT_CLIP_KEYS keys into script_clip, which script_sampler
+ * then loops.
+ *
+ * @param input The input holding the script parameters.
+ */
+void bakeScript(const bgq_opengl::SimulationInput &input);
+
+/**
+ * @brief Get the simulation clock.
+ *
+ * Get the seconds elapsed since the program started, from a monotonic clock.
+ *
+ * @returns The time.
+ */
+double simulationClock();
+
+/**
+ * @brief Advance the simulation to a time.
+ *
+ * Take the latest input and run every fixed step of SIMULATION_STEP seconds due
+ * by that time, publishing each pose. At most SIMULATION_MAX_STEPS are run, the
+ * rest of the time is dropped.
+ *
+ * @param now The time to advance to.
+ */
+void advanceSimulation(double now);
+
+/**
+ * @brief The simulation thread.
+ *
+ * Keep advancing the simulation at its fixed rate until sim_running is cleared.
+ */
+void simulationLoop();
+
+/**
+ * @brief Publish the input of this frame.
+ *
+ * Gather the GUI settings and the dragged control point for the simulation.
+ */
+void publishInput();
+
 /**
  * @brief Display the GUI.
  *
@@ -93,14 +218,36 @@ void displayElements();
 void displayGUI();
 
 /**
- * @brief Display a control point in the scene.
+ * @brief Display the profiler.
  *
- * Display a control point in the scene.
+ * Display the frame time graph and the time of every stage in its own window.
+ */
+void displayProfiler();
+
+/**
+ * @brief Print the profiler.
+ *
+ * Print the average time of every stage, used at the end of headless runs.
+ */
+void printProfiler();
+
+/**
+ * @brief Time the model loaders.
  *
- * @param ctrl_pnt The control point that will be displayed.
- * @param size The size that will be used for displaying the point.
+ * Load every model with Assimp and with the GLB loader a few times and print how
+ * long each took on average.
  */
-void displayControlPoint(const bgq_opengl::ControlPoint ctrl_pnt, const float size);
+void benchLoaders();
+
+/**
+ * @brief Display the control points in the scene.
+ *
+ * Display all the control points in the scene with a single instanced draw.
+ *
+ * @param ctrl_pnts The control points that will be displayed.
+ * @param size The size that will be used for displaying the points.
+ */
+void displayControlPoints(const std::vector<bgq_opengl::ControlPoint> &ctrl_pnts, const float size);
 
 /**
  * @brief Handles the key events.
@@ -130,7 +277,14 @@ void initElements();
 /**
  * @brief Init the environment.
  *
- * Initialize the OpenGL, Glew and Freeglut environments.
+ * Initialize the OpenGL, Glew and GLFW environments. With --headless it creates
+ * an offscreen context instead, --frames sets how many frames to render and
+ * --output where to save the last one. --bake-rigs loads the models offscreen,
+ * rewrites their cached rigs and exits. --residency sets what the geometries keep
+ * on the CPU once uploaded: everything or only the bounds.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
  */
 void initEnvironment(int argc, char** argv);
 
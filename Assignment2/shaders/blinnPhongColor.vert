@@ -1,7 +1,7 @@
 #version 330 core
 
 layout (location = 0) in vec3 inVertex; // Vertex.
-layout (location = 1) in vec3 inNormal; // Normal (not necessarily normalized).
+layout (location = 1) in vec3 inNormal; // Normal (not necessarily normalized, maybe octahedral).
 layout (location = 2) in vec3 inColor;  // Color (not necessarily normalized).
 layout (location = 3) in vec2 inUV;     // UV coordinates.
 
@@ -11,19 +11,57 @@ uniform mat4 Projection;                // Imports the projection matrix.
 uniform mat4 modelView;                 // Imports the modelView already multiplied.
 uniform mat4 normalMatrix;              // Imports the normal matrix.
 uniform vec3 cameraPosition;            // Position of the camera.
+uniform vec3 positionScale;             // Scale that decodes quantized positions.
+uniform vec3 positionOffset;            // Offset that decodes quantized positions.
+uniform bool octNormals;                // Whether normals are octahedral encoded.
+uniform samplerBuffer nodeMatrices;     // Streamed model and normal matrices, 7 texels per node.
+uniform int matrixIndex;                // Node to read from nodeMatrices, or -1 to use the uniforms.
 
 out vec3 vertexNormal;                  // Passes the normal to the fragment shader.
 out vec3 vertexColor;                   // Passes the color to the fragment shader.
 out vec2 vertexUV;                      // Passes the UV coordinates to the fragment shader.
 out vec3 vertexPosition;                // Passes the current vertex to the fragment shader.
 
+vec3 decodeNormal() {
+    
+    // Float normals come as they are.
+    if (!octNormals)
+        return inNormal;
+    
+    // Unfold the octahedron.
+    vec3 n = vec3(inNormal.xy, 1.0 - abs(inNormal.x) - abs(inNormal.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    
+    return normalize(n);
+    
+}
+
 void main() {
     
+    // Decode the position from the vertex layout.
+    vec3 position = inVertex * positionScale + positionOffset;
+    
+    // Get the matrices from the uniforms or from the stream.
+    mat4 model_view = modelView;
+    mat3 normal_matrix = mat3(normalMatrix);
+    if (matrixIndex >= 0) {
+        
+        int base = matrixIndex * 7;
+        mat4 model = mat4(texelFetch(nodeMatrices, base), texelFetch(nodeMatrices, base + 1), texelFetch(nodeMatrices, base + 2), texelFetch(nodeMatrices, base + 3));
+        mat3 normal_model = mat3(texelFetch(nodeMatrices, base + 4).xyz, texelFetch(nodeMatrices, base + 5).xyz, texelFetch(nodeMatrices, base + 6).xyz);
+        
+        // The view is rigid, so its rotation is its own normal matrix.
+        model_view = View * model;
+        normal_matrix = mat3(View) * normal_model;
+        
+    }
+    
     // Assigns the direct passes.
-    vertexNormal = vec3(normalMatrix * vec4(inNormal, 0.0));
+    vertexNormal = normal_matrix * decodeNormal();
     vertexColor = inColor;
     vertexUV = mat2(0.0, -1.0, 1.0, 0.0) * inUV;
-    vertexPosition = vec3(modelView * vec4(inVertex, 1.0));
+    vertexPosition = vec3(model_view * vec4(position, 1.0));
     
     // Sets the visualized position by applying the camera matrix.
     gl_Position = Projection * vec4(vertexPosition, 1.0);
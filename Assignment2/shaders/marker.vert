@@ -0,0 +1,53 @@
+#version 330 core
+
+layout (location = 0) in vec3 inVertex; // Vertex.
+layout (location = 1) in vec3 inNormal; // Normal (not necessarily normalized, maybe octahedral).
+layout (location = 2) in vec3 inColor;  // Color (not necessarily normalized).
+layout (location = 3) in vec2 inUV;     // UV coordinates.
+layout (location = 6) in vec4 inMarker; // Marker position (xyz) and size (w), one per instance.
+
+uniform mat4 Model;                     // Imports the model matrix.
+uniform mat4 View;                      // Imports the View matrix.
+uniform mat4 Projection;                // Imports the projection matrix.
+uniform mat4 modelView;                 // Imports the modelView already multiplied.
+uniform mat4 normalMatrix;              // Imports the normal matrix.
+uniform vec3 cameraPosition;            // Position of the camera.
+uniform vec3 positionScale;             // Scale that decodes quantized positions.
+uniform vec3 positionOffset;            // Offset that decodes quantized positions.
+uniform bool octNormals;                // Whether normals are octahedral encoded.
+
+out vec3 vertexNormal;                  // Passes the normal to the fragment shader.
+out vec3 vertexColor;                   // Passes the color to the fragment shader.
+out vec2 vertexUV;                      // Passes the UV coordinates to the fragment shader.
+out vec3 vertexPosition;                // Passes the current vertex to the fragment shader.
+
+vec3 decodeNormal() {
+    
+    // Float normals come as they are.
+    if (!octNormals)
+        return inNormal;
+    
+    // Unfold the octahedron.
+    vec3 n = vec3(inNormal.xy, 1.0 - abs(inNormal.x) - abs(inNormal.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    
+    return normalize(n);
+    
+}
+
+void main() {
+    
+    // Decode the position from the vertex layout, then scale and move it to the marker.
+    vec3 position = (inVertex * positionScale + positionOffset) * inMarker.w + inMarker.xyz;
+    
+    // Assigns the direct passes.
+    vertexNormal = vec3(normalMatrix * vec4(decodeNormal(), 0.0));
+    vertexColor = inColor;
+    vertexUV = mat2(0.0, -1.0, 1.0, 0.0) * inUV;
+    vertexPosition = vec3(modelView * vec4(position, 1.0));
+    
+    // Sets the visualized position by applying the camera matrix.
+    gl_Position = Projection * vec4(vertexPosition, 1.0);
+    
+}
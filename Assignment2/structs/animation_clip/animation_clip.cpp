@@ -0,0 +1,156 @@
+/**
+ * @file animation_clip.cpp
+ * @brief AnimationClip struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "animation_clip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "structs/joint_pose/joint_pose.h"
+
+namespace bgq_opengl {
+
+    namespace {
+
+        // Whether the keys between two others are reproduced by interpolating them.
+        bool isRedundant(const std::vector<AnimationClip::Key> &keys, size_t first, size_t last, float tolerance) {
+
+            const AnimationClip::Key &a = keys[first];
+            const AnimationClip::Key &b = keys[last];
+            glm::quat end = glm::dot(a.rotation, b.rotation) < 0.0f ? -b.rotation : b.rotation;
+
+            for (size_t i = first + 1; i < last; i++) {
+
+                float t = (keys[i].time - a.time) / (b.time - a.time);
+                glm::vec4 mixed = glm::mix(glm::vec4(a.rotation.x, a.rotation.y, a.rotation.z, a.rotation.w), glm::vec4(end.x, end.y, end.z, end.w), t);
+                glm::quat rotation = glm::normalize(glm::quat(mixed.w, mixed.x, mixed.y, mixed.z));
+
+                if (1.0f - std::fabs(glm::dot(rotation, keys[i].rotation)) > tolerance)
+                    return false;
+                if (glm::length(glm::mix(a.translation, b.translation, t) - keys[i].translation) > tolerance)
+                    return false;
+
+            }
+
+            return true;
+
+        }
+
+    }
+
+    void AnimationClip::addTrack(unsigned int joint, std::vector<Key> keys) {
+
+        // A track without keys has nothing to sample.
+        if (keys.empty())
+            return;
+
+        std::stable_sort(keys.begin(), keys.end(), [](const Key &a, const Key &b) { return a.time < b.time; });
+
+        if (this->starts.empty())
+            this->starts.push_back(0);
+
+        for (size_t i = 0; i < keys.size(); i++) {
+
+            glm::quat rotation = glm::normalize(keys[i].rotation);
+
+            // Stay on the hemisphere of the previous key.
+            if (i > 0 && glm::dot(rotation, glm::quat(this->rw.back(), this->rx.back(), this->ry.back(), this->rz.back())) < 0.0f)
+                rotation = -rotation;
+
+            this->times.push_back(keys[i].time);
+            this->rx.push_back(rotation.x);
+            this->ry.push_back(rotation.y);
+            this->rz.push_back(rotation.z);
+            this->rw.push_back(rotation.w);
+            this->tx.push_back(keys[i].translation.x);
+            this->ty.push_back(keys[i].translation.y);
+            this->tz.push_back(keys[i].translation.z);
+
+        }
+
+        this->joints.push_back(joint);
+        this->starts.push_back((unsigned int) this->times.size());
+        this->num_joints = std::max(this->num_joints, (size_t) joint + 1);
+
+        this->duration = std::max(this->duration, keys.back().time);
+
+    }
+
+    size_t AnimationClip::getNumTracks() const {
+
+        return this->joints.size();
+
+    }
+
+    size_t AnimationClip::getNumKeys() const {
+
+        return this->times.size();
+
+    }
+
+    AnimationClip AnimationClip::bake(size_t num_joints, float duration, float rate, const std::function<void(float, JointPose &)> &evaluate, float tolerance) {
+
+        int frames = std::max(1, (int) std::ceil(duration * rate));
+
+        // Evaluate the motion once per frame, then split it into tracks.
+        std::vector<std::vector<Key>> tracks(num_joints);
+        JointPose pose;
+        for (int f = 0; f <= frames; f++) {
+
+            float time = duration * f / frames;
+
+            pose.resize(num_joints);
+            pose.setIdentity();
+            evaluate(time, pose);
+
+            for (size_t j = 0; j < num_joints; j++)
+                tracks[j].push_back(Key{time, pose.getRotation(j), pose.getTranslation(j)});
+
+        }
+
+        AnimationClip clip;
+        clip.num_joints = num_joints;
+
+        for (size_t j = 0; j < num_joints; j++) {
+
+            // Drop the keys their neighbours reproduce, always keeping both ends.
+            const std::vector<Key> &keys = tracks[j];
+            std::vector<Key> kept = {keys.front()};
+            size_t last = 0;
+            for (size_t i = 1; i + 1 < keys.size(); i++) {
+                if (!isRedundant(keys, last, i + 1, tolerance)) {
+                    kept.push_back(keys[i]);
+                    last = i;
+                }
+            }
+            kept.push_back(keys.back());
+
+            clip.addTrack((unsigned int) j, kept);
+
+        }
+
+        clip.duration = duration;
+
+        return clip;
+
+    }
+
+} // namespace bgq_opengl
@@ -0,0 +1,111 @@
+/**
+ * @file animation_clip.h
+ * @brief AnimationClip struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_ANIMATION_CLIP_H_
+#define BGQ_OPENGL_STRUCT_ANIMATION_CLIP_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "structs/joint_pose/joint_pose.h"
+
+#define ANIMATION_CLIP_TOLERANCE 1e-4f  // Error usually allowed when dropping baked keys.
+
+namespace bgq_opengl {
+
+    /**
+     * @brief An animation clip struct.
+     *
+     * This Struct holds a compiled animation: a track of keyframes for each joint
+     * it moves, every key a local rotation and translation as in a JointPose. The
+     * keys of all the tracks are stored back to back, one array per component,
+     * so that a sampler can walk them without chasing pointers.
+     */
+    struct AnimationClip {
+
+        /**
+         * @brief A keyframe of a track.
+         */
+        struct Key {
+
+            float time;                 /// When it happens, in seconds.
+            glm::quat rotation;         /// The rotation of the joint.
+            glm::vec3 translation;      /// The translation of the joint.
+
+        };
+
+        float duration = 0.0f;                      /// Its length in seconds.
+        bool loop = true;                           /// Whether it wraps around when played past its end.
+        size_t num_joints = 0;                      /// The number of joints of the rig it is meant for.
+        std::vector<unsigned int> joints;           /// The joint of each track.
+        std::vector<unsigned int> starts;           /// The first key of each track, and one past the last one.
+        std::vector<float> times;                   /// The time of each key.
+        std::vector<float> rx, ry, rz, rw;          /// The rotation of each key.
+        std::vector<float> tx, ty, tz;              /// The translation of each key.
+
+        /**
+         * @brief Add a track.
+         *
+         * Compile the keys of a joint into the clip: they are sorted by time and
+         * every rotation is put on the hemisphere of the previous one, so that
+         * sampling never goes the long way around. The duration grows to the last
+         * key. A track without keys is skipped.
+         *
+         * @param joint The joint it moves.
+         * @param keys Its keys.
+         */
+        void addTrack(unsigned int joint, std::vector<Key> keys);
+
+        /**
+         * @brief Get the number of tracks.
+         *
+         * @returns The number of tracks.
+         */
+        size_t getNumTracks() const;
+
+        /**
+         * @brief Get the number of keys.
+         *
+         * @returns The number of keys of all the tracks.
+         */
+        size_t getNumKeys() const;
+
+        /**
+         * @brief Bake a motion into a clip.
+         *
+         * Evaluate a motion at a fixed rate over a duration and keep a track for
+         * every joint. Keys that the interpolation of their neighbours already
+         * reproduces within the tolerance are dropped, so joints that do not move
+         * end up with two keys.
+         *
+         * @param num_joints The number of joints of the rig.
+         * @param duration The length of the clip in seconds.
+         * @param rate The keys per second.
+         * @param evaluate Outputs the pose of the motion at a time, already sized.
+         * @param tolerance The error allowed when dropping keys.
+         *
+         * @returns The clip.
+         */
+        static AnimationClip bake(size_t num_joints, float duration, float rate, const std::function<void(float, JointPose &)> &evaluate, float tolerance);
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_ANIMATION_CLIP_H_
@@ -30,6 +30,50 @@ namespace bgq_opengl {
 		glm::vec3 min;	// Minimum vertex.
 		glm::vec3 max; // Maximum vertex.
 
+		/**
+		 * @brief Transform the box.
+		 *
+		 * Get the axis aligned box that contains this box after a transformation.
+		 *
+		 * @param matrix The transformation.
+		 *
+		 * @returns The transformed box.
+		 */
+		BoundingBox transform(const glm::mat4 &matrix) const {
+
+			// Start from the translation and add each axis extent (Arvo).
+			BoundingBox bb{glm::vec3(matrix[3]), glm::vec3(matrix[3])};
+
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+
+					float a = matrix[j][i] * this->min[j];
+					float b = matrix[j][i] * this->max[j];
+
+					bb.min[i] += a < b ? a : b;
+					bb.max[i] += a < b ? b : a;
+
+				}
+			}
+
+			return bb;
+
+		}
+
+		/**
+		 * @brief Merge another box.
+		 *
+		 * Grow this box so it also contains another one.
+		 *
+		 * @param other The other box.
+		 */
+		void merge(const BoundingBox &other) {
+
+			this->min = glm::min(this->min, other.min);
+			this->max = glm::max(this->max, other.max);
+
+		}
+
 	};
 
 } // namespace bgq_opengl
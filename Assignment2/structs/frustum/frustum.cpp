@@ -0,0 +1,82 @@
+/**
+ * @file frustum.cpp
+ * @brief Frustum struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "frustum.h"
+
+#include <cmath>
+
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+
+namespace bgq_opengl {
+
+    Frustum Frustum::fromMatrix(const glm::mat4 &camera_matrix) {
+
+        // glm is column major, so get the rows first.
+        glm::vec4 row[4];
+        for (int i = 0; i < 4; i++)
+            row[i] = glm::vec4(camera_matrix[0][i], camera_matrix[1][i], camera_matrix[2][i], camera_matrix[3][i]);
+
+        // Gribb and Hartmann: each plane is the last row plus or minus another one.
+        Frustum frustum;
+        frustum.planes[0] = row[3] + row[0];
+        frustum.planes[1] = row[3] - row[0];
+        frustum.planes[2] = row[3] + row[1];
+        frustum.planes[3] = row[3] - row[1];
+        frustum.planes[4] = row[3] + row[2];
+        frustum.planes[5] = row[3] - row[2];
+
+        // Normalize them so that distances are in world units.
+        for (int i = 0; i < 6; i++)
+            frustum.planes[i] /= glm::length(glm::vec3(frustum.planes[i]));
+
+        return frustum;
+
+    }
+
+    Frustum::Result Frustum::test(const BoundingBox &bb) const {
+
+        Result result = INSIDE;
+
+        for (int i = 0; i < 6; i++) {
+
+            const glm::vec4 &p = this->planes[i];
+
+            // The corner furthest along the normal and the one furthest against it.
+            glm::vec3 positive(p.x >= 0.0f ? bb.max.x : bb.min.x, p.y >= 0.0f ? bb.max.y : bb.min.y, p.z >= 0.0f ? bb.max.z : bb.min.z);
+            glm::vec3 negative(p.x >= 0.0f ? bb.min.x : bb.max.x, p.y >= 0.0f ? bb.min.y : bb.max.y, p.z >= 0.0f ? bb.min.z : bb.max.z);
+
+            // Completely behind one plane.
+            if (glm::dot(glm::vec3(p), positive) + p.w < 0.0f)
+                return OUTSIDE;
+
+            // Crossing this plane.
+            if (glm::dot(glm::vec3(p), negative) + p.w < 0.0f)
+                result = INTERSECTS;
+
+        }
+
+        return result;
+
+    }
+
+    bool Frustum::intersects(const BoundingBox &bb) const {
+
+        return this->test(bb) != OUTSIDE;
+
+    }
+
+} // namespace bgq_opengl
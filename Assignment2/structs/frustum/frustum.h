@@ -0,0 +1,79 @@
+/**
+ * @file frustum.h
+ * @brief Frustum struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_FRUSTUM_H_
+#define BGQ_OPENGL_STRUCT_FRUSTUM_H_
+
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+
+namespace bgq_opengl {
+
+    /**
+     * @brief A view frustum struct.
+     *
+     * This Struct holds the six planes of a view frustum in world space, with their
+     * normals pointing inside, and tests bounding boxes against them.
+     */
+    struct Frustum {
+
+        /**
+         * @brief The result of a test.
+         *
+         * Whether a box is completely outside, crossing the planes or completely inside.
+         */
+        enum Result { OUTSIDE, INTERSECTS, INSIDE };
+
+        glm::vec4 planes[6];    /// Left, right, bottom, top, near and far planes.
+
+        /**
+         * @brief Extract the frustum of a camera matrix.
+         *
+         * Extract the planes of the frustum from a projection * view matrix.
+         *
+         * @param camera_matrix The camera matrix.
+         *
+         * @returns The frustum.
+         */
+        static Frustum fromMatrix(const glm::mat4 &camera_matrix);
+
+        /**
+         * @brief Test a box against the frustum.
+         *
+         * Test an axis aligned box against the frustum.
+         *
+         * @param bb The box in world space.
+         *
+         * @returns Whether it is outside, intersecting or inside.
+         */
+        Result test(const BoundingBox &bb) const;
+
+        /**
+         * @brief Check if a box is visible.
+         *
+         * Check if an axis aligned box is at least partially inside the frustum.
+         *
+         * @param bb The box in world space.
+         *
+         * @returns True if it is not completely outside.
+         */
+        bool intersects(const BoundingBox &bb) const;
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_FRUSTUM_H_
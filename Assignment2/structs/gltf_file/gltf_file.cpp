@@ -0,0 +1,660 @@
+/**
+ * @file gltf_file.cpp
+ * @brief GltfFile struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gltf_file.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace bgq_opengl {
+
+    namespace {
+
+        // A JSON value, just enough to walk a glTF document.
+        struct Json {
+
+            enum Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+            Type type = NUL;
+            bool boolean = false;
+            double number = 0.0;
+            std::string string;
+            std::vector<Json> array;
+            std::vector<std::pair<std::string, Json>> members;
+
+            // Get a member of an object, or 0 if there is none.
+            const Json *get(const char *key) const {
+                for (size_t i = 0; i < members.size(); i++)
+                    if (members[i].first == key)
+                        return &members[i].second;
+                return 0;
+            }
+
+            // Get a numeric member, or a default.
+            double getNumber(const char *key, double fallback) const {
+                const Json *value = get(key);
+                return value && value->type == NUMBER ? value->number : fallback;
+            }
+
+            // Get an index member, or -1.
+            int getIndex(const char *key) const {
+                return (int) getNumber(key, -1.0);
+            }
+
+            // Get a string member, or an empty one.
+            std::string getString(const char *key) const {
+                const Json *value = get(key);
+                return value && value->type == STRING ? value->string : std::string();
+            }
+
+            // Get the numbers of an array member.
+            std::vector<float> getFloats(const char *key) const {
+                std::vector<float> values;
+                const Json *value = get(key);
+                if (value && value->type == ARRAY)
+                    for (size_t i = 0; i < value->array.size(); i++)
+                        values.push_back((float) value->array[i].number);
+                return values;
+            }
+
+        };
+
+        // A recursive descent JSON parser over the JSON chunk.
+        class JsonParser {
+
+            public:
+
+                JsonParser(const char *text, size_t size) : p(text), end(text + size) {}
+
+                bool parse(Json &value) {
+                    return this->parseValue(value, 0) && (this->skip(), this->p == this->end);
+                }
+
+            private:
+
+                const char *p;
+                const char *end;
+
+                void skip() {
+                    while (this->p < this->end && (isspace((unsigned char) *this->p) || *this->p == '\0'))
+                        this->p++;
+                }
+
+                bool literal(const char *word) {
+                    size_t length = strlen(word);
+                    if ((size_t) (this->end - this->p) < length || strncmp(this->p, word, length) != 0)
+                        return false;
+                    this->p += length;
+                    return true;
+                }
+
+                bool parseString(std::string &out) {
+                    if (this->p >= this->end || *this->p != '"')
+                        return false;
+                    this->p++;
+                    while (this->p < this->end && *this->p != '"') {
+                        char c = *this->p++;
+                        if (c != '\\') {
+                            out += c;
+                            continue;
+                        }
+                        if (this->p >= this->end)
+                            return false;
+                        char e = *this->p++;
+                        switch (e) {
+                            case 'b': out += '\b'; break;
+                            case 'f': out += '\f'; break;
+                            case 'n': out += '\n'; break;
+                            case 'r': out += '\r'; break;
+                            case 't': out += '\t'; break;
+                            case 'u': {
+                                // Names are all that use strings, keep the code point as UTF-8.
+                                if (this->end - this->p < 4)
+                                    return false;
+                                unsigned int code = (unsigned int) strtoul(std::string(this->p, 4).c_str(), 0, 16);
+                                this->p += 4;
+                                if (code < 0x80) {
+                                    out += (char) code;
+                                } else if (code < 0x800) {
+                                    out += (char) (0xC0 | (code >> 6));
+                                    out += (char) (0x80 | (code & 0x3F));
+                                } else {
+                                    out += (char) (0xE0 | (code >> 12));
+                                    out += (char) (0x80 | ((code >> 6) & 0x3F));
+                                    out += (char) (0x80 | (code & 0x3F));
+                                }
+                                break;
+                            }
+                            default: out += e; break;
+                        }
+                    }
+                    if (this->p >= this->end)
+                        return false;
+                    this->p++;
+                    return true;
+                }
+
+                bool parseValue(Json &value, int depth) {
+
+                    this->skip();
+                    if (this->p >= this->end || depth > 64)
+                        return false;
+
+                    char c = *this->p;
+
+                    if (c == '{') {
+                        value.type = Json::OBJECT;
+                        this->p++;
+                        this->skip();
+                        if (this->p < this->end && *this->p == '}') {
+                            this->p++;
+                            return true;
+                        }
+                        while (true) {
+                            std::pair<std::string, Json> member;
+                            this->skip();
+                            if (!this->parseString(member.first))
+                                return false;
+                            this->skip();
+                            if (this->p >= this->end || *this->p++ != ':')
+                                return false;
+                            if (!this->parseValue(member.second, depth + 1))
+                                return false;
+                            value.members.push_back(std::move(member));
+                            this->skip();
+                            if (this->p >= this->end)
+                                return false;
+                            if (*this->p == ',') {
+                                this->p++;
+                                continue;
+                            }
+                            return *this->p++ == '}';
+                        }
+                    }
+
+                    if (c == '[') {
+                        value.type = Json::ARRAY;
+                        this->p++;
+                        this->skip();
+                        if (this->p < this->end && *this->p == ']') {
+                            this->p++;
+                            return true;
+                        }
+                        while (true) {
+                            value.array.emplace_back();
+                            if (!this->parseValue(value.array.back(), depth + 1))
+                                return false;
+                            this->skip();
+                            if (this->p >= this->end)
+                                return false;
+                            if (*this->p == ',') {
+                                this->p++;
+                                continue;
+                            }
+                            return *this->p++ == ']';
+                        }
+                    }
+
+                    if (c == '"') {
+                        value.type = Json::STRING;
+                        return this->parseString(value.string);
+                    }
+
+                    if (this->literal("true")) {
+                        value.type = Json::BOOLEAN;
+                        value.boolean = true;
+                        return true;
+                    }
+
+                    if (this->literal("false")) {
+                        value.type = Json::BOOLEAN;
+                        return true;
+                    }
+
+                    if (this->literal("null"))
+                        return true;
+
+                    // A number, which strtod reads as long as it is followed by something else.
+                    std::string digits;
+                    while (this->p < this->end && (isdigit((unsigned char) *this->p) || strchr("+-.eE", *this->p)))
+                        digits += *this->p++;
+                    if (digits.empty())
+                        return false;
+                    value.type = Json::NUMBER;
+                    value.number = strtod(digits.c_str(), 0);
+                    return true;
+
+                }
+
+        };
+
+        // Get the number of components of an accessor type.
+        int getComponents(const std::string &type) {
+
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4") return 4;
+            if (type == "MAT2") return 4;
+            if (type == "MAT3") return 9;
+            if (type == "MAT4") return 16;
+
+            return 0;
+
+        }
+
+        // Read a 32 bits little endian integer.
+        uint32_t readUint(const unsigned char *data) {
+
+            return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+
+        }
+
+    }
+
+    int GltfFile::Primitive::getAttribute(const std::string &name) const {
+
+        std::map<std::string, int>::const_iterator it = this->attributes.find(name);
+
+        return it == this->attributes.end() ? -1 : it->second;
+
+    }
+
+    bool GltfFile::isGltfFile(const std::string &path) {
+
+        std::string extension = path.size() >= 4 ? path.substr(path.size() - 4) : "";
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+        return extension == ".glb";
+
+    }
+
+    bool GltfFile::read(const unsigned char *data, size_t size, GltfFile &file, std::string &error) {
+
+        file = GltfFile();
+
+        // Check the header and find the chunks.
+        if (size < 20 || readUint(data) != GLTF_FILE_MAGIC || readUint(data + 4) != 2) {
+            error = "not a version 2 GLB file";
+            return false;
+        }
+
+        size_t length = std::min((size_t) readUint(data + 8), size);
+        size_t json_size = readUint(data + 12);
+        if (readUint(data + 16) != GLTF_FILE_CHUNK_JSON || 20 + json_size > length) {
+            error = "the JSON chunk is missing";
+            return false;
+        }
+
+        size_t bin_chunk = 20 + ((json_size + 3) & ~(size_t) 3);
+        if (bin_chunk + 8 <= length && readUint(data + bin_chunk + 4) == GLTF_FILE_CHUNK_BIN) {
+            file.binary = data + bin_chunk + 8;
+            file.binary_size = std::min((size_t) readUint(data + bin_chunk), length - bin_chunk - 8);
+        }
+
+        Json root;
+        JsonParser parser((const char *) data + 20, json_size);
+        if (!parser.parse(root) || root.type != Json::OBJECT) {
+            error = "the JSON chunk is not valid";
+            return false;
+        }
+
+        // Only the binary chunk can back the buffers.
+        const Json *buffers = root.get("buffers");
+        if (buffers && buffers->type == Json::ARRAY)
+            for (size_t i = 0; i < buffers->array.size(); i++)
+                if (i > 0 || buffers->array[i].get("uri")) {
+                    error = "external buffers are not supported";
+                    return false;
+                }
+
+        const Json *views = root.get("bufferViews");
+        if (views && views->type == Json::ARRAY) {
+            for (size_t i = 0; i < views->array.size(); i++) {
+                const Json &v = views->array[i];
+                BufferView view;
+                view.offset = (size_t) v.getNumber("byteOffset", 0.0);
+                view.length = (size_t) v.getNumber("byteLength", 0.0);
+                view.stride = (GLsizei) v.getNumber("byteStride", 0.0);
+                if (view.offset + view.length > file.binary_size) {
+                    error = "a buffer view is out of the binary chunk";
+                    return false;
+                }
+                file.views.push_back(view);
+            }
+        }
+
+        const Json *accessors = root.get("accessors");
+        if (accessors && accessors->type == Json::ARRAY) {
+            for (size_t i = 0; i < accessors->array.size(); i++) {
+                const Json &a = accessors->array[i];
+                Accessor accessor;
+                accessor.view = a.getIndex("bufferView");
+                accessor.offset = (size_t) a.getNumber("byteOffset", 0.0);
+                accessor.component_type = (GLenum) a.getNumber("componentType", GL_FLOAT);
+                accessor.components = getComponents(a.getString("type"));
+                accessor.count = (size_t) a.getNumber("count", 0.0);
+                const Json *normalized = a.get("normalized");
+                accessor.normalized = normalized && normalized->boolean;
+                accessor.sparse = a.get("sparse") != 0;
+
+                std::vector<float> min = a.getFloats("min");
+                std::vector<float> max = a.getFloats("max");
+                if (min.size() >= 3 && max.size() >= 3) {
+                    accessor.has_bounds = true;
+                    accessor.min = glm::vec3(min[0], min[1], min[2]);
+                    accessor.max = glm::vec3(max[0], max[1], max[2]);
+                }
+
+                size_t element = accessor.components * GltfFile::getComponentSize(accessor.component_type);
+                if (element == 0 || accessor.view >= (int) file.views.size()) {
+                    error = "an accessor is not valid";
+                    return false;
+                }
+
+                // Every element has to be inside its view.
+                if (accessor.view >= 0 && accessor.count > 0) {
+                    const BufferView &view = file.views[accessor.view];
+                    size_t stride = view.stride > 0 ? (size_t) view.stride : element;
+                    if (accessor.offset + stride * (accessor.count - 1) + element > view.length) {
+                        error = "an accessor is out of its buffer view";
+                        return false;
+                    }
+                }
+
+                file.accessors.push_back(accessor);
+            }
+        }
+
+        const Json *materials = root.get("materials");
+        if (materials && materials->type == Json::ARRAY) {
+            for (size_t i = 0; i < materials->array.size(); i++) {
+                const Json &m = materials->array[i];
+                Material material;
+                material.name = m.getString("name");
+                const Json *pbr = m.get("pbrMetallicRoughness");
+                if (pbr) {
+                    std::vector<float> color = pbr->getFloats("baseColorFactor");
+                    if (color.size() == 4)
+                        material.base_color = glm::vec4(color[0], color[1], color[2], color[3]);
+                    material.metallic = (float) pbr->getNumber("metallicFactor", 1.0);
+                    material.roughness = (float) pbr->getNumber("roughnessFactor", 1.0);
+                }
+                file.materials.push_back(material);
+            }
+        }
+
+        const Json *meshes = root.get("meshes");
+        if (meshes && meshes->type == Json::ARRAY) {
+            for (size_t i = 0; i < meshes->array.size(); i++) {
+                const Json &m = meshes->array[i];
+                Mesh mesh;
+                mesh.name = m.getString("name");
+                const Json *primitives = m.get("primitives");
+                if (primitives && primitives->type == Json::ARRAY) {
+                    for (size_t j = 0; j < primitives->array.size(); j++) {
+                        const Json &p = primitives->array[j];
+                        Primitive primitive;
+                        primitive.indices = p.getIndex("indices");
+                        primitive.material = p.getIndex("material");
+                        primitive.mode = (GLenum) p.getNumber("mode", GL_TRIANGLES);
+                        const Json *attributes = p.get("attributes");
+                        if (attributes)
+                            for (size_t k = 0; k < attributes->members.size(); k++)
+                                primitive.attributes[attributes->members[k].first] = (int) attributes->members[k].second.number;
+
+                        // Check every reference.
+                        bool valid = primitive.indices < (int) file.accessors.size() && primitive.material < (int) file.materials.size();
+                        for (std::map<std::string, int>::const_iterator it = primitive.attributes.begin(); it != primitive.attributes.end(); ++it)
+                            valid = valid && it->second >= 0 && it->second < (int) file.accessors.size();
+                        if (!valid) {
+                            error = "a primitive is not valid";
+                            return false;
+                        }
+
+                        mesh.primitives.push_back(primitive);
+                    }
+                }
+                file.meshes.push_back(mesh);
+            }
+        }
+
+        const Json *nodes = root.get("nodes");
+        if (nodes && nodes->type == Json::ARRAY) {
+            for (size_t i = 0; i < nodes->array.size(); i++) {
+                const Json &n = nodes->array[i];
+                Node node;
+                node.name = n.getString("name");
+                node.mesh = n.getIndex("mesh");
+                node.skin = n.getIndex("skin");
+                std::vector<float> children = n.getFloats("children");
+                for (size_t j = 0; j < children.size(); j++)
+                    node.children.push_back((int) children[j]);
+
+                // Either a whole matrix or a translation, rotation and scale.
+                std::vector<float> matrix = n.getFloats("matrix");
+                if (matrix.size() == 16) {
+                    for (int c = 0; c < 4; c++)
+                        for (int r = 0; r < 4; r++)
+                            node.matrix[c][r] = matrix[c * 4 + r];
+                } else {
+                    std::vector<float> t = n.getFloats("translation");
+                    std::vector<float> r = n.getFloats("rotation");
+                    std::vector<float> s = n.getFloats("scale");
+                    if (t.size() == 3)
+                        node.matrix = glm::translate(node.matrix, glm::vec3(t[0], t[1], t[2]));
+                    if (r.size() == 4)
+                        node.matrix = node.matrix * glm::mat4_cast(glm::quat(r[3], r[0], r[1], r[2]));
+                    if (s.size() == 3)
+                        node.matrix = glm::scale(node.matrix, glm::vec3(s[0], s[1], s[2]));
+                }
+
+                if (node.mesh >= (int) file.meshes.size()) {
+                    error = "a node is not valid";
+                    return false;
+                }
+
+                file.nodes.push_back(node);
+            }
+        }
+
+        // Link the parents, making sure the nodes form a forest.
+        for (size_t i = 0; i < file.nodes.size(); i++) {
+            for (size_t j = 0; j < file.nodes[i].children.size(); j++) {
+                int child = file.nodes[i].children[j];
+                if (child < 0 || child >= (int) file.nodes.size() || child == (int) i || file.nodes[child].parent != -1) {
+                    error = "the node hierarchy is not valid";
+                    return false;
+                }
+                file.nodes[child].parent = (int) i;
+            }
+        }
+
+        for (size_t i = 0; i < file.nodes.size(); i++) {
+            int steps = 0;
+            for (int n = (int) i; n != -1; n = file.nodes[n].parent)
+                if (++steps > (int) file.nodes.size()) {
+                    error = "the node hierarchy has a cycle";
+                    return false;
+                }
+        }
+
+        const Json *skins = root.get("skins");
+        if (skins && skins->type == Json::ARRAY) {
+            for (size_t i = 0; i < skins->array.size(); i++) {
+                const Json &s = skins->array[i];
+                Skin skin;
+                std::vector<float> joints = s.getFloats("joints");
+                for (size_t j = 0; j < joints.size(); j++)
+                    skin.joints.push_back((int) joints[j]);
+                skin.inverse_bind_matrices = s.getIndex("inverseBindMatrices");
+                skin.skeleton = s.getIndex("skeleton");
+
+                bool valid = skin.inverse_bind_matrices < (int) file.accessors.size() && skin.skeleton < (int) file.nodes.size();
+                for (size_t j = 0; j < skin.joints.size(); j++)
+                    valid = valid && skin.joints[j] >= 0 && skin.joints[j] < (int) file.nodes.size();
+                if (!valid) {
+                    error = "a skin is not valid";
+                    return false;
+                }
+
+                file.skins.push_back(skin);
+            }
+        }
+
+        for (size_t i = 0; i < file.nodes.size(); i++) {
+            if (file.nodes[i].skin >= (int) file.skins.size()) {
+                error = "a node is not valid";
+                return false;
+            }
+        }
+
+        // The roots of the default scene, or every parentless node.
+        const Json *scenes = root.get("scenes");
+        int scene = root.getIndex("scene");
+        if (scenes && scenes->type == Json::ARRAY && !scenes->array.empty()) {
+            std::vector<float> roots = scenes->array[scene >= 0 && scene < (int) scenes->array.size() ? scene : 0].getFloats("nodes");
+            for (size_t i = 0; i < roots.size(); i++)
+                if ((int) roots[i] >= 0 && (int) roots[i] < (int) file.nodes.size())
+                    file.roots.push_back((int) roots[i]);
+        } else {
+            for (size_t i = 0; i < file.nodes.size(); i++)
+                if (file.nodes[i].parent == -1)
+                    file.roots.push_back((int) i);
+        }
+
+        return true;
+
+    }
+
+    size_t GltfFile::getComponentSize(GLenum type) {
+
+        switch (type) {
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:
+                return 1;
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT:
+                return 2;
+            case GL_UNSIGNED_INT:
+            case GL_FLOAT:
+                return 4;
+            default:
+                return 0;
+        }
+
+    }
+
+    size_t GltfFile::getOffset(int accessor) const {
+
+        const Accessor &a = this->accessors[accessor];
+
+        return a.view < 0 ? 0 : this->views[a.view].offset + a.offset;
+
+    }
+
+    GLsizei GltfFile::getStride(int accessor) const {
+
+        const Accessor &a = this->accessors[accessor];
+        if (a.view >= 0 && this->views[a.view].stride > 0)
+            return this->views[a.view].stride;
+
+        return (GLsizei) (a.components * GltfFile::getComponentSize(a.component_type));
+
+    }
+
+    bool GltfFile::readFloats(int accessor, int components, std::vector<float> &values) const {
+
+        const Accessor &a = this->accessors[accessor];
+        values.assign(a.count * components, 0.0f);
+
+        // Sparse accessors would need their replacements applied.
+        if (a.sparse)
+            return false;
+
+        // Accessors without a view are all zeros.
+        if (a.view < 0)
+            return true;
+
+        const unsigned char *base = this->binary + this->getOffset(accessor);
+        size_t stride = (size_t) this->getStride(accessor);
+        int copied = std::min(components, a.components);
+
+        for (size_t i = 0; i < a.count; i++) {
+            const unsigned char *element = base + i * stride;
+            for (int c = 0; c < copied; c++) {
+                float value = 0.0f;
+                switch (a.component_type) {
+                    case GL_FLOAT: { float v; memcpy(&v, element + c * 4, 4); value = v; break; }
+                    case GL_BYTE: { int8_t v; memcpy(&v, element + c, 1); value = a.normalized ? std::max(v / 127.0f, -1.0f) : v; break; }
+                    case GL_UNSIGNED_BYTE: { uint8_t v = element[c]; value = a.normalized ? v / 255.0f : v; break; }
+                    case GL_SHORT: { int16_t v; memcpy(&v, element + c * 2, 2); value = a.normalized ? std::max(v / 32767.0f, -1.0f) : v; break; }
+                    case GL_UNSIGNED_SHORT: { uint16_t v; memcpy(&v, element + c * 2, 2); value = a.normalized ? v / 65535.0f : v; break; }
+                    case GL_UNSIGNED_INT: { uint32_t v; memcpy(&v, element + c * 4, 4); value = (float) v; break; }
+                }
+                values[i * components + c] = value;
+            }
+        }
+
+        return true;
+
+    }
+
+    bool GltfFile::readIndices(int accessor, std::vector<GLuint> &indices) const {
+
+        const Accessor &a = this->accessors[accessor];
+        if (a.sparse || a.view < 0 || a.components != 1)
+            return false;
+
+        const unsigned char *base = this->binary + this->getOffset(accessor);
+        size_t stride = (size_t) this->getStride(accessor);
+        indices.resize(a.count);
+
+        for (size_t i = 0; i < a.count; i++) {
+            const unsigned char *element = base + i * stride;
+            switch (a.component_type) {
+                case GL_UNSIGNED_BYTE: indices[i] = element[0]; break;
+                case GL_UNSIGNED_SHORT: { uint16_t v; memcpy(&v, element, 2); indices[i] = v; break; }
+                case GL_UNSIGNED_INT: { uint32_t v; memcpy(&v, element, 4); indices[i] = v; break; }
+                default: return false;
+            }
+        }
+
+        return true;
+
+    }
+
+    glm::mat4 GltfFile::getWorldMatrix(int node) const {
+
+        glm::mat4 matrix = this->nodes[node].matrix;
+        for (int n = this->nodes[node].parent; n != -1; n = this->nodes[n].parent)
+            matrix = this->nodes[n].matrix * matrix;
+
+        return matrix;
+
+    }
+
+} // namespace bgq_opengl
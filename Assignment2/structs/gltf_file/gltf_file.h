@@ -0,0 +1,240 @@
+/**
+ * @file gltf_file.h
+ * @brief GltfFile struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_GLTF_FILE_H_
+#define BGQ_OPENGL_STRUCT_GLTF_FILE_H_
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#define GLTF_FILE_MAGIC 0x46546C67          // "glTF", the first bytes of every GLB file.
+#define GLTF_FILE_CHUNK_JSON 0x4E4F534A     // "JSON", the type of the first chunk.
+#define GLTF_FILE_CHUNK_BIN 0x004E4942      // "BIN", the type of the binary chunk.
+
+namespace bgq_opengl {
+
+    /**
+     * @brief A binary glTF file.
+     *
+     * This Struct holds the scene description of a GLB file: its nodes, meshes,
+     * accessors, materials and skins. The binary chunk is not copied, it points
+     * into the bytes the file was read from, which have to outlive it. Only the
+     * parsing lives here, no GL calls are made.
+     */
+    struct GltfFile {
+
+        /**
+         * @brief A view into the binary chunk.
+         */
+        struct BufferView {
+
+            size_t offset = 0;      /// Where it starts in the binary chunk.
+            size_t length = 0;      /// Its size in bytes.
+            GLsizei stride = 0;     /// Bytes between two elements, or 0 if they are packed.
+
+        };
+
+        /**
+         * @brief A typed array inside a buffer view.
+         */
+        struct Accessor {
+
+            int view = -1;                      /// Its buffer view, or -1 if it is all zeros.
+            size_t offset = 0;                  /// Where it starts in the view.
+            GLenum component_type = GL_FLOAT;   /// The type of each component.
+            int components = 1;                 /// 1 for SCALAR up to 16 for MAT4.
+            size_t count = 0;                   /// Number of elements.
+            bool normalized = false;            /// Whether integers are mapped to [0, 1] or [-1, 1].
+            bool sparse = false;                /// Whether some elements are replaced elsewhere.
+            bool has_bounds = false;            /// Whether min and max were given.
+            glm::vec3 min = glm::vec3(0.0f);    /// Minimum of the first three components.
+            glm::vec3 max = glm::vec3(0.0f);    /// Maximum of the first three components.
+
+        };
+
+        /**
+         * @brief A part of a mesh drawn with a single material.
+         */
+        struct Primitive {
+
+            std::map<std::string, int> attributes;  /// The accessor of each attribute, by name.
+            int indices = -1;                       /// The accessor of the indices, or -1.
+            int material = -1;                      /// The material, or -1 for the default one.
+            GLenum mode = GL_TRIANGLES;             /// The kind of primitives.
+
+            /**
+             * @brief Get an attribute.
+             *
+             * @param name The name of the attribute, such as POSITION.
+             *
+             * @returns Its accessor, or -1 if there is none.
+             */
+            int getAttribute(const std::string &name) const;
+
+        };
+
+        /**
+         * @brief A mesh.
+         */
+        struct Mesh {
+
+            std::string name;                       /// Its name.
+            std::vector<Primitive> primitives;      /// Its parts.
+
+        };
+
+        /**
+         * @brief A metallic-roughness material.
+         */
+        struct Material {
+
+            std::string name;                           /// Its name.
+            glm::vec4 base_color = glm::vec4(1.0f);     /// The base color factor.
+            float metallic = 1.0f;                      /// The metallic factor.
+            float roughness = 1.0f;                     /// The roughness factor.
+
+        };
+
+        /**
+         * @brief A node of the scene.
+         */
+        struct Node {
+
+            std::string name;                       /// Its name.
+            int mesh = -1;                          /// Its mesh, or -1.
+            int skin = -1;                          /// Its skin, or -1.
+            int parent = -1;                        /// Its parent, or -1 for the roots.
+            std::vector<int> children;              /// Its children.
+            glm::mat4 matrix = glm::mat4(1.0f);     /// Its transform relative to its parent.
+
+        };
+
+        /**
+         * @brief A skin, the joints that deform a mesh.
+         */
+        struct Skin {
+
+            std::vector<int> joints;                /// The nodes that are joints.
+            int inverse_bind_matrices = -1;         /// The accessor of their inverse bind matrices, or -1.
+            int skeleton = -1;                      /// The common root of the joints, or -1.
+
+        };
+
+        std::vector<BufferView> views;              /// The buffer views.
+        std::vector<Accessor> accessors;            /// The accessors.
+        std::vector<Mesh> meshes;                   /// The meshes.
+        std::vector<Material> materials;            /// The materials.
+        std::vector<Node> nodes;                    /// The nodes.
+        std::vector<Skin> skins;                    /// The skins.
+        std::vector<int> roots;                     /// The root nodes of the scene.
+        const unsigned char *binary = 0;            /// The binary chunk, owned by whoever read the file.
+        size_t binary_size = 0;                     /// Size of the binary chunk.
+
+        /**
+         * @brief Check whether a path is a GLB file.
+         *
+         * Check whether a path has the extension of a binary glTF file.
+         *
+         * @param path The path.
+         *
+         * @returns Whether it is a GLB file.
+         */
+        static bool isGltfFile(const std::string &path);
+
+        /**
+         * @brief Read a GLB file.
+         *
+         * Parse the bytes of a GLB file and check that every reference in it is
+         * valid. The bytes are not copied and have to outlive the struct.
+         *
+         * @param data The bytes of the file.
+         * @param size The size of the file.
+         * @param file Outputs the file.
+         * @param error Outputs why it could not be read.
+         *
+         * @returns Whether it could be read.
+         */
+        static bool read(const unsigned char *data, size_t size, GltfFile &file, std::string &error);
+
+        /**
+         * @brief Get the size of a component type.
+         *
+         * @param type The component type.
+         *
+         * @returns Its size in bytes, or 0 if it is not valid.
+         */
+        static size_t getComponentSize(GLenum type);
+
+        /**
+         * @brief Get where an accessor starts.
+         *
+         * @param accessor The accessor.
+         *
+         * @returns Its offset in the binary chunk.
+         */
+        size_t getOffset(int accessor) const;
+
+        /**
+         * @brief Get the stride of an accessor.
+         *
+         * @param accessor The accessor.
+         *
+         * @returns The bytes between two of its elements.
+         */
+        GLsizei getStride(int accessor) const;
+
+        /**
+         * @brief Read an accessor as floats.
+         *
+         * Read every element of an accessor converted to floats, decoding normalized
+         * integers, as a given number of components each.
+         *
+         * @param accessor The accessor.
+         * @param components The number of components to output per element.
+         * @param values Outputs the values.
+         *
+         * @returns Whether it could be read.
+         */
+        bool readFloats(int accessor, int components, std::vector<float> &values) const;
+
+        /**
+         * @brief Read an accessor as indices.
+         *
+         * @param accessor The accessor.
+         * @param indices Outputs the indices.
+         *
+         * @returns Whether it could be read.
+         */
+        bool readIndices(int accessor, std::vector<GLuint> &indices) const;
+
+        /**
+         * @brief Get the world transform of a node.
+         *
+         * @param node The node.
+         *
+         * @returns Its transform relative to the scene.
+         */
+        glm::mat4 getWorldMatrix(int node) const;
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_GLTF_FILE_H_
@@ -20,11 +20,17 @@
 
 #include "classes/camera/camera.h"
 
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <string>
+#include <system_error>
 
 namespace bgq_opengl {
 
-    glm::vec3 Helpful::unProjectScreenToWorld(glm::vec3 screen, Camera camera) {
+    glm::vec3 Helpful::unProjectScreenToWorld(glm::vec3 screen, Camera &camera) {
     
         // Build the viewport from the camera.
         glm::vec4 viewport(0.0f, 0.0f, camera.getWidth(), camera.getHeight());
@@ -36,8 +42,7 @@ namespace bgq_opengl {
         camera_xyz.z = screen.z;
         
         // Now, let's transform the camera coordinates to worls coordinates.
-        glm::mat4 camera_matrix = camera.getProjection() * camera.getView();
-        glm::vec4 world = glm::inverse(camera_matrix) * glm::vec4(camera_xyz, 1.0);
+        glm::vec4 world = camera.getInverseCameraMatrix() * glm::vec4(camera_xyz, 1.0);
 
         // Scale it to obtain the real ones.
         return glm::vec3(world) / world.w;
@@ -73,4 +78,41 @@ namespace bgq_opengl {
         
     }
 
+    unsigned long long Helpful::hashBytes(unsigned long long hash, const void *bytes, size_t size) {
+
+        for (size_t i = 0; i < size; i++) {
+            hash ^= ((const unsigned char *) bytes)[i];
+            hash *= 1099511628211ULL;
+        }
+
+        hash ^= 0xFF;
+        hash *= 1099511628211ULL;
+
+        return hash;
+
+    }
+
+    bool Helpful::writeFileAtomically(const std::string &path, const std::function<void(std::ofstream &)> &write) {
+
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+        std::string temp_path = path + ".tmp";
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+
+            write(out);
+
+            if (!out)
+                return false;
+        }
+
+        std::filesystem::rename(temp_path, path, error);
+
+        return !error;
+
+    }
+
 }  // namespace bgq_opengl
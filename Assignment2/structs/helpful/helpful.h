@@ -16,10 +16,17 @@
 #ifndef BGQ_OPENGL_STRUCTS_HELPFUL_H_
 #define BGQ_OPENGL_STRUCTS_HELPFUL_H_
 
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <string>
+
 #include "glm/glm.hpp"
 
 #include "classes/camera/camera.h"
 
+#define HELPFUL_HASH_SEED 14695981039346656037ULL   // FNV-1a offset basis, the hash of nothing.
+
 namespace bgq_opengl {
 
     /**
@@ -39,7 +46,7 @@ namespace bgq_opengl {
          * @param screen The screen coordinates as x, y and depth components.
          * @param camera The camera recording the scene.
          */
-        static glm::vec3 unProjectScreenToWorld(glm::vec3 screen, Camera camera);
+        static glm::vec3 unProjectScreenToWorld(glm::vec3 screen, Camera &camera);
         
         /**
          * @brief Calculates rotation angles as X, Y and Z rotations.
@@ -66,6 +73,33 @@ namespace bgq_opengl {
          * @returns The angle in degrees.
          */
         static float getAngle(glm::vec2 a, glm::vec2 b, glm::vec2 c);
+
+        /**
+         * @brief Add bytes to a hash.
+         *
+         * Add a field to a 64-bit FNV-1a hash, followed by a separator so that
+         * moving bytes from one field to the next changes the hash.
+         *
+         * @param hash The hash so far, HELPFUL_HASH_SEED to start one.
+         * @param bytes The bytes of the field.
+         * @param size The number of bytes.
+         *
+         * @returns The new hash.
+         */
+        static unsigned long long hashBytes(unsigned long long hash, const void *bytes, size_t size);
+
+        /**
+         * @brief Replace a file as a whole.
+         *
+         * Create the directory of a file, write it next to its path and move it
+         * in place, so readers never see it half written.
+         *
+         * @param path The path of the file.
+         * @param write Writes the contents to the stream.
+         *
+         * @returns False if it could not be written.
+         */
+        static bool writeFileAtomically(const std::string &path, const std::function<void(std::ofstream &)> &write);
         
     };
 
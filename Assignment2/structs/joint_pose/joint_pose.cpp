@@ -0,0 +1,241 @@
+/**
+ * @file joint_pose.cpp
+ * @brief JointPose struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "joint_pose.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define JOINT_POSE_SSE
+#endif
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace bgq_opengl {
+
+    void JointPose::resize(size_t count) {
+
+        this->rx.resize(count, 0.0f);
+        this->ry.resize(count, 0.0f);
+        this->rz.resize(count, 0.0f);
+        this->rw.resize(count, 1.0f);
+        this->tx.resize(count, 0.0f);
+        this->ty.resize(count, 0.0f);
+        this->tz.resize(count, 0.0f);
+
+    }
+
+    size_t JointPose::size() const {
+
+        return this->rw.size();
+
+    }
+
+    void JointPose::setIdentity() {
+
+        for (size_t i = 0; i < this->size(); i++) {
+            this->rx[i] = this->ry[i] = this->rz[i] = 0.0f;
+            this->rw[i] = 1.0f;
+            this->tx[i] = this->ty[i] = this->tz[i] = 0.0f;
+        }
+
+    }
+
+    void JointPose::set(size_t joint, const glm::quat &rotation, const glm::vec3 &translation) {
+
+        this->rx[joint] = rotation.x;
+        this->ry[joint] = rotation.y;
+        this->rz[joint] = rotation.z;
+        this->rw[joint] = rotation.w;
+        this->tx[joint] = translation.x;
+        this->ty[joint] = translation.y;
+        this->tz[joint] = translation.z;
+
+    }
+
+    glm::quat JointPose::getRotation(size_t joint) const {
+
+        return glm::quat(this->rw[joint], this->rx[joint], this->ry[joint], this->rz[joint]);
+
+    }
+
+    glm::vec3 JointPose::getTranslation(size_t joint) const {
+
+        return glm::vec3(this->tx[joint], this->ty[joint], this->tz[joint]);
+
+    }
+
+    void JointPose::blend(const JointPose &a, const JointPose &b, const float *weights, JointPose &result) {
+
+        size_t count = a.size();
+        result.resize(count);
+
+        size_t i = 0;
+
+#ifdef JOINT_POSE_SSE
+
+        // Four joints at a time, one component per register.
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        for (; i + 4 <= count; i += 4) {
+
+            __m128 w = _mm_loadu_ps(weights + i);
+
+            __m128 ax = _mm_loadu_ps(&a.rx[i]), ay = _mm_loadu_ps(&a.ry[i]), az = _mm_loadu_ps(&a.rz[i]), aw = _mm_loadu_ps(&a.rw[i]);
+            __m128 bx = _mm_loadu_ps(&b.rx[i]), by = _mm_loadu_ps(&b.ry[i]), bz = _mm_loadu_ps(&b.rz[i]), bw = _mm_loadu_ps(&b.rw[i]);
+
+            // Flip b when it is on the other hemisphere, so the shortest arc is taken.
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+            __m128 flip = _mm_and_ps(dot, sign);
+            bx = _mm_xor_ps(bx, flip);
+            by = _mm_xor_ps(by, flip);
+            bz = _mm_xor_ps(bz, flip);
+            bw = _mm_xor_ps(bw, flip);
+
+            __m128 x = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), w));
+            __m128 y = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), w));
+            __m128 z = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), w));
+            __m128 q = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), w));
+
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(q, q))));
+            _mm_storeu_ps(&result.rx[i], _mm_div_ps(x, length));
+            _mm_storeu_ps(&result.ry[i], _mm_div_ps(y, length));
+            _mm_storeu_ps(&result.rz[i], _mm_div_ps(z, length));
+            _mm_storeu_ps(&result.rw[i], _mm_div_ps(q, length));
+
+            __m128 atx = _mm_loadu_ps(&a.tx[i]), aty = _mm_loadu_ps(&a.ty[i]), atz = _mm_loadu_ps(&a.tz[i]);
+            _mm_storeu_ps(&result.tx[i], _mm_add_ps(atx, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.tx[i]), atx), w)));
+            _mm_storeu_ps(&result.ty[i], _mm_add_ps(aty, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.ty[i]), aty), w)));
+            _mm_storeu_ps(&result.tz[i], _mm_add_ps(atz, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.tz[i]), atz), w)));
+
+        }
+
+#endif
+
+        // The rest one by one.
+        for (; i < count; i++) {
+
+            float w = weights[i];
+            float s = a.rx[i] * b.rx[i] + a.ry[i] * b.ry[i] + a.rz[i] * b.rz[i] + a.rw[i] * b.rw[i] < 0.0f ? -1.0f : 1.0f;
+
+            float x = a.rx[i] + (s * b.rx[i] - a.rx[i]) * w;
+            float y = a.ry[i] + (s * b.ry[i] - a.ry[i]) * w;
+            float z = a.rz[i] + (s * b.rz[i] - a.rz[i]) * w;
+            float q = a.rw[i] + (s * b.rw[i] - a.rw[i]) * w;
+            float length = std::sqrt(x * x + y * y + z * z + q * q);
+
+            result.rx[i] = x / length;
+            result.ry[i] = y / length;
+            result.rz[i] = z / length;
+            result.rw[i] = q / length;
+
+            result.tx[i] = a.tx[i] + (b.tx[i] - a.tx[i]) * w;
+            result.ty[i] = a.ty[i] + (b.ty[i] - a.ty[i]) * w;
+            result.tz[i] = a.tz[i] + (b.tz[i] - a.tz[i]) * w;
+
+        }
+
+    }
+
+    void JointPose::add(const JointPose &base, const JointPose &additive, const float *weights, JointPose &result) {
+
+        size_t count = base.size();
+        result.resize(count);
+
+        size_t i = 0;
+
+#ifdef JOINT_POSE_SSE
+
+        // Four joints at a time, one component per register.
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (; i + 4 <= count; i += 4) {
+
+            __m128 w = _mm_loadu_ps(weights + i);
+
+            // Scale the additive rotation from the identity, on its hemisphere.
+            __m128 dw = _mm_loadu_ps(&additive.rw[i]);
+            __m128 flip = _mm_and_ps(dw, sign);
+            __m128 dx = _mm_mul_ps(_mm_xor_ps(_mm_loadu_ps(&additive.rx[i]), flip), w);
+            __m128 dy = _mm_mul_ps(_mm_xor_ps(_mm_loadu_ps(&additive.ry[i]), flip), w);
+            __m128 dz = _mm_mul_ps(_mm_xor_ps(_mm_loadu_ps(&additive.rz[i]), flip), w);
+            dw = _mm_add_ps(one, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(dw, flip), one), w));
+
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_add_ps(_mm_mul_ps(dz, dz), _mm_mul_ps(dw, dw))));
+            dx = _mm_div_ps(dx, length);
+            dy = _mm_div_ps(dy, length);
+            dz = _mm_div_ps(dz, length);
+            dw = _mm_div_ps(dw, length);
+
+            // Then apply it after the base rotation.
+            __m128 bx = _mm_loadu_ps(&base.rx[i]), by = _mm_loadu_ps(&base.ry[i]), bz = _mm_loadu_ps(&base.rz[i]), bw = _mm_loadu_ps(&base.rw[i]);
+            __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dw, bx), _mm_mul_ps(dx, bw)), _mm_sub_ps(_mm_mul_ps(dy, bz), _mm_mul_ps(dz, by)));
+            __m128 y = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(dw, by), _mm_mul_ps(dx, bz)), _mm_add_ps(_mm_mul_ps(dy, bw), _mm_mul_ps(dz, bx)));
+            __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dw, bz), _mm_mul_ps(dx, by)), _mm_sub_ps(_mm_mul_ps(dz, bw), _mm_mul_ps(dy, bx)));
+            __m128 q = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(dw, bw), _mm_mul_ps(dx, bx)), _mm_add_ps(_mm_mul_ps(dy, by), _mm_mul_ps(dz, bz)));
+
+            _mm_storeu_ps(&result.rx[i], x);
+            _mm_storeu_ps(&result.ry[i], y);
+            _mm_storeu_ps(&result.rz[i], z);
+            _mm_storeu_ps(&result.rw[i], q);
+
+            _mm_storeu_ps(&result.tx[i], _mm_add_ps(_mm_loadu_ps(&base.tx[i]), _mm_mul_ps(_mm_loadu_ps(&additive.tx[i]), w)));
+            _mm_storeu_ps(&result.ty[i], _mm_add_ps(_mm_loadu_ps(&base.ty[i]), _mm_mul_ps(_mm_loadu_ps(&additive.ty[i]), w)));
+            _mm_storeu_ps(&result.tz[i], _mm_add_ps(_mm_loadu_ps(&base.tz[i]), _mm_mul_ps(_mm_loadu_ps(&additive.tz[i]), w)));
+
+        }
+
+#endif
+
+        // The rest one by one.
+        for (; i < count; i++) {
+
+            float w = weights[i];
+            float s = additive.rw[i] < 0.0f ? -1.0f : 1.0f;
+
+            float dx = s * additive.rx[i] * w;
+            float dy = s * additive.ry[i] * w;
+            float dz = s * additive.rz[i] * w;
+            float dw = 1.0f + (s * additive.rw[i] - 1.0f) * w;
+            float length = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+
+            glm::quat rotation = glm::quat(dw / length, dx / length, dy / length, dz / length) * base.getRotation(i);
+
+            result.rx[i] = rotation.x;
+            result.ry[i] = rotation.y;
+            result.rz[i] = rotation.z;
+            result.rw[i] = rotation.w;
+
+            result.tx[i] = base.tx[i] + additive.tx[i] * w;
+            result.ty[i] = base.ty[i] + additive.ty[i] * w;
+            result.tz[i] = base.tz[i] + additive.tz[i] * w;
+
+        }
+
+    }
+
+    void JointPose::difference(const JointPose &reference, const JointPose &pose, JointPose &result) {
+
+        result.resize(pose.size());
+
+        for (size_t i = 0; i < pose.size(); i++)
+            result.set(i, pose.getRotation(i) * glm::conjugate(reference.getRotation(i)), pose.getTranslation(i) - reference.getTranslation(i));
+
+    }
+
+} // namespace bgq_opengl
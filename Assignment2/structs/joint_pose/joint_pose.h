@@ -0,0 +1,137 @@
+/**
+ * @file joint_pose.h
+ * @brief JointPose struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_JOINT_POSE_H_
+#define BGQ_OPENGL_STRUCT_JOINT_POSE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace bgq_opengl {
+
+    /**
+     * @brief A joint pose struct.
+     *
+     * This Struct holds the local transform of every joint of a rig, indexed like
+     * the matrix slots of its nodes: a rotation about the rest anchor of the joint
+     * followed by a translation, both relative to its parent. Each component is
+     * kept in its own array so that whole poses are blended and layered four
+     * joints at a time, without allocating once they are sized.
+     */
+    struct JointPose {
+
+        std::vector<float> rx, ry, rz, rw;  /// The rotation quaternion of each joint.
+        std::vector<float> tx, ty, tz;      /// The translation of each joint.
+
+        /**
+         * @brief Resize the pose.
+         *
+         * Resize the pose, giving the new joints the identity transform. Memory is
+         * only allocated when it grows past what it ever held.
+         *
+         * @param count The number of joints.
+         */
+        void resize(size_t count);
+
+        /**
+         * @brief Get the number of joints.
+         *
+         * @returns The number of joints.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Set every joint to the identity.
+         *
+         * Set every joint to the identity, the rest pose of the rig.
+         */
+        void setIdentity();
+
+        /**
+         * @brief Set the transform of a joint.
+         *
+         * @param joint The joint.
+         * @param rotation Its rotation.
+         * @param translation Its translation.
+         */
+        void set(size_t joint, const glm::quat &rotation, const glm::vec3 &translation);
+
+        /**
+         * @brief Get the rotation of a joint.
+         *
+         * @param joint The joint.
+         *
+         * @returns Its rotation.
+         */
+        glm::quat getRotation(size_t joint) const;
+
+        /**
+         * @brief Get the translation of a joint.
+         *
+         * @param joint The joint.
+         *
+         * @returns Its translation.
+         */
+        glm::vec3 getTranslation(size_t joint) const;
+
+        /**
+         * @brief Blend two poses joint by joint.
+         *
+         * Interpolate every joint of two poses of the same size with its own
+         * weight: rotations are normalized lerps along the shortest arc, which is
+         * close to a slerp for nearby keys, and translations are lerped.
+         *
+         * @param a The pose at weight 0.
+         * @param b The pose at weight 1.
+         * @param weights The weight of each joint.
+         * @param result Where the blended pose is stored, which can be a or b.
+         */
+        static void blend(const JointPose &a, const JointPose &b, const float *weights, JointPose &result);
+
+        /**
+         * @brief Layer a pose on top of another.
+         *
+         * Add a fraction of an additive pose to every joint of a base pose: the
+         * additive rotation, scaled from the identity by the weight of the joint,
+         * is applied after the base one and the weighted additive translation is
+         * added to the base one.
+         *
+         * @param base The base pose.
+         * @param additive The additive pose, as made by difference.
+         * @param weights The weight of each joint.
+         * @param result Where the layered pose is stored, which can be base.
+         */
+        static void add(const JointPose &base, const JointPose &additive, const float *weights, JointPose &result);
+
+        /**
+         * @brief Get the difference between two poses.
+         *
+         * Get the additive pose that turns a reference pose into another one when
+         * added to it with weight 1.
+         *
+         * @param reference The reference pose.
+         * @param pose The pose.
+         * @param result Where the additive pose is stored.
+         */
+        static void difference(const JointPose &reference, const JointPose &pose, JointPose &result);
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_JOINT_POSE_H_
@@ -0,0 +1,112 @@
+/**
+ * @file normal_matrix.cpp
+ * @brief NormalMatrix struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "normal_matrix.h"
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define NORMAL_MATRIX_SSE
+#endif
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+    NormalMatrix::Kind NormalMatrix::classify(const glm::mat4 &model) {
+
+        glm::vec3 x(model[0]);
+        glm::vec3 y(model[1]);
+        glm::vec3 z(model[2]);
+
+        // The squared lengths of the axes, which are the squared scales.
+        float xx = glm::dot(x, x);
+        float yy = glm::dot(y, y);
+        float zz = glm::dot(z, z);
+        float tolerance = NORMAL_MATRIX_EPSILON * std::fmax(xx, std::fmax(yy, zz));
+
+        // Skewed axes or different scales need the general inverse.
+        if (std::fabs(glm::dot(x, y)) > tolerance || std::fabs(glm::dot(y, z)) > tolerance || std::fabs(glm::dot(z, x)) > tolerance)
+            return GENERAL;
+
+        if (std::fabs(xx - yy) > tolerance || std::fabs(yy - zz) > tolerance)
+            return GENERAL;
+
+        // Same scale everywhere, check whether it is one.
+        return std::fabs(xx - 1.0f) <= NORMAL_MATRIX_EPSILON ? RIGID : UNIFORM;
+
+    }
+
+    NormalMatrix::Kind NormalMatrix::combine(Kind a, Kind b) {
+
+        // The kinds are ordered from the most restrictive to the least.
+        return a > b ? a : b;
+
+    }
+
+    glm::mat3 NormalMatrix::compute(const glm::mat4 &model, Kind kind) {
+
+        glm::mat3 linear(model);
+
+        // The rotation is its own inverse transpose.
+        if (kind == RIGID)
+            return linear;
+
+        // The inverse transpose of s * R is R / s, that is s * R / s^2.
+        if (kind == UNIFORM)
+            return linear / glm::dot(linear[0], linear[0]);
+
+        return glm::transpose(glm::inverse(linear));
+
+    }
+
+    void NormalMatrix::computeBatch(const glm::mat4 *models, const Kind *kinds, size_t count, glm::mat3 *normals) {
+
+        for (size_t i = 0; i < count; i++) {
+
+            if (kinds[i] == GENERAL) {
+                normals[i] = glm::transpose(glm::inverse(glm::mat3(models[i])));
+                continue;
+            }
+
+            const float *m = &models[i][0][0];
+            float inv_scale = kinds[i] == RIGID ? 1.0f : 1.0f / (m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+
+#ifdef NORMAL_MATRIX_SSE
+
+            // Scale the three columns at once.
+            __m128 factor = _mm_set1_ps(inv_scale);
+            float scaled[12];
+            _mm_storeu_ps(scaled, _mm_mul_ps(_mm_loadu_ps(m), factor));
+            _mm_storeu_ps(scaled + 4, _mm_mul_ps(_mm_loadu_ps(m + 4), factor));
+            _mm_storeu_ps(scaled + 8, _mm_mul_ps(_mm_loadu_ps(m + 8), factor));
+
+            // Drop the fourth row of each column.
+            for (int c = 0; c < 3; c++)
+                normals[i][c] = glm::vec3(scaled[4 * c], scaled[4 * c + 1], scaled[4 * c + 2]);
+
+#else
+
+            normals[i] = glm::mat3(models[i]) * inv_scale;
+
+#endif
+
+        }
+
+    }
+
+}  // namespace bgq_opengl
@@ -0,0 +1,98 @@
+/**
+ * @file normal_matrix.h
+ * @brief NormalMatrix struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_NORMAL_MATRIX_H_
+#define BGQ_OPENGL_STRUCT_NORMAL_MATRIX_H_
+
+#include <cstddef>
+
+#include "glm/glm.hpp"
+
+#define NORMAL_MATRIX_EPSILON 1e-4f     // Relative tolerance when classifying a transform.
+
+namespace bgq_opengl {
+
+    /**
+     * @brief Normal matrix helpers.
+     *
+     * Computes the matrix that transforms normals, the inverse transpose of the
+     * linear part of a transform, taking the cheapest path its kind allows. Rigid
+     * transforms use their rotation as it is, uniformly scaled ones divide it by the
+     * squared scale, and only general ones need an actual inverse.
+     */
+    struct NormalMatrix {
+
+        /**
+         * @brief The kinds of transform.
+         *
+         * RIGID rotates and translates, UNIFORM also scales by the same amount in all
+         * the axes and GENERAL is anything else.
+         */
+        enum Kind { RIGID, UNIFORM, GENERAL };
+
+        /**
+         * @brief Classify a transform.
+         *
+         * Classify a transform by checking whether the columns of its linear part are
+         * orthogonal and of the same length.
+         *
+         * @param model The transform.
+         *
+         * @returns The kind of the transform.
+         */
+        static Kind classify(const glm::mat4 &model);
+
+        /**
+         * @brief Get the kind of a product.
+         *
+         * Get the kind of the product of two transforms from their kinds.
+         *
+         * @param a The kind of the first transform.
+         * @param b The kind of the second transform.
+         *
+         * @returns The kind of the product.
+         */
+        static Kind combine(Kind a, Kind b);
+
+        /**
+         * @brief Compute a normal matrix.
+         *
+         * Compute the normal matrix of a transform on the path that matches its kind.
+         *
+         * @param model The transform.
+         * @param kind The kind of the transform.
+         *
+         * @returns The normal matrix.
+         */
+        static glm::mat3 compute(const glm::mat4 &model, Kind kind);
+
+        /**
+         * @brief Compute many normal matrices.
+         *
+         * Compute the normal matrices of a batch of transforms. Rigid and uniform ones
+         * are scaled four floats at a time with SSE when it is available.
+         *
+         * @param models The transforms.
+         * @param kinds The kinds of the transforms.
+         * @param count The number of transforms.
+         * @param normals Where to store the normal matrices.
+         */
+        static void computeBatch(const glm::mat4 *models, const Kind *kinds, size_t count, glm::mat3 *normals);
+
+    };
+
+}  // namespace bgq_opengl
+
+#endif  //! BGQ_OPENGL_STRUCT_NORMAL_MATRIX_H_
@@ -0,0 +1,95 @@
+/**
+ * @file pose.cpp
+ * @brief Pose struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "pose.h"
+
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "structs/normal_matrix/normal_matrix.h"
+
+namespace bgq_opengl {
+
+    namespace {
+
+        // Blend two rotations with a scale and a translation.
+        glm::mat4 blendRigid(const glm::mat4 &a, const glm::mat4 &b, float t) {
+
+            float scale_a = glm::length(glm::vec3(a[0]));
+            float scale_b = glm::length(glm::vec3(b[0]));
+
+            glm::quat rotation = glm::slerp(glm::quat_cast(glm::mat3(a) / scale_a), glm::quat_cast(glm::mat3(b) / scale_b), t);
+            glm::mat3 linear = glm::mat3_cast(rotation) * glm::mix(scale_a, scale_b, t);
+
+            glm::mat4 result(linear);
+            result[3] = glm::vec4(glm::mix(glm::vec3(a[3]), glm::vec3(b[3]), t), 1.0f);
+
+            return result;
+
+        }
+
+    }
+
+    void Pose::interpolate(const Pose &a, const Pose &b, float t, Pose &result) {
+
+        // Nothing to blend with, or one of the ends.
+        if (a.matrices.size() != b.matrices.size() || t >= 1.0f) {
+            result = b;
+            return;
+        }
+
+        if (t <= 0.0f) {
+            result = a;
+            return;
+        }
+
+        result.matrices.resize(b.matrices.size());
+        result.kinds.resize(b.kinds.size());
+        result.versions.resize(b.versions.size());
+
+        for (size_t i = 0; i < b.matrices.size(); i++) {
+
+            // It did not move between the two.
+            if (a.versions[i] == b.versions[i]) {
+                result.matrices[i] = b.matrices[i];
+                result.kinds[i] = b.kinds[i];
+                result.versions[i] = b.versions[i];
+                continue;
+            }
+
+            NormalMatrix::Kind kind = NormalMatrix::combine(a.kinds[i], b.kinds[i]);
+
+            // Mirrored transforms have no rotation quaternion either.
+            bool mirrored = glm::determinant(glm::mat3(a.matrices[i])) < 0.0f || glm::determinant(glm::mat3(b.matrices[i])) < 0.0f;
+
+            // A lerped matrix is not orthonormal any more, whatever the ends were.
+            if (kind == NormalMatrix::GENERAL || mirrored) {
+                result.matrices[i] = a.matrices[i] * (1.0f - t) + b.matrices[i] * t;
+                kind = NormalMatrix::GENERAL;
+            } else {
+                result.matrices[i] = blendRigid(a.matrices[i], b.matrices[i], t);
+            }
+
+            result.kinds[i] = kind;
+            result.versions[i] = 0;
+
+        }
+
+    }
+
+} // namespace bgq_opengl
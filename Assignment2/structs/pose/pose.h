@@ -0,0 +1,58 @@
+/**
+ * @file pose.h
+ * @brief Pose struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_POSE_H_
+#define BGQ_OPENGL_STRUCT_POSE_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "structs/normal_matrix/normal_matrix.h"
+
+namespace bgq_opengl {
+
+    /**
+     * @brief A pose struct.
+     *
+     * This Struct holds a copy of the transforms of every node of a rig, indexed by
+     * their matrix slots, so it can be drawn while the rig itself keeps moving.
+     */
+    struct Pose {
+
+        std::vector<glm::mat4> matrices;            /// The world transform of each node.
+        std::vector<NormalMatrix::Kind> kinds;      /// The kind of each transform.
+        std::vector<unsigned long> versions;        /// The version of each transform, 0 if it is not a stored one.
+
+        /**
+         * @brief Interpolate between two poses.
+         *
+         * Blend every transform of two poses of the same rig. Rigid and uniformly
+         * scaled transforms slerp their rotation and lerp their scale and
+         * translation, general ones are blended component-wise. Transforms that did
+         * not change keep their version, the blended ones get version 0.
+         *
+         * @param a The pose at t = 0.
+         * @param b The pose at t = 1.
+         * @param t The blend factor.
+         * @param result Where the blended pose is stored.
+         */
+        static void interpolate(const Pose &a, const Pose &b, float t, Pose &result);
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_POSE_H_
@@ -0,0 +1,65 @@
+/**
+ * @file simulation.h
+ * @brief Simulation structs header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_SIMULATION_H_
+#define BGQ_OPENGL_STRUCT_SIMULATION_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "structs/control_point/control_point.h"
+#include "structs/pose/pose.h"
+
+namespace bgq_opengl {
+
+    /**
+     * @brief The input of a simulation step.
+     *
+     * This Struct holds everything the render thread tells the simulation thread:
+     * the settings chosen in the GUI and the joint being dragged with the mouse.
+     */
+    struct SimulationInput {
+
+        int scene = 0;                          /// The creature selected.
+        int kinematic = 0;                      /// The kinematic method used.
+        int ik_level = 2;                       /// The number of bones used by IK.
+        int moving_joint = -1;                  /// The control point being dragged, or -1.
+        glm::vec3 target = glm::vec3(0.0f);     /// Where the dragged control point was moved.
+        unsigned long target_version = 0;       /// Changes every time the target does.
+        float amplitude = 0.0f;                 /// The amplitude of the scripted motion.
+        float frequency = 0.0f;                 /// The frequency of the scripted motion.
+
+    };
+
+    /**
+     * @brief The result of a simulation step.
+     *
+     * This Struct holds an immutable snapshot of the posed creature that the render
+     * thread can draw while the simulation goes on.
+     */
+    struct SimulationState {
+
+        int scene = -1;                             /// The creature that was posed, or -1 before the first step.
+        Pose pose;                                  /// The transforms of its nodes.
+        std::vector<ControlPoint> control_points;   /// Its control points.
+        double time = 0.0;                          /// The simulation time the pose belongs to.
+        float solve_time = 0.0f;                    /// Milliseconds taken by the step.
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_SIMULATION_H_
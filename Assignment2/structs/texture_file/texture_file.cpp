@@ -0,0 +1,394 @@
+/**
+ * @file texture_file.cpp
+ * @brief TextureFile struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "texture_file.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+    namespace {
+
+        /**
+         * @brief What is known about a compressed format.
+         */
+        struct Format {
+
+            GLenum internal_format;     /// The GL internal format.
+            size_t block_bytes;         /// Bytes per 4x4 block.
+            int channels;               /// Number of channels.
+
+        };
+
+        const Format FORMATS[] = {
+            {GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 8, 3},
+            {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 8, 4},
+            {GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 16, 4},
+            {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16, 4},
+            {GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, 8, 3},
+            {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 8, 4},
+            {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 16, 4},
+            {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 16, 4},
+            {GL_COMPRESSED_RED_RGTC1, 8, 1},
+            {GL_COMPRESSED_SIGNED_RED_RGTC1, 8, 1},
+            {GL_COMPRESSED_RG_RGTC2, 16, 2},
+            {GL_COMPRESSED_SIGNED_RG_RGTC2, 16, 2},
+            {GL_COMPRESSED_RGBA_BPTC_UNORM, 16, 4},
+            {GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, 16, 4},
+            {GL_COMPRESSED_RGB8_ETC2, 8, 3},
+            {GL_COMPRESSED_SRGB8_ETC2, 8, 3},
+            {GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, 8, 4},
+            {GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2, 8, 4},
+            {GL_COMPRESSED_RGBA8_ETC2_EAC, 16, 4},
+            {GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, 16, 4},
+            {GL_COMPRESSED_R11_EAC, 8, 1},
+            {GL_COMPRESSED_SIGNED_R11_EAC, 8, 1},
+            {GL_COMPRESSED_RG11_EAC, 16, 2},
+            {GL_COMPRESSED_SIGNED_RG11_EAC, 16, 2},
+        };
+
+        const unsigned char KTX_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+        const uint32_t KTX_ENDIANNESS = 0x04030201;
+        const size_t KTX_HEADER_BYTES = 64;
+
+        // Declares that the rows go bottom up, as OpenGL reads them.
+        const char KTX_ORIENTATION[] = "KTXorientation\0S=r,T=u";
+
+        const size_t DDS_HEADER_BYTES = 128;
+        const size_t DDS_DX10_HEADER_BYTES = 20;
+        const uint32_t DDS_CUBEMAP = 0x200;
+        const uint32_t DDS_DX10_CUBEMAP = 0x4;
+
+        const Format *findFormat(GLenum internal_format) {
+
+            for (const Format &format : FORMATS)
+                if (format.internal_format == internal_format)
+                    return &format;
+
+            return 0;
+
+        }
+
+        uint32_t fourCC(const char *code) {
+
+            return (uint32_t) code[0] | ((uint32_t) code[1] << 8) | ((uint32_t) code[2] << 16) | ((uint32_t) code[3] << 24);
+
+        }
+
+        uint32_t readU32(const std::vector<unsigned char> &bytes, size_t offset) {
+
+            uint32_t value;
+            std::memcpy(&value, &bytes[offset], sizeof(value));
+            return value;
+
+        }
+
+        void writeU32(std::ofstream &out, uint32_t value) {
+
+            out.write((const char *) &value, sizeof(value));
+
+        }
+
+        size_t getImageBytes(const Format &format, int width, int height) {
+
+            return (size_t) ((width + 3) / 4) * ((height + 3) / 4) * format.block_bytes;
+
+        }
+
+        // Read the size and mip count of a header, rejecting sizes that do not fit or
+        // more levels than a full chain has.
+        bool readExtent(uint32_t width, uint32_t height, uint32_t levels, TextureFile &file) {
+
+            if (width == 0 || height == 0 || width > INT32_MAX || height > INT32_MAX)
+                return false;
+
+            uint32_t max_levels = 1;
+            for (uint32_t extent = std::max(width, height); extent > 1; extent >>= 1)
+                max_levels++;
+
+            if (levels > max_levels)
+                return false;
+
+            file.width = (int) width;
+            file.height = (int) height;
+            file.levels = (int) std::max(1u, levels);
+
+            return true;
+
+        }
+
+        GLenum getDDSFormat(uint32_t four_cc) {
+
+            if (four_cc == fourCC("DXT1"))
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            if (four_cc == fourCC("DXT3"))
+                return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            if (four_cc == fourCC("DXT5"))
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            if (four_cc == fourCC("ATI1") || four_cc == fourCC("BC4U"))
+                return GL_COMPRESSED_RED_RGTC1;
+            if (four_cc == fourCC("ATI2") || four_cc == fourCC("BC5U"))
+                return GL_COMPRESSED_RG_RGTC2;
+
+            return 0;
+
+        }
+
+        GLenum getDXGIFormat(uint32_t dxgi_format) {
+
+            switch (dxgi_format) {
+                case 71: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                case 72: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+                case 74: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+                case 75: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+                case 77: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                case 78: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+                case 80: return GL_COMPRESSED_RED_RGTC1;
+                case 81: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+                case 83: return GL_COMPRESSED_RG_RGTC2;
+                case 84: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+                case 98: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+                case 99: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+                default: return 0;
+            }
+
+        }
+
+        bool readKTX(const std::vector<unsigned char> &bytes, TextureFile &file) {
+
+            if (bytes.size() < KTX_HEADER_BYTES || readU32(bytes, 12) != KTX_ENDIANNESS)
+                return false;
+
+            // Only compressed 2D textures and cubemaps, no arrays or volumes.
+            if (readU32(bytes, 16) != 0 || readU32(bytes, 44) > 1 || readU32(bytes, 48) != 0)
+                return false;
+
+            file.internal_format = readU32(bytes, 28);
+            file.faces = readU32(bytes, 52);
+
+            const Format *format = findFormat(file.internal_format);
+            if (format == 0 || (file.faces != 1 && file.faces != 6))
+                return false;
+
+            if (!readExtent(readU32(bytes, 36), readU32(bytes, 40), readU32(bytes, 56), file))
+                return false;
+
+            // Walk the levels, each one starts with the size of its images.
+            size_t offset = KTX_HEADER_BYTES + readU32(bytes, 60);
+            file.images.clear();
+
+            for (int level = 0; level < file.levels; level++) {
+
+                if (offset + 4 > bytes.size())
+                    return false;
+
+                size_t size = readU32(bytes, offset);
+                offset += 4;
+
+                // Every image must hold exactly the blocks of its level.
+                int width = std::max(1, file.width >> level);
+                int height = std::max(1, file.height >> level);
+                if (size != getImageBytes(*format, width, height))
+                    return false;
+
+                for (int face = 0; face < file.faces; face++) {
+
+                    if (offset + size > bytes.size())
+                        return false;
+
+                    TextureFile::Image image;
+                    image.offset = offset;
+                    image.size = size;
+                    image.width = width;
+                    image.height = height;
+                    file.images.push_back(image);
+
+                    offset += (size + 3) & ~(size_t) 3;
+
+                }
+
+            }
+
+            return true;
+
+        }
+
+        bool readDDS(const std::vector<unsigned char> &bytes, TextureFile &file) {
+
+            if (bytes.size() < DDS_HEADER_BYTES)
+                return false;
+
+            if (!readExtent(readU32(bytes, 16), readU32(bytes, 12), readU32(bytes, 28), file))
+                return false;
+
+            file.faces = (readU32(bytes, 112) & DDS_CUBEMAP) ? 6 : 1;
+
+            // Newer formats live in an extra header.
+            size_t offset = DDS_HEADER_BYTES;
+            uint32_t four_cc = readU32(bytes, 84);
+            if (four_cc == fourCC("DX10")) {
+
+                if (bytes.size() < DDS_HEADER_BYTES + DDS_DX10_HEADER_BYTES)
+                    return false;
+
+                file.internal_format = getDXGIFormat(readU32(bytes, 128));
+                file.faces = (readU32(bytes, 136) & DDS_DX10_CUBEMAP) ? 6 : 1;
+                offset += DDS_DX10_HEADER_BYTES;
+
+            } else {
+
+                file.internal_format = getDDSFormat(four_cc);
+
+            }
+
+            const Format *format = findFormat(file.internal_format);
+            if (format == 0)
+                return false;
+
+            // DDS stores each face with all its levels, so reorder them level by level.
+            file.images.assign(file.levels * file.faces, TextureFile::Image());
+
+            for (int face = 0; face < file.faces; face++) {
+
+                for (int level = 0; level < file.levels; level++) {
+
+                    TextureFile::Image &image = file.images[level * file.faces + face];
+                    image.width = std::max(1, file.width >> level);
+                    image.height = std::max(1, file.height >> level);
+                    image.size = getImageBytes(*format, image.width, image.height);
+                    image.offset = offset;
+
+                    if (offset + image.size > bytes.size())
+                        return false;
+
+                    offset += image.size;
+
+                }
+
+            }
+
+            return true;
+
+        }
+
+    }
+
+    const TextureFile::Image &TextureFile::getImage(int level, int face) const {
+
+        return this->images[level * this->faces + face];
+
+    }
+
+    bool TextureFile::isTextureFile(const std::string &path) {
+
+        std::string extension = path.substr(path.find_last_of('.') + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+        return extension == "ktx" || extension == "dds";
+
+    }
+
+    bool TextureFile::read(const std::string &path, TextureFile &file) {
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+
+        file.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        // Tell the formats apart by their magic numbers.
+        bool read = false;
+        if (file.data.size() >= sizeof(KTX_IDENTIFIER) && std::memcmp(file.data.data(), KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) == 0)
+            read = readKTX(file.data, file);
+        else if (file.data.size() >= 4 && readU32(file.data, 0) == fourCC("DDS "))
+            read = readDDS(file.data, file);
+
+        if (!read || file.width <= 0 || file.height <= 0)
+            return false;
+
+        file.channels = findFormat(file.internal_format)->channels;
+        return true;
+
+    }
+
+    bool TextureFile::write(const std::string &path, const TextureFile &file) {
+
+        const Format *format = findFormat(file.internal_format);
+        if (format == 0 || (int) file.images.size() != file.levels * file.faces)
+            return false;
+
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            return false;
+
+        // The base format only depends on the channels.
+        const GLenum base_formats[] = {GL_RED, GL_RED, GL_RG, GL_RGB, GL_RGBA};
+
+        // The orientation, padded to four bytes.
+        uint32_t key_value_bytes = sizeof(KTX_ORIENTATION);
+        uint32_t key_value_padded = (4 + key_value_bytes + 3) & ~3u;
+
+        out.write((const char *) KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER));
+        writeU32(out, KTX_ENDIANNESS);
+        writeU32(out, 0);                                   // glType, 0 when compressed.
+        writeU32(out, 1);                                   // glTypeSize.
+        writeU32(out, 0);                                   // glFormat, 0 when compressed.
+        writeU32(out, file.internal_format);
+        writeU32(out, base_formats[format->channels]);
+        writeU32(out, file.width);
+        writeU32(out, file.height);
+        writeU32(out, 0);                                   // pixelDepth.
+        writeU32(out, 0);                                   // numberOfArrayElements.
+        writeU32(out, file.faces);
+        writeU32(out, file.levels);
+        writeU32(out, key_value_padded);
+
+        writeU32(out, key_value_bytes);
+        out.write(KTX_ORIENTATION, key_value_bytes);
+        out.write("\0\0\0", key_value_padded - 4 - key_value_bytes);
+
+        // Every level with the size of one of its images first.
+        for (int level = 0; level < file.levels; level++) {
+
+            writeU32(out, (uint32_t) file.getImage(level, 0).size);
+
+            for (int face = 0; face < file.faces; face++) {
+                const Image &image = file.getImage(level, face);
+                out.write((const char *) &file.data[image.offset], image.size);
+                out.write("\0\0\0", ((image.size + 3) & ~(size_t) 3) - image.size);
+            }
+
+        }
+
+        return (bool) out;
+
+    }
+
+    size_t TextureFile::getBlockBytes(GLenum internal_format) {
+
+        const Format *format = findFormat(internal_format);
+        return format == 0 ? 0 : format->block_bytes;
+
+    }
+
+} // namespace bgq_opengl
@@ -0,0 +1,120 @@
+/**
+ * @file texture_file.h
+ * @brief TextureFile struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_TEXTURE_FILE_H_
+#define BGQ_OPENGL_STRUCT_TEXTURE_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+    /**
+     * @brief A pre-compressed texture file.
+     *
+     * This Struct holds the contents of a KTX (version 1) or DDS file with a
+     * block-compressed format (BCn or ETC2) and its mip chain, ready to be passed
+     * to glCompressedTexImage2D. Only the parsing lives here, so offline tools can
+     * use it without a GL context.
+     */
+    struct TextureFile {
+
+        /**
+         * @brief An image of the file.
+         */
+        struct Image {
+
+            size_t offset = 0;      /// Where it starts in data.
+            size_t size = 0;        /// Its size in bytes.
+            int width = 0;          /// Its width in pixels.
+            int height = 0;         /// Its height in pixels.
+
+        };
+
+        GLenum internal_format = 0;     /// The compressed GL internal format.
+        int width = 0;                  /// Width of the base level in pixels.
+        int height = 0;                 /// Height of the base level in pixels.
+        int channels = 0;               /// Number of channels of the format.
+        int faces = 1;                  /// 1, or 6 for cubemaps.
+        int levels = 0;                 /// Number of mip levels stored.
+        std::vector<Image> images;      /// The images, level by level and face by face within each.
+        std::vector<unsigned char> data;    /// The compressed bytes of every image.
+
+        /**
+         * @brief Get an image.
+         *
+         * Get an image of the file.
+         *
+         * @param level The mip level.
+         * @param face The face, 0 unless it is a cubemap.
+         *
+         * @returns The image.
+         */
+        const Image &getImage(int level, int face) const;
+
+        /**
+         * @brief Check whether a path is a texture file.
+         *
+         * Check whether a path has the extension of a KTX or DDS file.
+         *
+         * @param path The path.
+         *
+         * @returns Whether it is a texture file.
+         */
+        static bool isTextureFile(const std::string &path);
+
+        /**
+         * @brief Read a texture file.
+         *
+         * Read a KTX or DDS file, depending on its contents.
+         *
+         * @param path The path of the file.
+         * @param file Where the contents are stored.
+         *
+         * @returns Whether the file could be read and its format is known.
+         */
+        static bool read(const std::string &path, TextureFile &file);
+
+        /**
+         * @brief Write a KTX file.
+         *
+         * Write a texture as a KTX file, with its rows bottom up as OpenGL reads them.
+         *
+         * @param path The path of the file.
+         * @param file The texture.
+         *
+         * @returns Whether the file could be written.
+         */
+        static bool write(const std::string &path, const TextureFile &file);
+
+        /**
+         * @brief Get the block size of a format.
+         *
+         * Get the bytes taken by each 4x4 block of a compressed format.
+         *
+         * @param internal_format The GL internal format.
+         *
+         * @returns The bytes per block, or 0 if the format is not known.
+         */
+        static size_t getBlockBytes(GLenum internal_format);
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_TEXTURE_FILE_H_
@@ -0,0 +1,186 @@
+/**
+ * @file vertex_layout.cpp
+ * @brief VertexLayout struct implementation file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "vertex_layout.h"
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/packing.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+    namespace {
+
+        // Quantize a value in [-1, 1] to a signed normalized short.
+        int16_t toSnorm16(float value) {
+
+            return (int16_t) std::lround(glm::clamp(value, -1.0f, 1.0f) * 32767.0f);
+
+        }
+
+        // Quantize a value in [0, 1] to an unsigned normalized byte.
+        uint8_t toUnorm8(float value) {
+
+            return (uint8_t) std::lround(glm::clamp(value, 0.0f, 1.0f) * 255.0f);
+
+        }
+
+        // Map a unit normal to the octahedron and unfold it on the [-1, 1] square.
+        glm::vec2 octEncode(glm::vec3 n) {
+
+            n /= (std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z));
+
+            glm::vec2 e(n.x, n.y);
+
+            // Fold the lower hemisphere over the diagonals.
+            if (n.z < 0.0f) {
+                e.x = (1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+                e.y = (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+            }
+
+            return e;
+
+        }
+
+    }
+
+    VertexLayout VertexLayout::full() {
+
+        VertexLayout layout;
+        layout.format = FULL;
+        layout.stride = sizeof(Vertex);
+        layout.position_scale = glm::vec3(1.0f);
+        layout.position_offset = glm::vec3(0.0f);
+        layout.oct_normals = false;
+
+        layout.attributes = {
+            {0, 3, GL_FLOAT, GL_FALSE, 0},
+            {1, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float)},
+            {2, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float)},
+            {3, 2, GL_FLOAT, GL_FALSE, 9 * sizeof(float)},
+            {4, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float)},
+            {5, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float)}
+        };
+
+        return layout;
+
+    }
+
+    VertexLayout VertexLayout::compact(const BoundingBox &bounds, bool with_uv) {
+
+        VertexLayout layout;
+        layout.format = with_uv ? COMPACT_TEXTURED : COMPACT;
+        layout.oct_normals = true;
+
+        // Positions are stored in [-1, 1] relative to the centre of the bounds.
+        layout.position_offset = (bounds.min + bounds.max) / 2.0f;
+        layout.position_scale = (bounds.max - bounds.min) / 2.0f;
+
+        // Avoid dividing by zero in flat meshes.
+        for (int i = 0; i < 3; i++)
+            if (layout.position_scale[i] <= 0.0f)
+                layout.position_scale[i] = 1.0f;
+
+        // Position (snorm16 x3 + padding), normal (oct snorm16 x2), color (unorm8 x4).
+        layout.attributes = {
+            {0, 3, GL_SHORT, GL_TRUE, 0},
+            {1, 2, GL_SHORT, GL_TRUE, 8},
+            {2, 4, GL_UNSIGNED_BYTE, GL_TRUE, 12}
+        };
+        layout.stride = 16;
+
+        // UV (half x2).
+        if (with_uv) {
+            layout.attributes.push_back({3, 2, GL_HALF_FLOAT, GL_FALSE, 16});
+            layout.stride = 20;
+        }
+
+        return layout;
+
+    }
+
+    VertexLayout VertexLayout::choose(const std::vector<Vertex> &vertices, bool textured) {
+
+        // Nothing to quantize against.
+        if (vertices.empty())
+            return VertexLayout::full();
+
+        // Get the bounds of the positions.
+        BoundingBox bb{vertices[0].position, vertices[0].position};
+        for (size_t i = 1; i < vertices.size(); i++) {
+            bb.min = glm::min(bb.min, vertices[i].position);
+            bb.max = glm::max(bb.max, vertices[i].position);
+        }
+
+        return VertexLayout::compact(bb, textured);
+
+    }
+
+    std::vector<unsigned char> VertexLayout::pack(const std::vector<Vertex> &vertices) const {
+
+        // The full layout is the Vertex struct itself.
+        if (this->format == FULL) {
+
+            std::vector<unsigned char> bytes(vertices.size() * sizeof(Vertex));
+            if (!vertices.empty())
+                std::memcpy(bytes.data(), vertices.data(), bytes.size());
+            return bytes;
+
+        }
+
+        std::vector<unsigned char> bytes(vertices.size() * this->stride, 0);
+
+        for (size_t i = 0; i < vertices.size(); i++) {
+
+            unsigned char *dst = bytes.data() + i * this->stride;
+
+            // Quantize the position inside the bounds.
+            glm::vec3 p = (vertices[i].position - this->position_offset) / this->position_scale;
+            int16_t position[3] = {toSnorm16(p.x), toSnorm16(p.y), toSnorm16(p.z)};
+            std::memcpy(dst, position, sizeof(position));
+
+            // Encode the normal, pointing degenerate ones up.
+            float length = glm::length(vertices[i].normal);
+            glm::vec3 normal_dir = length > VERTEX_LAYOUT_MIN_NORMAL ? vertices[i].normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+            glm::vec2 n = octEncode(normal_dir);
+            int16_t normal[2] = {toSnorm16(n.x), toSnorm16(n.y)};
+            std::memcpy(dst + 8, normal, sizeof(normal));
+
+            // Quantize the color.
+            glm::vec3 c = vertices[i].color;
+            uint8_t color[4] = {toUnorm8(c.r), toUnorm8(c.g), toUnorm8(c.b), 255};
+            std::memcpy(dst + 12, color, sizeof(color));
+
+            // Store the UVs as half floats.
+            if (this->format == COMPACT_TEXTURED) {
+                uint16_t uv[2] = {glm::packHalf1x16(vertices[i].uv.x), glm::packHalf1x16(vertices[i].uv.y)};
+                std::memcpy(dst + 16, uv, sizeof(uv));
+            }
+
+        }
+
+        return bytes;
+
+    }
+
+} // namespace bgq_opengl
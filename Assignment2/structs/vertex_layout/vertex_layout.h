@@ -0,0 +1,122 @@
+/**
+ * @file vertex_layout.h
+ * @brief VertexLayout struct header file.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_VERTEXLAYOUT_H_
+#define BGQ_OPENGL_STRUCT_VERTEXLAYOUT_H_
+
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/vertex/vertex.h"
+
+#define VERTEX_LAYOUT_MIN_NORMAL 1e-12f  // Shortest normal that can be normalized.
+
+namespace bgq_opengl {
+
+    /**
+     * @brief A vertex attribute description.
+     *
+     * This Struct describes where an attribute lives inside an interleaved vertex
+     * and how OpenGL has to read it. Attributes with a stride of their own live in
+     * separate arrays of the same buffer, and their offset is from its start.
+     */
+    struct VertexAttribute {
+
+        GLuint location;        /// The layout location in the shader.
+        GLint components;       /// The number of components.
+        GLenum type;            /// The component type.
+        GLboolean normalized;   /// Whether integer types are mapped to [0, 1] or [-1, 1].
+        GLuint offset;          /// The offset in bytes from the start of the vertex.
+        GLsizei stride = 0;     /// Bytes between two vertices, or 0 to use the stride of the layout.
+
+    };
+
+    /**
+     * @brief A vertex layout descriptor.
+     *
+     * This Struct describes how a geometry stores its vertices on the GPU and packs
+     * Vertex arrays into that format. Compact layouts quantize positions to snorm16
+     * inside the mesh bounds, normals to octahedral snorm16, colors to unorm8 and UVs
+     * to half floats, and drop the streams the shaders do not read.
+     */
+    struct VertexLayout {
+
+        /**
+         * @brief The available vertex formats.
+         *
+         * FULL is the 68 bytes float Vertex, COMPACT is 16 bytes without UVs and
+         * COMPACT_TEXTURED is 20 bytes with UVs.
+         */
+        enum Format { FULL, COMPACT, COMPACT_TEXTURED };
+
+        Format format;                              /// The vertex format.
+        GLsizei stride;                             /// Size in bytes of a vertex.
+        std::vector<VertexAttribute> attributes;    /// The attributes that are stored.
+        glm::vec3 position_scale;                   /// Scale that decodes positions.
+        glm::vec3 position_offset;                  /// Offset that decodes positions.
+        bool oct_normals;                           /// Whether normals are octahedral encoded.
+
+        /**
+         * @brief Build the full float layout.
+         *
+         * Build the layout matching the Vertex struct with all six attributes.
+         *
+         * @returns The layout.
+         */
+        static VertexLayout full();
+
+        /**
+         * @brief Build a compact quantized layout.
+         *
+         * Build a compact layout whose positions are quantized inside the bounds.
+         *
+         * @param bounds The bounding box of the positions.
+         * @param with_uv Whether to keep the UV stream.
+         *
+         * @returns The layout.
+         */
+        static VertexLayout compact(const BoundingBox &bounds, bool with_uv);
+
+        /**
+         * @brief Choose the best layout for a mesh.
+         *
+         * Choose the best layout for a mesh, used by the loaders.
+         *
+         * @param vertices The vertices of the mesh.
+         * @param textured Whether the mesh has textures, and therefore needs UVs.
+         *
+         * @returns The layout.
+         */
+        static VertexLayout choose(const std::vector<Vertex> &vertices, bool textured);
+
+        /**
+         * @brief Pack the vertices in this layout.
+         *
+         * Pack the vertices into an interleaved buffer ready to upload.
+         *
+         * @param vertices The vertices to pack.
+         *
+         * @returns The packed bytes.
+         */
+        std::vector<unsigned char> pack(const std::vector<Vertex> &vertices) const;
+
+    };
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_VERTEXLAYOUT_H_
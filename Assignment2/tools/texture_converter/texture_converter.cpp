@@ -0,0 +1,385 @@
+/**
+ * @file texture_converter.cpp
+ * @brief Offline texture converter.
+ * @version 1.0.0 (2026-10-18)
+ * @date 2026-10-18
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ * Converts PNG and JPG images into KTX files compressed with BC1 (opaque
+ * images) or BC3 (images with alpha), with their whole mip chain, so the game
+ * can upload them as they are. Rows are flipped like Texture does, unless the
+ * faces of a cubemap are being converted.
+ *
+ * It does not need a GL context. Build it on its own from Assignment2:
+ *
+ *     c++ -std=c++11 -O2 -I . tools/texture_converter/texture_converter.cpp structs/texture_file/texture_file.cpp -o texture_converter
+ *
+ * Usage:
+ *
+ *     texture_converter [--bc1 | --bc3] [--no-mipmaps] input.png output.ktx
+ *     texture_converter [--bc1 | --bc3] [--no-mipmaps] --cube right left top bottom back front output.ktx
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+#include "stb/stb_image.h"
+
+#include "structs/texture_file/texture_file.h"
+
+namespace {
+
+    /**
+     * @brief An uncompressed RGBA image.
+     */
+    struct Image {
+
+        int width = 0;                      /// Width in pixels.
+        int height = 0;                     /// Height in pixels.
+        std::vector<unsigned char> pixels;  /// RGBA pixels, row by row.
+
+    };
+
+    /**
+     * @brief Halve an image.
+     *
+     * Build the next mip level of an image with a box filter.
+     *
+     * @param image The image.
+     *
+     * @returns The next level.
+     */
+    Image downsample(const Image &image) {
+
+        Image half;
+        half.width = std::max(1, image.width / 2);
+        half.height = std::max(1, image.height / 2);
+        half.pixels.resize(half.width * half.height * 4);
+
+        for (int y = 0; y < half.height; y++) {
+            for (int x = 0; x < half.width; x++) {
+
+                // Odd sizes repeat their last row or column.
+                int x0 = std::min(2 * x, image.width - 1), x1 = std::min(2 * x + 1, image.width - 1);
+                int y0 = std::min(2 * y, image.height - 1), y1 = std::min(2 * y + 1, image.height - 1);
+
+                for (int c = 0; c < 4; c++) {
+                    int sum = image.pixels[(y0 * image.width + x0) * 4 + c] + image.pixels[(y0 * image.width + x1) * 4 + c] +
+                              image.pixels[(y1 * image.width + x0) * 4 + c] + image.pixels[(y1 * image.width + x1) * 4 + c];
+                    half.pixels[(y * half.width + x) * 4 + c] = (unsigned char) ((sum + 2) / 4);
+                }
+
+            }
+        }
+
+        return half;
+
+    }
+
+    /**
+     * @brief Pack a color as RGB565.
+     */
+    uint16_t packColor(const float *color) {
+
+        int r = std::min(31, std::max(0, (int) (color[0] * 31.0f / 255.0f + 0.5f)));
+        int g = std::min(63, std::max(0, (int) (color[1] * 63.0f / 255.0f + 0.5f)));
+        int b = std::min(31, std::max(0, (int) (color[2] * 31.0f / 255.0f + 0.5f)));
+
+        return (uint16_t) ((r << 11) | (g << 5) | b);
+
+    }
+
+    /**
+     * @brief Unpack an RGB565 color.
+     */
+    void unpackColor(uint16_t packed, int *color) {
+
+        color[0] = ((packed >> 11) & 31) * 255 / 31;
+        color[1] = ((packed >> 5) & 63) * 255 / 63;
+        color[2] = (packed & 31) * 255 / 31;
+
+    }
+
+    /**
+     * @brief Compress the colors of a block.
+     *
+     * Compress 16 RGBA pixels into a BC1 color block, always in four color mode.
+     * The endpoints are the extremes of the pixels along their principal axis.
+     *
+     * @param block The pixels.
+     * @param out Where the 8 bytes are written.
+     */
+    void compressColors(const unsigned char *block, unsigned char *out) {
+
+        // The mean and covariance of the colors.
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        for (int i = 0; i < 16; i++)
+            for (int c = 0; c < 3; c++)
+                mean[c] += block[i * 4 + c] / 16.0f;
+
+        float cov[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        for (int i = 0; i < 16; i++) {
+            float r = block[i * 4] - mean[0], g = block[i * 4 + 1] - mean[1], b = block[i * 4 + 2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+
+        // Find the principal axis by power iteration.
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for (int k = 0; k < 8; k++) {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float length = std::max(std::max(std::fabs(x), std::fabs(y)), std::fabs(z));
+            if (length == 0.0f)
+                break;
+            axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+        }
+
+        // The extremes along it are the endpoints.
+        float min_dot = 1e30f, max_dot = -1e30f;
+        float min_color[3], max_color[3];
+        for (int i = 0; i < 16; i++) {
+            float dot = block[i * 4] * axis[0] + block[i * 4 + 1] * axis[1] + block[i * 4 + 2] * axis[2];
+            if (dot < min_dot) {
+                min_dot = dot;
+                for (int c = 0; c < 3; c++) min_color[c] = block[i * 4 + c];
+            }
+            if (dot > max_dot) {
+                max_dot = dot;
+                for (int c = 0; c < 3; c++) max_color[c] = block[i * 4 + c];
+            }
+        }
+
+        uint16_t color0 = packColor(max_color);
+        uint16_t color1 = packColor(min_color);
+        if (color0 < color1)
+            std::swap(color0, color1);
+
+        // The four colors of the palette.
+        int palette[4][3];
+        unpackColor(color0, palette[0]);
+        unpackColor(color1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        // Pick the closest one for each pixel, unless there is only one color.
+        uint32_t indices = 0;
+        if (color0 != color1) {
+            for (int i = 0; i < 16; i++) {
+                int best = 0, best_error = 1 << 30;
+                for (int p = 0; p < 4; p++) {
+                    int dr = block[i * 4] - palette[p][0], dg = block[i * 4 + 1] - palette[p][1], db = block[i * 4 + 2] - palette[p][2];
+                    int error = dr * dr + dg * dg + db * db;
+                    if (error < best_error) {
+                        best = p;
+                        best_error = error;
+                    }
+                }
+                indices |= (uint32_t) best << (2 * i);
+            }
+        }
+
+        out[0] = color0 & 0xFF; out[1] = color0 >> 8;
+        out[2] = color1 & 0xFF; out[3] = color1 >> 8;
+        std::memcpy(out + 4, &indices, 4);
+
+    }
+
+    /**
+     * @brief Compress the alpha of a block.
+     *
+     * Compress the alpha of 16 RGBA pixels into a BC3 alpha block, in eight
+     * value mode between its minimum and maximum.
+     *
+     * @param block The pixels.
+     * @param out Where the 8 bytes are written.
+     */
+    void compressAlpha(const unsigned char *block, unsigned char *out) {
+
+        int alpha0 = 0, alpha1 = 255;
+        for (int i = 0; i < 16; i++) {
+            alpha0 = std::max(alpha0, (int) block[i * 4 + 3]);
+            alpha1 = std::min(alpha1, (int) block[i * 4 + 3]);
+        }
+
+        int palette[8] = {alpha0, alpha1};
+        for (int p = 2; p < 8; p++)
+            palette[p] = ((8 - p) * alpha0 + (p - 1) * alpha1) / 7;
+
+        uint64_t indices = 0;
+        if (alpha0 != alpha1) {
+            for (int i = 0; i < 16; i++) {
+                int best = 0, best_error = 256;
+                for (int p = 0; p < 8; p++) {
+                    int error = std::abs(block[i * 4 + 3] - palette[p]);
+                    if (error < best_error) {
+                        best = p;
+                        best_error = error;
+                    }
+                }
+                indices |= (uint64_t) best << (3 * i);
+            }
+        }
+
+        out[0] = (unsigned char) alpha0;
+        out[1] = (unsigned char) alpha1;
+        for (int b = 0; b < 6; b++)
+            out[2 + b] = (unsigned char) (indices >> (8 * b));
+
+    }
+
+    /**
+     * @brief Compress an image.
+     *
+     * Compress an image block by block, repeating the edges of blocks that go past it.
+     *
+     * @param image The image.
+     * @param alpha Whether to use BC3 instead of BC1.
+     * @param out Where the blocks are appended.
+     */
+    void compress(const Image &image, bool alpha, std::vector<unsigned char> &out) {
+
+        for (int by = 0; by < image.height; by += 4) {
+            for (int bx = 0; bx < image.width; bx += 4) {
+
+                unsigned char block[64];
+                for (int y = 0; y < 4; y++)
+                    for (int x = 0; x < 4; x++)
+                        std::memcpy(&block[(y * 4 + x) * 4], &image.pixels[(std::min(by + y, image.height - 1) * image.width + std::min(bx + x, image.width - 1)) * 4], 4);
+
+                size_t offset = out.size();
+                out.resize(offset + (alpha ? 16 : 8));
+
+                if (alpha) {
+                    compressAlpha(block, &out[offset]);
+                    compressColors(block, &out[offset + 8]);
+                } else {
+                    compressColors(block, &out[offset]);
+                }
+
+            }
+        }
+
+    }
+
+}
+
+int main(int argc, char **argv) {
+
+    // Read the options.
+    int format = 0;
+    bool mipmaps = true;
+    bool cube = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--bc1")
+            format = 1;
+        else if (arg == "--bc3")
+            format = 3;
+        else if (arg == "--no-mipmaps")
+            mipmaps = false;
+        else if (arg == "--cube")
+            cube = true;
+        else
+            paths.push_back(arg);
+    }
+
+    if (paths.size() != (cube ? 7 : 2)) {
+        std::cerr << "Usage: " << argv[0] << " [--bc1 | --bc3] [--no-mipmaps] [--cube] inputs... output.ktx" << std::endl;
+        return 1;
+    }
+
+    // Load the faces, flipped like Texture does except for cubemaps.
+    std::vector<Image> faces(paths.size() - 1);
+    bool has_alpha = false;
+
+    stbi_set_flip_vertically_on_load(!cube);
+
+    for (size_t f = 0; f < faces.size(); f++) {
+
+        int channels;
+        unsigned char *pixels = stbi_load(paths[f].c_str(), &faces[f].width, &faces[f].height, &channels, 4);
+        if (!pixels) {
+            std::cerr << "Could not load " << paths[f] << ": " << stbi_failure_reason() << std::endl;
+            return 1;
+        }
+
+        faces[f].pixels.assign(pixels, pixels + faces[f].width * faces[f].height * 4);
+        stbi_image_free(pixels);
+
+        if (cube && (faces[f].width != faces[0].width || faces[f].height != faces[f].width)) {
+            std::cerr << "The faces of a cubemap must be squares of the same size." << std::endl;
+            return 1;
+        }
+
+        for (size_t i = 3; i < faces[f].pixels.size(); i += 4)
+            has_alpha = has_alpha || faces[f].pixels[i] != 255;
+
+    }
+
+    // Only keep alpha when it is used, unless told otherwise.
+    bool alpha = format == 0 ? has_alpha : format == 3;
+
+    bgq_opengl::TextureFile file;
+    file.internal_format = alpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    file.width = faces[0].width;
+    file.height = faces[0].height;
+    file.channels = alpha ? 4 : 3;
+    file.faces = (int) faces.size();
+    file.levels = 1;
+    if (mipmaps)
+        while ((file.width >> file.levels) > 0 || (file.height >> file.levels) > 0)
+            file.levels++;
+
+    // Compress every level of every face, level by level.
+    for (int level = 0; level < file.levels; level++) {
+
+        for (int f = 0; f < file.faces; f++) {
+
+            bgq_opengl::TextureFile::Image image;
+            image.offset = file.data.size();
+            image.width = faces[f].width;
+            image.height = faces[f].height;
+
+            compress(faces[f], alpha, file.data);
+            image.size = file.data.size() - image.offset;
+            file.images.push_back(image);
+
+            if (level + 1 < file.levels)
+                faces[f] = downsample(faces[f]);
+
+        }
+
+    }
+
+    if (!bgq_opengl::TextureFile::write(paths.back(), file)) {
+        std::cerr << "Could not write " << paths.back() << std::endl;
+        return 1;
+    }
+
+    std::cerr << paths.back() << ": " << file.width << "x" << file.height << ", " << file.levels << " levels, " << (alpha ? "BC3" : "BC1") << ", " << file.data.size() << " bytes" << std::endl;
+
+    return 0;
+
+}